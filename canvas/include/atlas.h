@@ -0,0 +1,62 @@
+#pragma once
+
+#include <gccore.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "texture.h"
+
+#define ATLAS_MAX_PAGES 4
+#define ATLAS_MAX_SKYLINE 64
+
+typedef struct AtlasSkylineNode {
+    uint16_t x;
+    uint16_t y;
+    uint16_t width;
+} AtlasSkylineNode;
+
+// CI8 page with its own RGB5A3 palette, images own consecutive palette entries and entry 0 is transparent
+typedef struct AtlasPage {
+    GXTexObj texture;
+    uint8_t *pixels;
+    TexturePalette palette;
+    uint32_t colors_size;
+    uint8_t colors[TEXTURE_PALETTE_MAX_COLORS * 4];
+    uint32_t skyline_size;
+    AtlasSkylineNode skyline[ATLAS_MAX_SKYLINE];
+} AtlasPage;
+
+typedef struct Atlas {
+    uint16_t width;
+    uint16_t height;
+    uint32_t tlut_name;
+    uint32_t pages_size;
+    AtlasPage pages[ATLAS_MAX_PAGES];
+} Atlas;
+
+// Sub rectangle of an atlas page that the canvas can draw, and the palette entries of its colors
+typedef struct AtlasRegion {
+    GXTexObj *texture;
+    uint16_t width;
+    uint16_t height;
+    float left;
+    float top;
+    float right;
+    float bottom;
+    AtlasPage *page;
+    uint16_t colors_start;
+    uint16_t colors_size;
+} AtlasRegion;
+
+// Page n reads TLUT tlut_name + n
+void atlas_init(Atlas *atlas, uint16_t width, uint16_t height, uint32_t tlut_name);
+
+// Quantizes the image to at most colors_max colors on the first page with room for its rect and its colors
+bool atlas_add_rgba8(Atlas *atlas, AtlasRegion *region, const uint8_t *pixels, int32_t width, int32_t height,
+                     uint32_t colors_max);
+
+bool atlas_add_png(Atlas *atlas, AtlasRegion *region, const uint8_t *data, size_t size, uint32_t colors_max);
+
+// Replaces the colors_size RGBA colors of a region and reloads its page palette, at most once per frame
+void atlas_set_colors(AtlasRegion *region, const uint8_t *colors);
@@ -1,12 +1,114 @@
 #pragma once
 
 #include <gccore.h>
+#include <stdbool.h>
 #include <stdint.h>
 
+#include "atlas.h"
+#include "gxstate.h"
+
+#define CANVAS_BATCH_MAX_QUADS 1024
+
+// Fractional bits of the compact S16 screen positions, enough for -2048..2047 px in 1/16 px steps
+#define CANVAS_POSITION_FRAC_BITS 4
+
+typedef struct CanvasVertex {
+    float x;
+    float y;
+    uint32_t color;
+    float u;
+    float v;
+} CanvasVertex;
+
+typedef struct CanvasQuad {
+    GXTexObj *texture;
+    float min_x;
+    float min_y;
+    float max_x;
+    float max_y;
+} CanvasQuad;
+
+#define CANVAS_LIST_MAX_TEXTURES 8
+
+typedef struct CanvasList {
+    void *data;
+    uint32_t capacity;
+    uint32_t size;
+    uint32_t key;
+    uint32_t textures_hash;
+    uint32_t textures_size;
+    GXTexObj *textures[CANVAS_LIST_MAX_TEXTURES];
+    uint32_t glyph_cache_generation;
+    // Set when the draws outgrew the capacity, the list then draws immediately whenever it is recorded
+    bool overflowed;
+    // Offset given to canvas_record_begin, calls and immediate draws apply it
+    bool offset;
+    Mtx offset_matrix;
+} CanvasList;
+
+typedef struct CanvasStats {
+    uint32_t draw_calls;
+    uint32_t texture_loads;
+    uint32_t texture_loads_saved;
+    uint32_t matrix_loads;
+    uint32_t fifo_bytes;
+    uint32_t text_cache_hits;
+    uint32_t text_cache_misses;
+} CanvasStats;
+
+// Shared atlas for the blank block and the cursors, its pages read this and the next TLUTs
+#define CANVAS_ATLAS_SIZE 256
+#define CANVAS_ATLAS_TLUT GX_TLUT0
+
+// Text layout cache budget, strings longer than one slot are laid out on every call
+#define CANVAS_TEXT_CACHE_SIZE 32
+#define CANVAS_TEXT_MAX_BYTES 128
+#define CANVAS_TEXT_MAX_GLYPHS 96
+
+#define CANVAS_FLIP_X (1 << 0)
+#define CANVAS_FLIP_Y (1 << 1)
+
 typedef struct Canvas {
-    GXTexObj blank_texture;
+    Atlas atlas;
+    AtlasRegion blank_region;
+    // Font pages, I4 coverage or an I8 distance field for monochrome glyphs and RGB5A3 for colored ones,
+    // the memory fields are the size in bytes of the pages each mode uses
     GXTexObj font_texture;
+    GXTexObj font_sdf_texture;
+    GXTexObj font_emoji_texture;
+    uint32_t font_memory;
+    uint32_t font_sdf_memory;
+    bool sdf;
     Mtx transform_matrix;
+    GXStateBlock state_block;
+
+    // Batch state, quads are transformed on the CPU and flushed per texture run,
+    // when deferred is enabled non overlapping quads are regrouped by texture first
+    bool batching;
+    bool deferred;
+    bool identity_loaded;
+
+    // Unbatched quads reference the unit quad arrays with GX_INDEX8 instead of sending direct floats
+    bool indexed;
+
+    // Direct vertices use GX_VTXFMT1 with S16 positions and U8/U16 texcoords scaled per texture size
+    bool compact;
+    uint8_t texcoord_shift;
+
+    uint32_t batch_size;
+    CanvasQuad batch_quads[CANVAS_BATCH_MAX_QUADS];
+    CanvasVertex batch_vertices[CANVAS_BATCH_MAX_QUADS * 4];
+
+    // Display list that is being recorded, its draws are always batched without matrix loads
+    CanvasList *recording;
+    bool recording_batching;
+    CanvasStats recording_stats;
+
+    // Overflowed list whose draws go out immediately, every matrix load is offset by its offset matrix
+    CanvasList *immediate;
+
+    // Counters of the current frame, reset by canvas_begin
+    CanvasStats stats;
 } Canvas;
 
 extern Canvas canvas;
@@ -15,10 +117,43 @@ void canvas_init(void);
 
 void canvas_begin(uint32_t screen_width, uint32_t screen_height);
 
+void canvas_flush(void);
+
 void canvas_end(void);
 
 void canvas_fill_rect(float x, float y, float width, float height, uint32_t color);
 
 void canvas_draw_image(GXTexObj *texture, float x, float y, float width, float height, uint32_t color);
 
+void canvas_draw_image_region(GXTexObj *texture, float src_x, float src_y, float src_width, float src_height, float x,
+                              float y, float width, float height, float pivot_x, float pivot_y, uint32_t flags,
+                              uint32_t color);
+
+void canvas_draw_atlas(AtlasRegion *region, float x, float y, float width, float height, uint32_t color);
+
 void canvas_fill_text(char *text, float x, float y, float text_size, uint32_t color);
+
+// Returns the advance width of text, served from the same layout cache as canvas_fill_text
+float canvas_measure_text(char *text, float text_size);
+
+// Draws printf style text straight into glyphs, formatted by format_write in format.h where its differences from
+// printf are listed
+void canvas_fill_textf(float x, float y, float text_size, uint32_t color, const char *format, ...)
+    __attribute__((format(printf, 5, 6)));
+
+// Draws a string from include/font_strings.h by its FONT_STRING_ id, laid out when the font was built
+void canvas_fill_text_id(uint32_t id, float x, float y, float text_size, uint32_t color);
+
+float canvas_measure_text_id(uint32_t id, float text_size);
+
+uint32_t canvas_hash(const void *data, size_t size, uint32_t hash);
+
+void canvas_list_init(CanvasList *list, uint32_t capacity);
+
+// Records the draws up to canvas_record_end when it returns true, offset_matrix may be NULL. Lists that overflow draw
+// immediately at the offset instead, from the frame that overflowed on.
+bool canvas_record_begin(CanvasList *list, uint32_t key, MtxP offset_matrix);
+
+void canvas_record_end(CanvasList *list);
+
+void canvas_call_list(CanvasList *list);
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stdint.h>
+
+// GX_TF_CMPR is DXT1 with 4x4 blocks grouped into 8x8 tiles, colors are big endian RGB565 and the leftmost texel
+// of a row is in the high bits of its index byte. Only uses the C library so host tools can build it too.
+
+// Texels with less alpha become the transparent color of a block
+#define CMPR_ALPHA_THRESHOLD 128
+
+typedef enum CmprQuality {
+    // Bounding box endpoints, for encoding at load time
+    CMPR_QUALITY_FAST,
+    // Principal axis endpoints refined by least squares and single level steps in both block modes, for build tools
+    CMPR_QUALITY_HIGH,
+} CmprQuality;
+
+// Bytes of a width x height image rounded up to whole 8x8 tiles
+uint32_t cmpr_size(int32_t width, int32_t height);
+
+// Encodes RGBA pixels, texels past the image edge repeat the edge so they cost no precision
+void cmpr_encode(const uint8_t *src, int32_t width, int32_t height, CmprQuality quality, uint8_t *dst);
+
+// Decodes to RGBA with the 3/8 blend GX samples with
+void cmpr_decode(const uint8_t *src, int32_t width, int32_t height, uint8_t *dst);
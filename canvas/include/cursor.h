@@ -5,6 +5,11 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "atlas.h"
+
+// Palette entries of each cursor in the canvas atlas, four cursors and the blank block share one page
+#define CURSOR_COLORS 63
+
 typedef struct Cursor {
     bool enabled;
     int32_t x;
@@ -13,7 +18,9 @@ typedef struct Cursor {
     uint32_t buttons_down;
     uint32_t buttons_held;
     uint32_t buttons_up;
-    GXTexObj texture;
+    // Image in the canvas atlas, tints swap its palette entries, colors are the originals
+    AtlasRegion image;
+    uint8_t colors[CURSOR_COLORS * 4];
 } Cursor;
 
 extern Cursor cursors[4];
@@ -22,4 +29,7 @@ void cursor_init(void);
 
 void cursor_update(void);
 
+// Gives the colored part of a cursor the hue of color by swapping its palette, 0 restores the original colors
+void cursor_set_tint(int32_t index, uint32_t color);
+
 void cursor_render(void);
@@ -3,6 +3,10 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "font_atlas.h"
+
+// Character n at x, y of the atlas with size w, h, its top a pixels below the line top and its left b pixels
+// right of the pen, which then moves d pixels, c marks colored glyphs
 typedef struct FontChar {
     uint32_t n;
     uint16_t x;
@@ -10,9 +14,89 @@ typedef struct FontChar {
     uint16_t w;
     uint16_t h;
     int16_t a;
+    int16_t b;
+    int16_t d;
     bool c;
 } FontChar;
 
+// Pen offset in pixels when character r follows character l
+typedef struct FontKerning {
+    uint32_t l;
+    uint32_t r;
+    int16_t k;
+} FontKerning;
+
+// Line height of the atlas glyphs, tools/font_atlas.c bakes font.png and font.c for it
 #define FONT_RENDER_SIZE 64
 
-extern FontChar font[101];
+// Distance field atlas made by tools/font_sdf.c, glyphs are downscaled by FONT_SDF_SCALE and
+// surrounded by FONT_SDF_SPREAD texels of field, 128 is the outline
+#define FONT_SDF_SCALE 3
+#define FONT_SDF_SPREAD 3
+#define FONT_SDF_HEADER_SIZE 12
+#define FONT_SDF_GLYPH_SIZE 8
+
+extern FontChar font[FONT_CHARS_SIZE];
+extern FontKerning font_kernings[FONT_KERNINGS_SIZE];
+
+#define FONT_GLYPHS_MAX 255
+#define FONT_GLYPH_NONE 0xff
+#define FONT_GLYPH_COLORED 1
+
+// Glyph metrics packed into 10 bytes
+typedef struct FontGlyph {
+    uint16_t x;
+    uint16_t y;
+    uint8_t width;
+    uint8_t height;
+    int8_t ascent;
+    int8_t bearing;
+    uint8_t advance;
+    uint8_t flags;
+} FontGlyph;
+
+// Two level page table covering planes 0 and 1, each page maps 256 code points to glyph indices
+#define FONT_PAGE_BITS 8
+#define FONT_PAGES_SIZE (0x20000 >> FONT_PAGE_BITS)
+#define FONT_PAGES_MAX 16
+
+typedef struct FontTable {
+    uint32_t glyphs_size;
+    FontGlyph glyphs[FONT_GLYPHS_MAX];
+    uint8_t pages_size;
+    uint8_t pages[FONT_PAGES_SIZE];
+    uint8_t page_glyphs[FONT_PAGES_MAX][1 << FONT_PAGE_BITS];
+
+    // Kerning pairs keyed by left glyph << 8 | right glyph in ascending order
+    uint32_t kernings_size;
+    uint16_t kerning_keys[FONT_KERNINGS_SIZE];
+    int8_t kerning_values[FONT_KERNINGS_SIZE];
+} FontTable;
+
+extern FontTable font_table;
+
+void font_table_init(void);
+
+// Returns the pen offset between two glyph indices, 0 for pairs without kerning
+int8_t font_table_find_kerning(uint8_t left, uint8_t right);
+
+// Strings from fonts/strings.txt encoded by tools/font_atlas.c, each glyph at its pen position in
+// FONT_RENDER_SIZE pixels with kerning and bearing applied, mono glyphs before colored ones
+typedef struct FontStringGlyph {
+    uint8_t glyph;
+    int16_t x;
+} FontStringGlyph;
+
+typedef struct FontString {
+    const FontStringGlyph *glyphs;
+    uint16_t glyphs_size;
+    uint16_t advance;
+} FontString;
+
+// Returns the glyph index of a code point or FONT_GLYPH_NONE
+static inline uint8_t font_table_find(uint32_t code_point) {
+    if (code_point >= 0x20000) return FONT_GLYPH_NONE;
+    uint8_t page = font_table.pages[code_point >> FONT_PAGE_BITS];
+    if (page == 0) return FONT_GLYPH_NONE;
+    return font_table.page_glyphs[page - 1][code_point & ((1 << FONT_PAGE_BITS) - 1)];
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+// Generated by tools/font_atlas.c, do not edit
+
+#define FONT_ATLAS_WIDTH 512
+#define FONT_ATLAS_HEIGHT 256
+#define FONT_BASELINE 53
+#define FONT_CHARS_SIZE 96
+#define FONT_KERNINGS_SIZE 637
@@ -0,0 +1,13 @@
+#pragma once
+
+// Generated by tools/font_atlas.c from fonts/strings.txt, do not edit
+
+#include "font.h"
+
+typedef enum FontStringId {
+    FONT_STRING_HELLO,
+    FONT_STRING_QUICK_FOX,
+    FONT_STRINGS_SIZE
+} FontStringId;
+
+extern const FontString font_strings[FONT_STRINGS_SIZE];
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdarg.h>
+#include <stdint.h>
+
+// printf style formatting straight into code points, without a text buffer, sprintf or locale
+
+// Most decimals %f prints and its default, more would overflow its 32 bit fixed point
+#define FORMAT_MAX_PRECISION 4
+
+// Receives the formatted text one code point at a time
+typedef void (*FormatEmit)(void *context, uint32_t code_point);
+
+// Formats like vsnprintf for %d %u %x %f %s %c and %% with an optional 0 flag, width and precision. Differences:
+// - %f prints at most and by default FORMAT_MAX_PRECISION decimals, rounded half away from zero in float, values
+//   past 4e9 / 10^precision print as that limit and NaN as 0
+// - %s and %c measure width and %s precision in code points, %c takes a code point rather than a byte
+// - precision is ignored for integers, there are no other flags and no length modifiers
+// - unknown conversions and a spec cut off by the end of the format print as written
+void format_write(const char *format, va_list arguments, FormatEmit emit, void *context);
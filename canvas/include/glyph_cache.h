@@ -0,0 +1,80 @@
+#pragma once
+
+#include <gccore.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "truetype.h"
+
+// Glyphs rasterized from a TrueType font on first use into shelf packed I8 pages,
+// the least recently drawn page is cleared when all of them are full
+#define GLYPH_CACHE_PAGE_SIZE 256
+#define GLYPH_CACHE_PAGES_MAX 4
+#define GLYPH_CACHE_ENTRIES_SIZE 512
+#define GLYPH_CACHE_QUEUE_SIZE 64
+
+typedef enum GlyphCacheState {
+    GLYPH_CACHE_EMPTY,
+    GLYPH_CACHE_MISSING,
+    GLYPH_CACHE_EVICTED,
+    GLYPH_CACHE_QUEUED,
+    GLYPH_CACHE_READY,
+} GlyphCacheState;
+
+// Metrics are in pixels of the rasterized glyph, the box is relative to the pen on the baseline
+typedef struct GlyphCacheEntry {
+    uint32_t code_point;
+    uint16_t glyph;
+    uint16_t x;
+    uint16_t y;
+    uint8_t page;
+    uint8_t state;
+    int8_t box_x;
+    int8_t box_y;
+    uint8_t width;
+    uint8_t height;
+    uint8_t advance;
+} GlyphCacheEntry;
+
+typedef struct GlyphCachePage {
+    GXTexObj texture;
+    uint8_t *texels;
+    uint32_t last_used;
+    uint16_t shelf_x;
+    uint16_t shelf_y;
+    uint16_t shelf_height;
+} GlyphCachePage;
+
+typedef struct GlyphCache {
+    TrueType font;
+    float scale;
+    uint32_t frame;
+
+    // Changes whenever a glyph is added to or removed from a page, so users can drop page coordinates they keep
+    uint32_t generation;
+
+    GlyphCachePage pages[GLYPH_CACHE_PAGES_MAX];
+    uint32_t pages_size;
+    GlyphCacheEntry entries[GLYPH_CACHE_ENTRIES_SIZE];
+    uint16_t queue[GLYPH_CACHE_QUEUE_SIZE];
+    uint32_t queue_size;
+
+    // Totals since init
+    uint32_t rasterized;
+    uint32_t evicted;
+} GlyphCache;
+
+extern GlyphCache glyph_cache;
+
+// Scale is in pixels per font unit
+bool glyph_cache_init(const uint8_t *data, uint32_t size, float scale);
+
+// Returns the entry of a code point with its metrics, NULL when the font has no glyph for it,
+// glyphs that are not on a page yet are queued and drawn by a later glyph_cache_update
+GlyphCacheEntry *glyph_cache_find(uint32_t code_point);
+
+// Marks a page as drawn this frame, so it is not evicted while it is still in use
+static inline void glyph_cache_touch(uint8_t page) { glyph_cache.pages[page].last_used = glyph_cache.frame; }
+
+// Starts a frame and rasterizes queued glyphs until the budget runs out, call it while the GPU is idle
+void glyph_cache_update(uint32_t budget_us);
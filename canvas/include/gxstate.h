@@ -0,0 +1,147 @@
+#pragma once
+
+#include <gccore.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define GXSTATE_MAX_ATTRS 26
+#define GXSTATE_MAX_VTXFMTS 8
+#define GXSTATE_MAX_TEXCOORDS 8
+#define GXSTATE_MAX_TEV_STAGES 16
+#define GXSTATE_MAX_TEXMAPS 8
+
+typedef struct GXStateVtxAttrFmt {
+    bool valid;
+    uint32_t comp_count;
+    uint32_t comp_type;
+    uint32_t frac;
+} GXStateVtxAttrFmt;
+
+typedef struct GXStateTexCoordGen {
+    bool valid;
+    uint32_t func;
+    uint32_t src;
+    uint32_t mtx;
+} GXStateTexCoordGen;
+
+typedef struct GXStateTevStage {
+    bool order_valid;
+    uint8_t texcoord;
+    uint32_t texmap;
+    uint8_t color;
+    bool op_valid;
+    uint8_t op;
+    bool color_in_valid;
+    uint8_t color_in[4];
+    bool alpha_in_valid;
+    uint8_t alpha_in[4];
+    bool alpha_op_valid;
+    uint8_t alpha_op[5];
+    bool k_alpha_sel_valid;
+    uint8_t k_alpha_sel;
+} GXStateTevStage;
+
+typedef struct GXStateTexMap {
+    bool valid;
+    GXTexObj texture;
+} GXStateTexMap;
+
+typedef struct GXState {
+    bool z_mode_valid;
+    uint8_t z_enable;
+    uint8_t z_func;
+    uint8_t z_update;
+
+    bool cull_mode_valid;
+    uint8_t cull_mode;
+
+    bool blend_mode_valid;
+    uint8_t blend_type;
+    uint8_t blend_src_fact;
+    uint8_t blend_dst_fact;
+    uint8_t blend_op;
+
+    bool num_chans_valid;
+    uint8_t num_chans;
+    bool num_tex_gens_valid;
+    uint32_t num_tex_gens;
+    GXStateTexCoordGen tex_coord_gens[GXSTATE_MAX_TEXCOORDS];
+
+    bool num_tev_stages_valid;
+    uint8_t num_tev_stages;
+    bool alpha_compare_valid;
+    uint8_t alpha_compare[5];
+
+    // Vertex descriptors are committed lazily by gxstate_begin, so a clear followed by the same descriptors is free
+    bool vtx_desc_valid;
+    uint32_t vtx_desc_touched;
+    uint8_t vtx_desc[GXSTATE_MAX_ATTRS];
+    uint8_t vtx_desc_committed[GXSTATE_MAX_ATTRS];
+    GXStateVtxAttrFmt vtx_attr_fmts[GXSTATE_MAX_VTXFMTS][GXSTATE_MAX_ATTRS];
+
+    GXStateTevStage tev_stages[GXSTATE_MAX_TEV_STAGES];
+    GXStateTexMap tex_maps[GXSTATE_MAX_TEXMAPS];
+
+    // Counters of the current frame, reset by gxstate_reset_stats
+    uint32_t issued;
+    uint32_t elided;
+} GXState;
+
+// State recorded once into a display list and applied with a single call
+typedef struct GXStateBlock {
+    void *data;
+    uint32_t size;
+    GXState state;
+} GXStateBlock;
+
+extern GXState gxstate;
+
+void gxstate_invalidate(void);
+
+void gxstate_reset_stats(void);
+
+void gxstate_set_z_mode(uint8_t enable, uint8_t func, uint8_t update);
+
+void gxstate_set_cull_mode(uint8_t mode);
+
+void gxstate_set_blend_mode(uint8_t type, uint8_t src_fact, uint8_t dst_fact, uint8_t op);
+
+void gxstate_set_num_chans(uint8_t num);
+
+void gxstate_set_num_tex_gens(uint32_t num);
+
+void gxstate_set_tex_coord_gen(uint16_t texcoord, uint32_t func, uint32_t src, uint32_t mtx);
+
+void gxstate_set_num_tev_stages(uint8_t num);
+
+void gxstate_set_alpha_compare(uint8_t comp0, uint8_t ref0, uint8_t aop, uint8_t comp1, uint8_t ref1);
+
+void gxstate_clear_vtx_desc(void);
+
+void gxstate_set_vtx_desc(uint8_t attr, uint8_t type);
+
+void gxstate_set_vtx_attr_fmt(uint8_t vtxfmt, uint32_t attr, uint32_t comp_count, uint32_t comp_type, uint32_t frac);
+
+void gxstate_set_tev_order(uint8_t stage, uint8_t texcoord, uint32_t texmap, uint8_t color);
+
+void gxstate_set_tev_op(uint8_t stage, uint8_t op);
+
+void gxstate_set_tev_color_in(uint8_t stage, uint8_t a, uint8_t b, uint8_t c, uint8_t d);
+
+void gxstate_set_tev_alpha_in(uint8_t stage, uint8_t a, uint8_t b, uint8_t c, uint8_t d);
+
+void gxstate_set_tev_alpha_op(uint8_t stage, uint8_t op, uint8_t bias, uint8_t scale, uint8_t clamp, uint8_t reg);
+
+void gxstate_set_tev_k_alpha_sel(uint8_t stage, uint8_t sel);
+
+bool gxstate_load_tex_obj(GXTexObj *texture, uint8_t map);
+
+void gxstate_commit(void);
+
+void gxstate_begin(uint8_t primitive, uint8_t vtxfmt, uint16_t vertex_count);
+
+void gxstate_block_begin(GXStateBlock *block, uint32_t capacity);
+
+void gxstate_block_end(GXStateBlock *block);
+
+void gxstate_block_apply(GXStateBlock *block);
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <gccore.h>
+#include <stdint.h>
+
+// Matrix kernels for the frame loop, paired singles on the Wii and the same math in plain C elsewhere
+
+void matrix_concat(Mtx a, Mtx b, Mtx ab);
+
+void matrix_rotation_xy(Mtx m, float sin_x, float cos_x, float sin_y, float cos_y, float x, float y, float z);
+
+void matrix_transform_points_2d(Mtx m, const float *src, float *dst, uint32_t count);
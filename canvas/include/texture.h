@@ -1,9 +1,108 @@
 #pragma once
 
 #include <gccore.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
+#include "cmpr.h"
+
+// Pass as format to let texture_load_png_palette pick the smallest format that keeps the image
+#define TEXTURE_FORMAT_AUTO 0xff
+
+// Automatic formats may move a channel as far as 5 bit channels do, CMPR is taken at this PSNR for opaque or
+// 1 bit alpha images
+#define TEXTURE_AUTO_MAX_ERROR 8
+#define TEXTURE_AUTO_MIN_PSNR 40.0f
+
+// CI4 textures index up to 16 colors and CI8 textures up to 256, loaded into one of the 256 entry TLUTs
+#define TEXTURE_PALETTE_MAX_COLORS 256
+#define TEXTURE_PALETTE_CI4_COLORS 16
+
+// Lloyd passes that move the median cut colors to the mean of the colors nearest to them
+#define TEXTURE_QUANTIZE_PASSES 2
+
+// Colors are counted up to one more than a palette holds, in a set of 1 << TEXTURE_ANALYSIS_SET_BITS slots
+#define TEXTURE_ANALYSIS_MAX_COLORS TEXTURE_PALETTE_MAX_COLORS
+#define TEXTURE_ANALYSIS_SET_BITS 9
+
+// RGB5A3 texels with this alpha or more are opaque, halfway between 219, the most a 3 bit alpha expands to, and 255
+#define TEXTURE_RGB5A3_OPAQUE_ALPHA 237
+
+// GX_TF_I4 to GX_TF_RGB5A3, the formats with a channel error per texel
+#define TEXTURE_ANALYSIS_FORMATS (GX_TF_RGB5A3 + 1)
+
+typedef enum TextureAlpha {
+    TEXTURE_ALPHA_NONE,
+    TEXTURE_ALPHA_BINARY,
+    TEXTURE_ALPHA_FULL,
+} TextureAlpha;
+
+typedef struct TextureAnalysis {
+    bool gray;
+    TextureAlpha alpha;
+    uint32_t colors_size;
+    // Largest channel error of each format as the canvas draws it, indexed by GX_TF_ format
+    uint8_t errors[TEXTURE_ANALYSIS_FORMATS];
+} TextureAnalysis;
+
+// TLUT entries of a CI4 or CI8 texture, setting new colors recolors every texture that uses the TLUT without
+// touching their texels
+typedef struct TexturePalette {
+    GXTlutObj tlut;
+    uint32_t name;
+    // GX_TL_IA8, GX_TL_RGB565 or GX_TL_RGB5A3, picked for the colors the palette was created with
+    uint8_t format;
+    uint32_t colors_size;
+    // Big endian entries rounded up to 16, the unit GX loads TLUTs in
+    uint8_t *entries;
+} TexturePalette;
+
+typedef enum TextureDither {
+    TEXTURE_DITHER_NONE,
+    TEXTURE_DITHER_ORDERED,
+    TEXTURE_DITHER_DIFFUSION,
+} TextureDither;
+
+// Any size works for RGBA8, the last row and column of tiles are padded with transparent black
 uint8_t *texture_convert_rgba8(uint8_t *src, int32_t width, int32_t height);
 
-void texture_load_png_rgba8(GXTexObj *texture, const uint8_t *data, size_t size);
+// Compresses to GX_TF_CMPR, 4 bits per texel for opaque art or art with 1 bit alpha
+uint8_t *texture_convert_cmpr(uint8_t *src, int32_t width, int32_t height, CmprQuality quality);
+
+// Converts RGBA pixels into the tiles of GX_TF_I4, I8, IA4, IA8, RGB565, RGB5A3, RGBA8 or CMPR in its fast mode,
+// NULL for other formats. CI4 and CI8 take one palette index byte per pixel instead.
+// I4 and I8 hold the luminance premultiplied by alpha, so white images with alpha keep their coverage
+uint8_t *texture_convert(uint8_t *src, int32_t width, int32_t height, uint8_t format);
+
+// Rewrites RGBA pixels in place with a 4x4 Bayer pattern or Floyd-Steinberg error diffusion, so that
+// texture_convert to format keeps their average color
+void texture_dither(uint8_t *src, int32_t width, int32_t height, uint8_t format, TextureDither dither);
+
+void texture_analyze(const uint8_t *src, int32_t width, int32_t height, TextureAnalysis *analysis);
+
+// Returns the format with the fewest bits per texel within max_error, or CMPR at min_psnr, RGBA8 when none is.
+// CI4 and CI8 are only picked with palette, for images whose colors all fit or reach min_psnr once quantized
+uint8_t texture_pick_format(const uint8_t *src, int32_t width, int32_t height, const TextureAnalysis *analysis,
+                            uint8_t max_error, float min_psnr, bool palette);
+
+// Median cut to at most colors_max RGBA colors refined by TEXTURE_QUANTIZE_PASSES, writes the colors to palette and the
+// palette index of every pixel to indices, returns the number of colors. Images with few colors keep them exactly.
+uint32_t texture_quantize_palette(const uint8_t *src, int32_t width, int32_t height, uint32_t colors_max,
+                                  uint8_t *palette, uint8_t *indices);
+
+// The smallest TLUT format that holds RGBA colors, IA8 for gray ones, RGB565 for opaque ones and RGB5A3 otherwise
+uint8_t texture_palette_format(const uint8_t *colors, uint32_t colors_size);
+
+// Allocates the entries of a palette for TLUT name, set its colors before drawing with it
+void texture_palette_init(TexturePalette *palette, uint32_t name, uint8_t format, uint32_t colors_size);
+
+// Encodes colors_size RGBA colors and loads them into the TLUT, the GPU reads the entries when it reaches the load so
+// a palette should change at most once per frame. Palettes without entries are left alone.
+void texture_palette_set(TexturePalette *palette, const uint8_t *colors);
+
+// Loads a GX_TF_CI4 or CI8 texture that reads TLUT tlut_name, its colors go to the optional colors buffer of
+// TEXTURE_PALETTE_MAX_COLORS RGBA colors so they can be edited for texture_palette_set. With TEXTURE_FORMAT_AUTO
+// palettes compete with the other formats, the palette is zeroed when another format wins.
+bool texture_load_png_palette(GXTexObj *texture, TexturePalette *palette, uint32_t tlut_name, uint8_t *colors,
+                              const uint8_t *data, size_t size, uint8_t format);
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Minimal TrueType reader and rasterizer for glyf outlines, enough to draw glyphs of an embedded font
+
+#define TRUETYPE_MAX_RASTER 128
+
+typedef struct TrueType {
+    const uint8_t *data;
+    uint32_t size;
+    uint32_t cmap;
+    uint32_t glyf;
+    uint32_t loca;
+    uint32_t hmtx;
+    uint32_t kern;
+    uint16_t cmap_format;
+    uint16_t num_glyphs;
+    uint16_t num_hmetrics;
+    uint16_t units_per_em;
+    int16_t index_to_loc_format;
+    int16_t ascent;
+    int16_t descent;
+    int16_t line_gap;
+} TrueType;
+
+typedef struct TrueTypeBox {
+    int32_t x0;
+    int32_t y0;
+    int32_t x1;
+    int32_t y1;
+} TrueTypeBox;
+
+bool truetype_init(TrueType *font, const uint8_t *data, uint32_t size);
+
+// Returns the glyph index of a code point, 0 is the missing glyph
+uint16_t truetype_find_glyph(TrueType *font, uint32_t code_point);
+
+// Advance width in font units
+int32_t truetype_get_advance(TrueType *font, uint16_t glyph);
+
+// Kerning between two glyphs in font units from the kern table, 0 when the pair has none
+int32_t truetype_get_kerning(TrueType *font, uint16_t left, uint16_t right);
+
+// Pixel box of a glyph at scale pixels per font unit with y pointing down from the baseline, false when empty
+bool truetype_get_box(TrueType *font, uint16_t glyph, float scale, TrueTypeBox *box);
+
+// Rasterizes a glyph with its box origin at the top left of dst as 8 bit coverage, the box can be
+// at most TRUETYPE_MAX_RASTER square
+void truetype_rasterize(TrueType *font, uint16_t glyph, float scale, TrueTypeBox *box, uint8_t *dst, int32_t stride);
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// UTF-8 decoding with a small state machine, invalid or truncated sequences become U+FFFD
+
+#define UTF8_REPLACEMENT_CHARACTER 0xfffd
+
+// Decodes the code point at *index < len and advances *index, never reads at or past len
+uint32_t utf8_decode_next(const char *buf, size_t len, size_t *index);
+
+// Decodes a whole buffer, out needs room for len code points, returns the number of code points
+size_t utf8_decode_to_codepoints(const char *buf, size_t len, uint32_t *out);
@@ -0,0 +1,182 @@
+#include "atlas.h"
+
+#include <malloc.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "stb_image.h"
+
+// Every image gets a one pixel border of its own edge pixels, so filtering never samples a neighbour
+#define ATLAS_PADDING 1
+
+void atlas_init(Atlas *atlas, uint16_t width, uint16_t height, uint32_t tlut_name) {
+    atlas->width = width;
+    atlas->height = height;
+    atlas->tlut_name = tlut_name;
+    atlas->pages_size = 0;
+}
+
+static AtlasPage *atlas_add_page(Atlas *atlas) {
+    if (atlas->pages_size == ATLAS_MAX_PAGES) return NULL;
+    uint32_t tlut_name = atlas->tlut_name + atlas->pages_size;
+    AtlasPage *page = &atlas->pages[atlas->pages_size++];
+    uint32_t size = atlas->width * atlas->height;
+    page->pixels = memalign(32, size);
+    memset(page->pixels, 0, size);
+    page->skyline[0] = (AtlasSkylineNode){0, 0, atlas->width};
+    page->skyline_size = 1;
+
+    // Unused entries stay transparent
+    memset(page->colors, 0, sizeof(page->colors));
+    page->colors_size = 1;
+    texture_palette_init(&page->palette, tlut_name, GX_TL_RGB5A3, TEXTURE_PALETTE_MAX_COLORS);
+    GX_InitTexObjCI(&page->texture, page->pixels, atlas->width, atlas->height, GX_TF_CI8, GX_CLAMP, GX_CLAMP,
+                    GX_FALSE, tlut_name);
+    return page;
+}
+
+static int32_t atlas_skyline_fit(Atlas *atlas, AtlasPage *page, uint32_t index, int32_t width, int32_t height) {
+    // Returns the lowest y where the rect fits with its left edge at this skyline node, or -1
+    int32_t x = page->skyline[index].x;
+    if (x + width > atlas->width) return -1;
+    int32_t y = 0;
+    int32_t width_left = width;
+    while (width_left > 0) {
+        if (index == page->skyline_size) return -1;
+        if (page->skyline[index].y > y) y = page->skyline[index].y;
+        if (y + height > atlas->height) return -1;
+        width_left -= page->skyline[index].width;
+        index++;
+    }
+    return y;
+}
+
+static bool atlas_skyline_insert(Atlas *atlas, AtlasPage *page, int32_t width, int32_t height, int32_t *out_x,
+                                 int32_t *out_y) {
+    // Find the bottom left position, ties go to the narrowest node
+    int32_t best_index = -1, best_bottom = INT32_MAX, best_width = INT32_MAX, best_y = 0;
+    for (uint32_t i = 0; i < page->skyline_size; i++) {
+        int32_t y = atlas_skyline_fit(atlas, page, i, width, height);
+        if (y == -1) continue;
+        if (y + height < best_bottom || (y + height == best_bottom && page->skyline[i].width < best_width)) {
+            best_index = i;
+            best_bottom = y + height;
+            best_width = page->skyline[i].width;
+            best_y = y;
+        }
+    }
+    if (best_index == -1 || page->skyline_size == ATLAS_MAX_SKYLINE) return false;
+
+    // Insert new node and shrink the nodes it covers
+    AtlasSkylineNode node = {page->skyline[best_index].x, best_y + height, width};
+    memmove(&page->skyline[best_index + 1], &page->skyline[best_index],
+            (page->skyline_size - best_index) * sizeof(AtlasSkylineNode));
+    page->skyline[best_index] = node;
+    page->skyline_size++;
+    for (uint32_t i = best_index + 1; i < page->skyline_size; i++) {
+        AtlasSkylineNode *previous = &page->skyline[i - 1];
+        AtlasSkylineNode *current = &page->skyline[i];
+        if (current->x >= previous->x + previous->width) break;
+        int32_t shrink = previous->x + previous->width - current->x;
+        if (current->width > shrink) {
+            current->x += shrink;
+            current->width -= shrink;
+            break;
+        }
+        memmove(current, current + 1, (page->skyline_size - i - 1) * sizeof(AtlasSkylineNode));
+        page->skyline_size--;
+        i--;
+    }
+
+    // Merge neighbours at the same height
+    for (uint32_t i = 0; i + 1 < page->skyline_size; i++) {
+        if (page->skyline[i].y == page->skyline[i + 1].y) {
+            page->skyline[i].width += page->skyline[i + 1].width;
+            memmove(&page->skyline[i + 1], &page->skyline[i + 2],
+                    (page->skyline_size - i - 2) * sizeof(AtlasSkylineNode));
+            page->skyline_size--;
+            i--;
+        }
+    }
+
+    *out_x = node.x;
+    *out_y = best_y;
+    return true;
+}
+
+static void atlas_page_blit(Atlas *atlas, AtlasPage *page, int32_t x, int32_t y, const uint8_t *indices,
+                            int32_t width, int32_t height, uint32_t colors_start) {
+    // Write indices straight into the 8x4 tiles of the CI8 page, the border repeats the edge pixels
+    for (int32_t py = -ATLAS_PADDING; py < height + ATLAS_PADDING; py++) {
+        int32_t sy = py < 0 ? 0 : (py >= height ? height - 1 : py);
+        for (int32_t px = -ATLAS_PADDING; px < width + ATLAS_PADDING; px++) {
+            int32_t sx = px < 0 ? 0 : (px >= width ? width - 1 : px);
+            int32_t dx = x + px, dy = y + py;
+            uint8_t *tile = &page->pixels[((dy >> 2) * (atlas->width >> 3) + (dx >> 3)) * 32];
+            tile[(dy & 3) * 8 + (dx & 7)] = colors_start + indices[sy * width + sx];
+        }
+    }
+    DCFlushRange(page->pixels, atlas->width * atlas->height);
+}
+
+bool atlas_add_rgba8(Atlas *atlas, AtlasRegion *region, const uint8_t *pixels, int32_t width, int32_t height,
+                     uint32_t colors_max) {
+    uint8_t colors[TEXTURE_PALETTE_MAX_COLORS * 4];
+    uint8_t *indices = malloc(width * height);
+    uint32_t colors_size = texture_quantize_palette(pixels, width, height, colors_max, colors, indices);
+
+    // Try all pages with enough free palette entries first, then start a new page
+    int32_t padded_width = width + ATLAS_PADDING * 2;
+    int32_t padded_height = height + ATLAS_PADDING * 2;
+    int32_t x, y;
+    AtlasPage *page = NULL;
+    for (uint32_t i = 0; i < atlas->pages_size; i++) {
+        AtlasPage *candidate = &atlas->pages[i];
+        if (candidate->colors_size + colors_size > TEXTURE_PALETTE_MAX_COLORS) continue;
+        if (atlas_skyline_insert(atlas, candidate, padded_width, padded_height, &x, &y)) {
+            page = candidate;
+            break;
+        }
+    }
+    if (page == NULL) {
+        page = atlas_add_page(atlas);
+        if (page == NULL || page->colors_size + colors_size > TEXTURE_PALETTE_MAX_COLORS ||
+            !atlas_skyline_insert(atlas, page, padded_width, padded_height, &x, &y)) {
+            free(indices);
+            return false;
+        }
+    }
+
+    x += ATLAS_PADDING;
+    y += ATLAS_PADDING;
+    atlas_page_blit(atlas, page, x, y, indices, width, height, page->colors_size);
+    free(indices);
+    region->texture = &page->texture;
+    region->width = width;
+    region->height = height;
+    region->left = (float)x / atlas->width;
+    region->top = (float)y / atlas->height;
+    region->right = (float)(x + width) / atlas->width;
+    region->bottom = (float)(y + height) / atlas->height;
+    region->page = page;
+    region->colors_start = page->colors_size;
+    region->colors_size = colors_size;
+    page->colors_size += colors_size;
+    atlas_set_colors(region, colors);
+    return true;
+}
+
+bool atlas_add_png(Atlas *atlas, AtlasRegion *region, const uint8_t *data, size_t size, uint32_t colors_max) {
+    int32_t width, height, channels;
+    uint8_t *pixels = stbi_load_from_memory(data, size, &width, &height, &channels, 4);
+    if (pixels == NULL) return false;
+    bool added = atlas_add_rgba8(atlas, region, pixels, width, height, colors_max);
+    free(pixels);
+    return added;
+}
+
+void atlas_set_colors(AtlasRegion *region, const uint8_t *colors) {
+    AtlasPage *page = region->page;
+    memcpy(&page->colors[region->colors_start * 4], colors, region->colors_size * 4);
+    texture_palette_set(&page->palette, page->colors);
+}
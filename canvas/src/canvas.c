@@ -1,64 +1,617 @@
 #include "canvas.h"
 
+#include <assert.h>
 #include <malloc.h>
+#include <stdarg.h>
+#include <string.h>
 
 #include "font.h"
 #include "font_png.h"
+#include "font_sdf_bin.h"
+#include "font_strings.h"
+#include "format.h"
+#include "glyph_cache.h"
+#include "lato_ttf.h"
+#include "matrix.h"
+#include "stb_image.h"
 #include "texture.h"
+#include "utf8.h"
+
+// Approximate FIFO bytes of GX commands, for the stats
+#define FIFO_BEGIN_BYTES 3
+#define FIFO_MATRIX_BYTES (5 + 12 * 4)
+#define FIFO_TEXTURE_BYTES (4 * 5)
+#define FIFO_VERTEX_BYTES (8 + 4 + 8)
+#define FIFO_INDEXED_VERTEX_BYTES (1 + 4 + 1)
+#define FIFO_COMPACT_VERTEX_BYTES (4 + 4)
+#define FIFO_CALL_LIST_BYTES (1 + 4 + 4)
+
+// Width of the page the colored font glyphs are packed into
+#define FONT_EMOJI_PAGE_WIDTH 256
+
+// Glyph cache glyphs are rasterized at this fraction of FONT_RENDER_SIZE
+#define CANVAS_GLYPH_CACHE_DOWNSCALE 2
+
+// Time per frame spent rasterizing new glyphs
+#define CANVAS_GLYPH_CACHE_BUDGET_US 1000
+
+// Text glyph pages, glyph cache pages follow the font pages
+#define CANVAS_TEXT_PAGE_MONO 0
+#define CANVAS_TEXT_PAGE_EMOJI 1
+#define CANVAS_TEXT_PAGE_CACHE 2
+
+typedef struct CanvasGroup {
+    GXTexObj *texture;
+    float min_x;
+    float min_y;
+    float max_x;
+    float max_y;
+    uint16_t first;
+    uint16_t last;
+} CanvasGroup;
+
+// Laid out glyph in font pixels at FONT_RENDER_SIZE
+typedef struct CanvasTextGlyph {
+    int16_t x;
+    int16_t y;
+    uint16_t width;
+    uint16_t height;
+    uint8_t flags;
+    uint8_t page;
+    float left;
+    float top;
+    float right;
+    float bottom;
+} CanvasTextGlyph;
+
+// Pen of a layout in font pixels and the glyph before it, for kerning
+typedef struct CanvasTextPen {
+    uint16_t advance;
+    uint8_t previous;
+} CanvasTextPen;
+
+// Long strings keep their first glyphs, the rest is laid out from text_index
+typedef struct CanvasTextLayout {
+    uint32_t hash;
+    uint32_t last_used;
+    uint16_t text_length;
+    uint16_t text_index;
+    uint16_t glyphs_size;
+    CanvasTextPen pen;
+    uint32_t glyph_cache_generation;
+    char text[CANVAS_TEXT_MAX_BYTES];
+    CanvasTextGlyph glyphs[CANVAS_TEXT_MAX_GLYPHS];
+} CanvasTextLayout;
 
 Canvas canvas;
 
-_Alignas(32) uint16_t blank_pixels[16] = {0xffff};
+static CanvasGroup batch_groups[CANVAS_BATCH_MAX_QUADS];
+static uint16_t batch_next[CANVAS_BATCH_MAX_QUADS];
+static uint16_t batch_order[CANVAS_BATCH_MAX_QUADS];
+
+// LRU cache of text layouts, empty slots have text_length 0
+static CanvasTextLayout text_layouts[CANVAS_TEXT_CACHE_SIZE];
+static uint32_t text_layouts_tick;
+static bool text_layouts_sdf;
+
+// Set when laid out text uses the glyph cache
+static bool text_layout_cached;
+
+// Glyph cache baseline from the top of the line, in font pixels
+static int16_t glyph_cache_baseline;
+
+// Top left of each glyph's box on the distance field page
+static uint16_t font_sdf_boxes[FONT_GLYPHS_MAX][2];
+
+// White block for solid fills
+uint8_t blank_pixels[4 * 4 * 4] = {[0 ... 63] = 0xff};
+
+// Unit quad vertex arrays
+_Alignas(32) float quad_positions[4][2] = {{0.5, -0.5}, {0.5, 0.5}, {-0.5, 0.5}, {-0.5, -0.5}};
+_Alignas(32) float quad_texcoords[4][2] = {{1, 0}, {1, 1}, {0, 1}, {0, 0}};
+
+static void canvas_set_state(void) {
+    // Disable depth test, disable culling and enable alpha blending
+    gxstate_set_z_mode(GX_DISABLE, GX_LEQUAL, GX_TRUE);
+    gxstate_set_cull_mode(GX_CULL_NONE);
+    gxstate_set_blend_mode(GX_BM_BLEND, GX_BL_SRCALPHA, GX_BL_INVSRCALPHA, GX_LO_CLEAR);
+
+    // Set vertex pipeline
+    gxstate_clear_vtx_desc();
+    gxstate_set_vtx_desc(GX_VA_POS, GX_DIRECT);
+    gxstate_set_vtx_desc(GX_VA_CLR0, GX_DIRECT);
+    gxstate_set_vtx_desc(GX_VA_TEX0, GX_DIRECT);
+    gxstate_set_vtx_attr_fmt(GX_VTXFMT0, GX_VA_POS, GX_POS_XY, GX_F32, 0);
+    gxstate_set_vtx_attr_fmt(GX_VTXFMT0, GX_VA_CLR0, GX_CLR_RGBA, GX_RGBA8, 0);
+    gxstate_set_vtx_attr_fmt(GX_VTXFMT0, GX_VA_TEX0, GX_TEX_ST, GX_F32, 0);
+    gxstate_set_vtx_attr_fmt(GX_VTXFMT1, GX_VA_POS, GX_POS_XY, GX_S16, CANVAS_POSITION_FRAC_BITS);
+    gxstate_set_vtx_attr_fmt(GX_VTXFMT1, GX_VA_CLR0, GX_CLR_RGBA, GX_RGBA8, 0);
+    gxstate_set_vtx_attr_fmt(GX_VTXFMT1, GX_VA_TEX0, GX_TEX_ST, GX_U16, 15);
+    GX_SetArray(GX_VA_POS, quad_positions, sizeof(quad_positions[0]));
+    GX_SetArray(GX_VA_TEX0, quad_texcoords, sizeof(quad_texcoords[0]));
+    gxstate_set_num_chans(1);
+    gxstate_set_num_tex_gens(1);
+    gxstate_set_tex_coord_gen(GX_TEXCOORD0, GX_TG_MTX2x4, GX_TG_TEX0, GX_IDENTITY);
+    gxstate_set_num_tev_stages(1);
+    gxstate_set_tev_order(GX_TEVSTAGE0, GX_TEXCOORD0, GX_TEXMAP0, GX_COLOR0A0);
+    gxstate_set_tev_op(GX_TEVSTAGE0, GX_MODULATE);
+    gxstate_set_alpha_compare(GX_ALWAYS, 0, GX_AOP_AND, GX_ALWAYS, 0);
+}
+
+static void canvas_load_font(void) {
+    int32_t width, height, channels;
+    uint8_t *pixels = stbi_load_from_memory(font_png, font_png_size, &width, &height, &channels, 4);
+
+    // Monochrome glyphs go on a cropped I4 page
+    uint32_t mono_height = 0;
+    for (uint32_t i = 0; i < font_table.glyphs_size; i++) {
+        FontGlyph *glyph = &font_table.glyphs[i];
+        if ((glyph->flags & FONT_GLYPH_COLORED) == 0 && glyph->y + glyph->height > mono_height) {
+            mono_height = glyph->y + glyph->height;
+        }
+    }
+    mono_height = (mono_height + 7) & ~7;
+    uint8_t *mono = texture_convert(pixels, width, mono_height, GX_TF_I4);
+    DCFlushRange(mono, width * mono_height / 2);
+    GX_InitTexObj(&canvas.font_texture, mono, width, mono_height, GX_TF_I4, GX_CLAMP, GX_CLAMP, GX_FALSE);
+
+    // Shelf pack colored glyphs onto an RGB5A3 page
+    uint16_t emoji_x[FONT_GLYPHS_MAX];
+    uint16_t emoji_y[FONT_GLYPHS_MAX];
+    uint32_t shelf_x = 0, shelf_y = 0, shelf_height = 0;
+    for (uint32_t i = 0; i < font_table.glyphs_size; i++) {
+        FontGlyph *glyph = &font_table.glyphs[i];
+        if ((glyph->flags & FONT_GLYPH_COLORED) == 0 || glyph->width == 0 || glyph->height == 0) continue;
+        if (shelf_x + glyph->width + 2 > FONT_EMOJI_PAGE_WIDTH) {
+            shelf_x = 0;
+            shelf_y += shelf_height;
+            shelf_height = 0;
+        }
+        emoji_x[i] = shelf_x + 1;
+        emoji_y[i] = shelf_y + 1;
+        shelf_x += glyph->width + 2;
+        if (glyph->height + 2 > shelf_height) shelf_height = glyph->height + 2;
+    }
+    uint32_t emoji_height = (shelf_y + shelf_height + 3) & ~3;
+    if (emoji_height == 0) emoji_height = 4;
+    uint8_t *emoji_pixels = calloc(FONT_EMOJI_PAGE_WIDTH * emoji_height, 4);
+    for (uint32_t i = 0; i < font_table.glyphs_size; i++) {
+        FontGlyph *glyph = &font_table.glyphs[i];
+        if ((glyph->flags & FONT_GLYPH_COLORED) == 0 || glyph->width == 0 || glyph->height == 0) continue;
+        for (uint32_t y = 0; y < glyph->height; y++) {
+            memcpy(&emoji_pixels[((emoji_y[i] + y) * FONT_EMOJI_PAGE_WIDTH + emoji_x[i]) * 4],
+                   &pixels[((glyph->y + y) * width + glyph->x) * 4], glyph->width * 4);
+        }
+        glyph->x = emoji_x[i];
+        glyph->y = emoji_y[i];
+    }
+    // Ordered dither keeps emoji gradients from banding in RGB5A3
+    texture_dither(emoji_pixels, FONT_EMOJI_PAGE_WIDTH, emoji_height, GX_TF_RGB5A3, TEXTURE_DITHER_ORDERED);
+    uint8_t *emoji = texture_convert(emoji_pixels, FONT_EMOJI_PAGE_WIDTH, emoji_height, GX_TF_RGB5A3);
+    DCFlushRange(emoji, FONT_EMOJI_PAGE_WIDTH * emoji_height * 2);
+    GX_InitTexObj(&canvas.font_emoji_texture, emoji, FONT_EMOJI_PAGE_WIDTH, emoji_height, GX_TF_RGB5A3, GX_CLAMP,
+                  GX_CLAMP, GX_FALSE);
+    free(emoji_pixels);
+    free(pixels);
+
+    // Load distance field page from tools/font_sdf.c
+    const uint8_t *sdf = font_sdf_bin;
+    uint16_t sdf_width = (sdf[4] << 8) | sdf[5];
+    uint16_t sdf_height = (sdf[6] << 8) | sdf[7];
+    uint16_t sdf_glyphs_size = (sdf[8] << 8) | sdf[9];
+    for (uint32_t i = 0; i < sdf_glyphs_size; i++) {
+        const uint8_t *entry = &sdf[FONT_SDF_HEADER_SIZE + i * FONT_SDF_GLYPH_SIZE];
+        uint32_t code_point = (entry[0] << 24) | (entry[1] << 16) | (entry[2] << 8) | entry[3];
+        uint8_t glyph_index = font_table_find(code_point);
+        if (glyph_index == FONT_GLYPH_NONE) continue;
+        font_sdf_boxes[glyph_index][0] = (entry[4] << 8) | entry[5];
+        font_sdf_boxes[glyph_index][1] = (entry[6] << 8) | entry[7];
+    }
+    uint32_t sdf_size = sdf_width * sdf_height;
+    uint8_t *sdf_pixels = memalign(32, sdf_size);
+    memcpy(sdf_pixels, &sdf[FONT_SDF_HEADER_SIZE + sdf_glyphs_size * FONT_SDF_GLYPH_SIZE], sdf_size);
+    DCFlushRange(sdf_pixels, sdf_size);
+    GX_InitTexObj(&canvas.font_sdf_texture, sdf_pixels, sdf_width, sdf_height, GX_TF_I8, GX_CLAMP, GX_CLAMP, GX_FALSE);
+
+    uint32_t emoji_memory = GX_GetTexBufferSize(FONT_EMOJI_PAGE_WIDTH, emoji_height, GX_TF_RGB5A3, GX_FALSE, 0);
+    canvas.font_memory = GX_GetTexBufferSize(width, mono_height, GX_TF_I4, GX_FALSE, 0) + emoji_memory;
+    canvas.font_sdf_memory = GX_GetTexBufferSize(sdf_width, sdf_height, GX_TF_I8, GX_FALSE, 0) + emoji_memory;
+}
+
+static void canvas_load_glyph_cache(void) {
+    // Match the TrueType font to the 'H' of the baked font
+    FontGlyph *h = &font_table.glyphs[font_table_find('H')];
+    glyph_cache_baseline = h->ascent + h->height;
+    TrueType font;
+    TrueTypeBox box;
+    if (!truetype_init(&font, lato_ttf, lato_ttf_size) ||
+        !truetype_get_box(&font, truetype_find_glyph(&font, 'H'), 1, &box)) {
+        return;
+    }
+    glyph_cache_init(lato_ttf, lato_ttf_size, (float)h->height / (box.y1 - box.y0) / CANVAS_GLYPH_CACHE_DOWNSCALE);
+}
 
 void canvas_init(void) {
-    // Create blank texture
-    GX_InitTexObj(&canvas.blank_texture, blank_pixels, 1, 1, GX_TF_RGB565, GX_CLAMP, GX_CLAMP, GX_FALSE);
+    canvas.batching = true;
+    canvas.deferred = true;
+    canvas.indexed = true;
+    canvas.compact = true;
+    canvas.sdf = true;
+    DCFlushRange(quad_positions, sizeof(quad_positions));
+    DCFlushRange(quad_texcoords, sizeof(quad_texcoords));
+
+    // Create shared atlas with the blank region
+    atlas_init(&canvas.atlas, CANVAS_ATLAS_SIZE, CANVAS_ATLAS_SIZE, CANVAS_ATLAS_TLUT);
+    atlas_add_rgba8(&canvas.atlas, &canvas.blank_region, blank_pixels, 4, 4, 1);
 
-    // Load font texture
-    texture_load_png_rgba8(&canvas.font_texture, font_png, font_png_size);
+    // Build font glyph lookup table and load its pages
+    font_table_init();
+    canvas_load_font();
+    canvas_load_glyph_cache();
+
+    // Record canvas state block and set it once directly
+    gxstate_block_begin(&canvas.state_block, 512);
+    canvas_set_state();
+    gxstate_block_end(&canvas.state_block);
+    canvas_set_state();
+    gxstate_commit();
 }
 
 void canvas_begin(uint32_t screen_width, uint32_t screen_height) {
     // Reset canvas state
     guMtxIdentity(canvas.transform_matrix);
+    canvas.identity_loaded = false;
+    canvas.batch_size = 0;
+    canvas.recording = NULL;
+    canvas.immediate = NULL;
+    canvas.stats = (CanvasStats){0};
 
     // Set ortographic matrix
     Mtx44 projection_matrix;
     guOrtho(projection_matrix, 0, screen_height, 0, screen_width, -1, 1);
     GX_LoadProjectionMtx(projection_matrix, GX_ORTHOGRAPHIC);
 
-    // Disable depth test, disable culling and enable alpha blending
-    GX_SetZMode(GX_DISABLE, GX_LEQUAL, GX_TRUE);
-    GX_SetCullMode(GX_CULL_NONE);
-    GX_SetBlendMode(GX_BM_BLEND, GX_BL_SRCALPHA, GX_BL_INVSRCALPHA, GX_LO_CLEAR);
+    // Set canvas state
+    gxstate_block_apply(&canvas.state_block);
+    canvas.texcoord_shift = 15;
 
-    // Set vertex pipeline
-    GX_ClearVtxDesc();
-    GX_SetVtxDesc(GX_VA_POS, GX_DIRECT);
-    GX_SetVtxDesc(GX_VA_CLR0, GX_DIRECT);
-    GX_SetVtxDesc(GX_VA_TEX0, GX_DIRECT);
-    GX_SetVtxAttrFmt(GX_VTXFMT0, GX_VA_POS, GX_POS_XY, GX_F32, 0);
-    GX_SetVtxAttrFmt(GX_VTXFMT0, GX_VA_CLR0, GX_CLR_RGBA, GX_RGBA8, 0);
-    GX_SetVtxAttrFmt(GX_VTXFMT0, GX_VA_TEX0, GX_TEX_ST, GX_F32, 0);
-    GX_SetNumChans(1);
-    GX_SetNumTexGens(1);
-    GX_SetTexCoordGen(GX_TEXCOORD0, GX_TG_MTX2x4, GX_TG_TEX0, GX_IDENTITY);
-    GX_SetTevOrder(GX_TEVSTAGE0, GX_TEXCOORD0, GX_TEXMAP0, GX_COLOR0A0);
-    GX_SetTevOp(GX_TEVSTAGE0, GX_MODULATE);
+    // Rasterize queued glyphs while the gpu is idle
+    glyph_cache_update(CANVAS_GLYPH_CACHE_BUDGET_US);
+}
+
+static int32_t canvas_glyph_cache_page(GXTexObj *texture) {
+    for (uint32_t i = 0; i < glyph_cache.pages_size; i++) {
+        if (texture == &glyph_cache.pages[i].texture) return i;
+    }
+    return -1;
+}
+
+static void canvas_load_texture(GXTexObj *texture) {
+    // Remember which textures a recorded list depends on
+    CanvasList *list = canvas.recording;
+    if (list != NULL) {
+        bool found = false;
+        for (uint32_t i = 0; i < list->textures_size; i++) {
+            if (list->textures[i] == texture) found = true;
+        }
+        if (!found && list->textures_size < CANVAS_LIST_MAX_TEXTURES) list->textures[list->textures_size++] = texture;
+    }
+
+    if (texture == &canvas.font_sdf_texture) {
+        // Distance field text, threshold the field then apply the vertex alpha
+        gxstate_set_num_tev_stages(2);
+        gxstate_set_tev_color_in(GX_TEVSTAGE0, GX_CC_ZERO, GX_CC_ZERO, GX_CC_ZERO, GX_CC_RASC);
+        gxstate_set_tev_k_alpha_sel(GX_TEVSTAGE0, GX_TEV_KASEL_3_8);
+        gxstate_set_tev_alpha_in(GX_TEVSTAGE0, GX_CA_KONST, GX_CA_ZERO, GX_CA_ZERO, GX_CA_TEXA);
+        gxstate_set_tev_alpha_op(GX_TEVSTAGE0, GX_TEV_SUB, GX_TB_ZERO, GX_CS_SCALE_4, GX_TRUE, GX_TEVPREV);
+        gxstate_set_tev_order(GX_TEVSTAGE1, GX_TEXCOORDNULL, GX_TEXMAP_NULL, GX_COLOR0A0);
+        gxstate_set_tev_color_in(GX_TEVSTAGE1, GX_CC_ZERO, GX_CC_ZERO, GX_CC_ZERO, GX_CC_CPREV);
+        gxstate_set_tev_alpha_in(GX_TEVSTAGE1, GX_CA_ZERO, GX_CA_APREV, GX_CA_RASA, GX_CA_ZERO);
+        gxstate_set_tev_alpha_op(GX_TEVSTAGE1, GX_TEV_ADD, GX_TB_ZERO, GX_CS_SCALE_1, GX_TRUE, GX_TEVPREV);
+        gxstate_set_alpha_compare(GX_GREATER, 0, GX_AOP_AND, GX_ALWAYS, 0);
+    } else if (GX_GetTexObjFmt(texture) == GX_TF_I4 || canvas_glyph_cache_page(texture) != -1) {
+        // Coverage masks tinted by the vertex color
+        gxstate_set_num_tev_stages(1);
+        gxstate_set_tev_color_in(GX_TEVSTAGE0, GX_CC_ZERO, GX_CC_ZERO, GX_CC_ZERO, GX_CC_RASC);
+        gxstate_set_tev_alpha_in(GX_TEVSTAGE0, GX_CA_ZERO, GX_CA_TEXA, GX_CA_RASA, GX_CA_ZERO);
+        gxstate_set_tev_alpha_op(GX_TEVSTAGE0, GX_TEV_ADD, GX_TB_ZERO, GX_CS_SCALE_1, GX_TRUE, GX_TEVPREV);
+        gxstate_set_alpha_compare(GX_ALWAYS, 0, GX_AOP_AND, GX_ALWAYS, 0);
+    } else {
+        // All other textures modulate the vertex color
+        gxstate_set_num_tev_stages(1);
+        gxstate_set_tev_op(GX_TEVSTAGE0, GX_MODULATE);
+        gxstate_set_alpha_compare(GX_ALWAYS, 0, GX_AOP_AND, GX_ALWAYS, 0);
+    }
+
+    if (!gxstate_load_tex_obj(texture, GX_TEXMAP0)) return;
+    canvas.stats.texture_loads++;
+    canvas.stats.fifo_bytes += FIFO_TEXTURE_BYTES;
+}
+
+static void canvas_load_matrix(Mtx matrix) {
+    if (canvas.immediate != NULL) {
+        Mtx offset_matrix;
+        matrix_concat(canvas.immediate->offset_matrix, matrix, offset_matrix);
+        GX_LoadPosMtxImm(offset_matrix, GX_PNMTX0);
+    } else {
+        GX_LoadPosMtxImm(matrix, GX_PNMTX0);
+    }
+    canvas.stats.matrix_loads++;
+    canvas.stats.fifo_bytes += FIFO_MATRIX_BYTES;
+}
+
+static void canvas_count_draw(uint32_t vertex_count, uint32_t vertex_bytes) {
+    canvas.stats.draw_calls++;
+    canvas.stats.fifo_bytes += FIFO_BEGIN_BYTES + vertex_count * vertex_bytes;
+}
+
+static uint8_t canvas_texcoord_shift(GXTexObj *texture) {
+    // One step per texel for power of two textures
+    uint32_t width = GX_GetTexObjWidth(texture);
+    uint32_t height = GX_GetTexObjHeight(texture);
+    uint32_t size = width > height ? width : height;
+    if ((width & (width - 1)) != 0 || (height & (height - 1)) != 0 || size > (1 << 15)) return 15;
+    uint8_t shift = 0;
+    while ((1u << shift) < size) shift++;
+    return shift;
+}
+
+static void canvas_begin_quads(GXTexObj *texture, uint32_t vertex_count) {
+    if (canvas.compact) {
+        // U8 texcoords up to a shift of 7
+        canvas.texcoord_shift = canvas_texcoord_shift(texture);
+        gxstate_set_vtx_attr_fmt(GX_VTXFMT1, GX_VA_TEX0, GX_TEX_ST, canvas.texcoord_shift <= 7 ? GX_U8 : GX_U16,
+                                 canvas.texcoord_shift);
+        gxstate_begin(GX_QUADS, GX_VTXFMT1, vertex_count);
+    } else {
+        gxstate_begin(GX_QUADS, GX_VTXFMT0, vertex_count);
+    }
+}
+
+static int16_t canvas_to_fixed(float value) {
+    float scaled = value * (1 << CANVAS_POSITION_FRAC_BITS);
+    if (scaled >= INT16_MAX) return INT16_MAX;
+    if (scaled <= INT16_MIN) return INT16_MIN;
+    return (int16_t)(scaled >= 0 ? scaled + 0.5f : scaled - 0.5f);
+}
+
+static void canvas_emit_vertex(float x, float y, uint32_t color, float u, float v) {
+    if (canvas.compact) {
+        GX_Position2s16(canvas_to_fixed(x), canvas_to_fixed(y));
+        GX_Color1u32(color);
+        float scale = 1 << canvas.texcoord_shift;
+        if (canvas.texcoord_shift <= 7) {
+            GX_TexCoord2u8(u * scale + 0.5f, v * scale + 0.5f);
+        } else {
+            GX_TexCoord2u16(u * scale + 0.5f, v * scale + 0.5f);
+        }
+    } else {
+        GX_Position2f32(x, y);
+        GX_Color1u32(color);
+        GX_TexCoord2f32(u, v);
+    }
+}
+
+static void canvas_end_quads(uint32_t vertex_count) {
+    GX_End();
+    if (canvas.compact) {
+        canvas_count_draw(vertex_count, FIFO_COMPACT_VERTEX_BYTES + (canvas.texcoord_shift <= 7 ? 2 : 4));
+    } else {
+        canvas_count_draw(vertex_count, FIFO_VERTEX_BYTES);
+    }
+}
+
+static void canvas_set_indexed(bool indexed) {
+    gxstate_set_vtx_desc(GX_VA_POS, indexed ? GX_INDEX8 : GX_DIRECT);
+    gxstate_set_vtx_desc(GX_VA_TEX0, indexed ? GX_INDEX8 : GX_DIRECT);
+}
+
+static void canvas_invalidate_state(void) {
+    // Emit all state again, display lists change it behind our back
+    gxstate_invalidate();
+    canvas.identity_loaded = false;
+}
+
+static bool canvas_quads_overlap(float min_x, float min_y, float max_x, float max_y, float other_min_x,
+                                 float other_min_y, float other_max_x, float other_max_y) {
+    return min_x < other_max_x && other_min_x < max_x && min_y < other_max_y && other_min_y < max_y;
+}
+
+static uint32_t canvas_sort_batch(void) {
+    // Group quads by texture without moving a quad past one it overlaps
+    uint32_t group_count = 0;
+    for (uint32_t i = 0; i < canvas.batch_size; i++) {
+        CanvasQuad *quad = &canvas.batch_quads[i];
+        int32_t target = -1;
+        for (int32_t j = group_count - 1; j >= 0; j--) {
+            CanvasGroup *group = &batch_groups[j];
+            if (group->texture == quad->texture) target = j;
+            if (canvas_quads_overlap(quad->min_x, quad->min_y, quad->max_x, quad->max_y, group->min_x, group->min_y,
+                                     group->max_x, group->max_y)) {
+                bool overlaps = false;
+                for (uint32_t k = group->first; k != UINT16_MAX; k = batch_next[k]) {
+                    CanvasQuad *other = &canvas.batch_quads[k];
+                    if (canvas_quads_overlap(quad->min_x, quad->min_y, quad->max_x, quad->max_y, other->min_x,
+                                             other->min_y, other->max_x, other->max_y)) {
+                        overlaps = true;
+                        break;
+                    }
+                }
+                if (overlaps) break;
+            }
+        }
+
+        // Append quad to target group or start a new group
+        batch_next[i] = UINT16_MAX;
+        if (target != -1) {
+            CanvasGroup *group = &batch_groups[target];
+            batch_next[group->last] = i;
+            group->last = i;
+            if (quad->min_x < group->min_x) group->min_x = quad->min_x;
+            if (quad->min_y < group->min_y) group->min_y = quad->min_y;
+            if (quad->max_x > group->max_x) group->max_x = quad->max_x;
+            if (quad->max_y > group->max_y) group->max_y = quad->max_y;
+        } else {
+            batch_groups[group_count++] = (CanvasGroup){quad->texture, quad->min_x, quad->min_y, quad->max_x,
+                                                        quad->max_y, i, i};
+        }
+    }
+
+    // Write draw order
+    uint32_t position = 0;
+    for (uint32_t i = 0; i < group_count; i++) {
+        for (uint32_t k = batch_groups[i].first; k != UINT16_MAX; k = batch_next[k]) {
+            batch_order[position++] = k;
+        }
+    }
+    return group_count;
+}
+
+// Ends an overflowed recording, its draws go out immediately
+static void canvas_record_overflow(CanvasList *list) {
+    SYS_Report("canvas: display list overflowed its %u bytes, drawing it immediately\n", (unsigned)list->capacity);
+    list->overflowed = true;
+    list->size = 0;
+    canvas.recording = NULL;
+    canvas.batching = canvas.recording_batching;
+    canvas.stats = canvas.recording_stats;
+    canvas.immediate = list;
+    canvas_invalidate_state();
+}
+
+static void canvas_draw_batch(void) {
+    if (canvas.batch_size == 0) return;
+
+    // Batched vertices are already in screen space
+    if (!canvas.identity_loaded) {
+        Mtx identity_matrix;
+        guMtxIdentity(identity_matrix);
+        canvas_load_matrix(identity_matrix);
+        canvas.identity_loaded = true;
+    }
+    canvas_set_indexed(false);
+
+    // Count texture runs in submission order
+    uint32_t run_count = 1;
+    for (uint32_t i = 1; i < canvas.batch_size; i++) {
+        if (canvas.batch_quads[i].texture != canvas.batch_quads[i - 1].texture) run_count++;
+    }
+
+    // Regroup quads by texture when possible
+    if (canvas.deferred && run_count > 1) {
+        canvas.stats.texture_loads_saved += run_count - canvas_sort_batch();
+    } else {
+        for (uint32_t i = 0; i < canvas.batch_size; i++) batch_order[i] = i;
+    }
+
+    // Draw all quads of each texture run at once
+    uint32_t start = 0;
+    while (start < canvas.batch_size) {
+        GXTexObj *texture = canvas.batch_quads[batch_order[start]].texture;
+        uint32_t end = start + 1;
+        while (end < canvas.batch_size && canvas.batch_quads[batch_order[end]].texture == texture) end++;
+
+        canvas_load_texture(texture);
+        uint32_t vertex_count = (end - start) * 4;
+        canvas_begin_quads(texture, vertex_count);
+        for (uint32_t i = start; i < end; i++) {
+            CanvasVertex *vertices = &canvas.batch_vertices[batch_order[i] * 4];
+            for (int32_t j = 0; j < 4; j++) {
+                canvas_emit_vertex(vertices[j].x, vertices[j].y, vertices[j].color, vertices[j].u, vertices[j].v);
+            }
+        }
+        canvas_end_quads(vertex_count);
+        start = end;
+    }
+
+    canvas.batch_size = 0;
+}
+
+void canvas_flush(void) {
+    // Keep recorded quads until the list ends
+    if (canvas.recording != NULL) return;
+    canvas_draw_batch();
 }
 
 void canvas_end(void) {
-    GX_SetBlendMode(GX_BM_NONE, GX_BL_SRCALPHA, GX_BL_INVSRCALPHA, GX_LO_CLEAR);
+    canvas_flush();
+    gxstate_set_blend_mode(GX_BM_NONE, GX_BL_SRCALPHA, GX_BL_INVSRCALPHA, GX_LO_CLEAR);
     GX_Flush();
 }
 
 inline void canvas_fill_rect(float x, float y, float width, float height, uint32_t color) {
-    canvas_draw_image(&canvas.blank_texture, x, y, width, height, color);
+    // Sample the middle of the blank region
+    AtlasRegion *blank = &canvas.blank_region;
+    float center_x = (blank->left + blank->right) / 2;
+    float center_y = (blank->top + blank->bottom) / 2;
+    AtlasRegion region = *blank;
+    region.left = region.right = center_x;
+    region.top = region.bottom = center_y;
+    canvas_draw_atlas(&region, x, y, width, height, color);
 }
 
-void canvas_draw_image(GXTexObj *texture, float x, float y, float width, float height, uint32_t color) {
+static void canvas_push_quad(GXTexObj *texture, float x, float y, float width, float height, float left, float top,
+                             float right, float bottom, uint32_t color, float pivot_x, float pivot_y, bool transform) {
+    if (canvas.batch_size == CANVAS_BATCH_MAX_QUADS) {
+        // Lists hold one batch
+        if (canvas.recording != NULL) {
+            GX_EndDispList();
+            canvas_record_overflow(canvas.recording);
+        }
+        canvas_flush();
+    }
+
+    // Set quad matrix
+    Mtx matrix;
+    if (transform) {
+        Mtx *t = &canvas.transform_matrix;
+        float px = pivot_x - 0.5f, py = pivot_y - 0.5f;
+        matrix[0][0] = width * (*t)[0][0];
+        matrix[0][1] = width * (*t)[0][1];
+        matrix[0][3] = width * ((*t)[0][3] + px - (*t)[0][0] * px - (*t)[0][1] * py) + x + width / 2;
+        matrix[1][0] = height * (*t)[1][0];
+        matrix[1][1] = height * (*t)[1][1];
+        matrix[1][3] = height * ((*t)[1][3] + py - (*t)[1][0] * px - (*t)[1][1] * py) + y + height / 2;
+    } else {
+        matrix[0][0] = width;
+        matrix[0][1] = 0;
+        matrix[0][3] = x + width / 2;
+        matrix[1][0] = 0;
+        matrix[1][1] = height;
+        matrix[1][3] = y + height / 2;
+    }
+    float corners[8];
+    matrix_transform_points_2d(matrix, &quad_positions[0][0], corners, 4);
+
+    // Write quad into the batch
+    CanvasVertex *vertices = &canvas.batch_vertices[canvas.batch_size * 4];
+    vertices[0] = (CanvasVertex){corners[0], corners[1], color, right, top};
+    vertices[1] = (CanvasVertex){corners[2], corners[3], color, right, bottom};
+    vertices[2] = (CanvasVertex){corners[4], corners[5], color, left, bottom};
+    vertices[3] = (CanvasVertex){corners[6], corners[7], color, left, top};
+
+    // Store quad texture and screen bounds
+    CanvasQuad *quad = &canvas.batch_quads[canvas.batch_size++];
+    quad->texture = texture;
+    quad->min_x = quad->max_x = vertices[0].x;
+    quad->min_y = quad->max_y = vertices[0].y;
+    for (int32_t i = 1; i < 4; i++) {
+        if (vertices[i].x < quad->min_x) quad->min_x = vertices[i].x;
+        if (vertices[i].y < quad->min_y) quad->min_y = vertices[i].y;
+        if (vertices[i].x > quad->max_x) quad->max_x = vertices[i].x;
+        if (vertices[i].y > quad->max_y) quad->max_y = vertices[i].y;
+    }
+}
+
+static void canvas_draw_quad(GXTexObj *texture, float x, float y, float width, float height, float left, float top,
+                             float right, float bottom, uint32_t color, float pivot_x, float pivot_y) {
+    if (canvas.batching) {
+        canvas_push_quad(texture, x, y, width, height, left, top, right, bottom, color, pivot_x, pivot_y, true);
+        return;
+    }
+
     // Load texture
-    GX_LoadTexObj(texture, GX_TEXMAP0);
+    canvas_load_texture(texture);
 
     // Set quad matrix
     // clang-format off
@@ -68,124 +621,519 @@ void canvas_draw_image(GXTexObj *texture, float x, float y, float width, float h
         {0, 0, 1, 0}
     };
     // clang-format on
-    guMtxConcat(matrix, canvas.transform_matrix, matrix);
-    GX_LoadPosMtxImm(matrix, GX_PNMTX0);
+    if (pivot_x != 0.5f || pivot_y != 0.5f) {
+        Mtx pivot_matrix;
+        guMtxTrans(pivot_matrix, pivot_x - 0.5f, pivot_y - 0.5f, 0);
+        matrix_concat(matrix, pivot_matrix, matrix);
+        matrix_concat(matrix, canvas.transform_matrix, matrix);
+        guMtxTrans(pivot_matrix, 0.5f - pivot_x, 0.5f - pivot_y, 0);
+        matrix_concat(matrix, pivot_matrix, matrix);
+    } else {
+        matrix_concat(matrix, canvas.transform_matrix, matrix);
+    }
+    canvas_load_matrix(matrix);
+    canvas.identity_loaded = false;
+
+    // Draw whole texture quads from the unit quad arrays
+    if (canvas.indexed && left == 0 && top == 0 && right == 1 && bottom == 1) {
+        canvas_set_indexed(true);
+        gxstate_begin(GX_QUADS, GX_VTXFMT0, 4);
+        for (uint8_t i = 0; i < 4; i++) {
+            GX_Position1x8(i);
+            GX_Color1u32(color);
+            GX_TexCoord1x8(i);
+        }
+        GX_End();
+        canvas_count_draw(4, FIFO_INDEXED_VERTEX_BYTES);
+        return;
+    }
 
     // Draw quad
-    GX_Begin(GX_QUADS, GX_VTXFMT0, 4);
-    GX_Position2f32(0.5, -0.5);
-    GX_Color1u32(color);
-    GX_TexCoord2f32(1, 0);
-    GX_Position2f32(0.5, 0.5);
-    GX_Color1u32(color);
-    GX_TexCoord2f32(1, 1);
-    GX_Position2f32(-0.5, 0.5);
-    GX_Color1u32(color);
-    GX_TexCoord2f32(0, 1);
-    GX_Position2f32(-0.5, -0.5);
-    GX_Color1u32(color);
-    GX_TexCoord2f32(0, 0);
-    GX_End();
+    canvas_set_indexed(false);
+    canvas_begin_quads(texture, 4);
+    canvas_emit_vertex(0.5, -0.5, color, right, top);
+    canvas_emit_vertex(0.5, 0.5, color, right, bottom);
+    canvas_emit_vertex(-0.5, 0.5, color, left, bottom);
+    canvas_emit_vertex(-0.5, -0.5, color, left, top);
+    canvas_end_quads(4);
 }
 
-static uint32_t get_next_code_point(const char *str, int *index) {
-    uint32_t code_point = 0;
-    unsigned char current_byte;
-
-    // Read the first byte
-    current_byte = str[(*index)++];
-
-    // Determine the number of bytes in the UTF-8 sequence based on the first byte
-    int num_bytes = 0;
-    if (current_byte < 0x80) {
-        num_bytes = 1;
-        code_point = current_byte;
-    } else if ((current_byte & 0xE0) == 0xC0) {
-        num_bytes = 2;
-        code_point = current_byte & 0x1F;
-    } else if ((current_byte & 0xF0) == 0xE0) {
-        num_bytes = 3;
-        code_point = current_byte & 0x0F;
-    } else if ((current_byte & 0xF8) == 0xF0) {
-        num_bytes = 4;
-        code_point = current_byte & 0x07;
-    } else {
-        // Invalid UTF-8 sequence
-        return 0;
+void canvas_draw_image(GXTexObj *texture, float x, float y, float width, float height, uint32_t color) {
+    canvas_draw_quad(texture, x, y, width, height, 0, 0, 1, 1, color, 0.5, 0.5);
+}
+
+void canvas_draw_image_region(GXTexObj *texture, float src_x, float src_y, float src_width, float src_height, float x,
+                              float y, float width, float height, float pivot_x, float pivot_y, uint32_t flags,
+                              uint32_t color) {
+    // Convert source rect to texcoords with the real texture size
+    float texture_width = GX_GetTexObjWidth(texture);
+    float texture_height = GX_GetTexObjHeight(texture);
+    float left = src_x / texture_width;
+    float top = src_y / texture_height;
+    float right = (src_x + src_width) / texture_width;
+    float bottom = (src_y + src_height) / texture_height;
+    if (flags & CANVAS_FLIP_X) {
+        float temp = left;
+        left = right;
+        right = temp;
+    }
+    if (flags & CANVAS_FLIP_Y) {
+        float temp = top;
+        top = bottom;
+        bottom = temp;
+    }
+    canvas_draw_quad(texture, x, y, width, height, left, top, right, bottom, color, pivot_x, pivot_y);
+}
+
+void canvas_draw_atlas(AtlasRegion *region, float x, float y, float width, float height, uint32_t color) {
+    canvas_draw_quad(region->texture, x, y, width, height, region->left, region->top, region->right, region->bottom,
+                     color, 0.5, 0.5);
+}
+
+static GXTexObj *canvas_text_page(uint8_t page) {
+    if (page >= CANVAS_TEXT_PAGE_CACHE) return &glyph_cache.pages[page - CANVAS_TEXT_PAGE_CACHE].texture;
+    if (page == CANVAS_TEXT_PAGE_EMOJI) return &canvas.font_emoji_texture;
+    return canvas.sdf ? &canvas.font_sdf_texture : &canvas.font_texture;
+}
+
+static bool canvas_layout_cached_glyph(uint32_t code_point, uint16_t *advance, CanvasTextGlyph *glyph) {
+    // Queued glyphs only advance
+    GlyphCacheEntry *entry = glyph_cache_find(code_point);
+    if (entry == NULL) return false;
+    text_layout_cached = true;
+    uint16_t pen = *advance;
+    *advance += entry->advance * CANVAS_GLYPH_CACHE_DOWNSCALE;
+    if (entry->state != GLYPH_CACHE_READY || entry->width == 0) return false;
+
+    float page_size = GLYPH_CACHE_PAGE_SIZE;
+    glyph->flags = 0;
+    glyph->page = CANVAS_TEXT_PAGE_CACHE + entry->page;
+    glyph->x = pen + entry->box_x * CANVAS_GLYPH_CACHE_DOWNSCALE;
+    glyph->y = glyph_cache_baseline + entry->box_y * CANVAS_GLYPH_CACHE_DOWNSCALE;
+    glyph->width = entry->width * CANVAS_GLYPH_CACHE_DOWNSCALE;
+    glyph->height = entry->height * CANVAS_GLYPH_CACHE_DOWNSCALE;
+    glyph->left = entry->x / page_size;
+    glyph->top = entry->y / page_size;
+    glyph->right = (entry->x + entry->width) / page_size;
+    glyph->bottom = (entry->y + entry->height) / page_size;
+    return true;
+}
+
+static void canvas_layout_font_glyph(uint8_t glyph_index, int16_t x, CanvasTextGlyph *glyph) {
+    // Glyph rect on its page, distance field boxes include the spread
+    FontGlyph *font_glyph = &font_table.glyphs[glyph_index];
+    glyph->flags = font_glyph->flags;
+    glyph->page = (font_glyph->flags & FONT_GLYPH_COLORED) ? CANVAS_TEXT_PAGE_EMOJI : CANVAS_TEXT_PAGE_MONO;
+    GXTexObj *page = canvas_text_page(glyph->page);
+    float font_width = GX_GetTexObjWidth(page);
+    float font_height = GX_GetTexObjHeight(page);
+    uint16_t page_x = font_glyph->x, page_y = font_glyph->y;
+    uint16_t page_width = font_glyph->width, page_height = font_glyph->height;
+    uint8_t page_scale = 1;
+    int16_t border = 0;
+    if (page == &canvas.font_sdf_texture) {
+        page_x = font_sdf_boxes[glyph_index][0];
+        page_y = font_sdf_boxes[glyph_index][1];
+        page_width = (font_glyph->width + FONT_SDF_SCALE - 1) / FONT_SDF_SCALE + 2 * FONT_SDF_SPREAD;
+        page_height = (font_glyph->height + FONT_SDF_SCALE - 1) / FONT_SDF_SCALE + 2 * FONT_SDF_SPREAD;
+        page_scale = FONT_SDF_SCALE;
+        border = FONT_SDF_SPREAD * FONT_SDF_SCALE;
+    }
+    glyph->x = x - border;
+    glyph->y = font_glyph->ascent - border;
+    glyph->width = page_width * page_scale;
+    glyph->height = page_height * page_scale;
+    glyph->left = page_x / font_width;
+    glyph->top = page_y / font_height;
+    glyph->right = (page_x + page_width) / font_width;
+    glyph->bottom = (page_y + page_height) / font_height;
+}
+
+static bool canvas_layout_code_point(uint32_t code_point, CanvasTextPen *pen, CanvasTextGlyph *glyph) {
+    // Missing glyphs come from the glyph cache
+    uint8_t glyph_index = font_table_find(code_point);
+    if (glyph_index == FONT_GLYPH_NONE) {
+        pen->previous = FONT_GLYPH_NONE;
+        return canvas_layout_cached_glyph(code_point, &pen->advance, glyph);
     }
+    if (pen->previous != FONT_GLYPH_NONE) pen->advance += font_table_find_kerning(pen->previous, glyph_index);
+    pen->previous = glyph_index;
+    FontGlyph *font_glyph = &font_table.glyphs[glyph_index];
+    if (font_glyph->width == 0 || font_glyph->height == 0) {
+        pen->advance += font_glyph->advance;
+        return false;
+    }
+    canvas_layout_font_glyph(glyph_index, pen->advance + font_glyph->bearing, glyph);
+    pen->advance += font_glyph->advance;
+    return true;
+}
 
-    // Read the remaining bytes
-    for (int i = 1; i < num_bytes; ++i) {
-        current_byte = str[(*index)++];
-        if ((current_byte & 0xC0) != 0x80) {
-            // Invalid UTF-8 sequence
-            return 0;
+static bool canvas_layout_next_glyph(const char *text, size_t length, size_t *index, CanvasTextPen *pen,
+                                     CanvasTextGlyph *glyph) {
+    while (*index < length) {
+        if (canvas_layout_code_point(utf8_decode_next(text, length, index), pen, glyph)) return true;
+    }
+    return false;
+}
+
+static CanvasTextLayout *canvas_layout_text(const char *text, size_t length) {
+    if (length == 0 || length > CANVAS_TEXT_MAX_BYTES) return NULL;
+
+    // Drop layouts when the monochrome page changes
+    if (text_layouts_sdf != canvas.sdf) {
+        memset(text_layouts, 0, sizeof(text_layouts));
+        text_layouts_sdf = canvas.sdf;
+    }
+
+    // Find cached layout, the least recently used slot is replaced on a miss
+    uint32_t hash = canvas_hash(text, length, 2166136261);
+    CanvasTextLayout *oldest = &text_layouts[0];
+    text_layouts_tick++;
+    for (uint32_t i = 0; i < CANVAS_TEXT_CACHE_SIZE; i++) {
+        CanvasTextLayout *layout = &text_layouts[i];
+        if (layout->hash == hash && layout->text_length == length && memcmp(layout->text, text, length) == 0) {
+            // Redo layouts from an older glyph cache
+            if (layout->glyph_cache_generation == 0 || layout->glyph_cache_generation == glyph_cache.generation) {
+                layout->last_used = text_layouts_tick;
+                canvas.stats.text_cache_hits++;
+                text_layout_cached = layout->glyph_cache_generation != 0;
+                return layout;
+            }
+            oldest = layout;
+            break;
         }
-        code_point = (code_point << 6) | (current_byte & 0x3F);
+        if (layout->last_used < oldest->last_used) oldest = layout;
     }
+    canvas.stats.text_cache_misses++;
 
-    return code_point;
+    // Lay out text into the replaced slot, up to the glyphs it holds
+    CanvasTextLayout *layout = oldest;
+    layout->glyphs_size = 0;
+    text_layout_cached = false;
+    size_t index = 0;
+    CanvasTextPen pen = {0, FONT_GLYPH_NONE};
+    while (layout->glyphs_size < CANVAS_TEXT_MAX_GLYPHS &&
+           canvas_layout_next_glyph(text, length, &index, &pen, &layout->glyphs[layout->glyphs_size])) {
+        layout->glyphs_size++;
+    }
+    layout->text_index = index;
+    layout->pen = pen;
+
+    // Group glyphs by page
+    for (uint32_t i = 1; i < layout->glyphs_size; i++) {
+        CanvasTextGlyph moved = layout->glyphs[i];
+        uint32_t j = i;
+        for (; j > 0 && layout->glyphs[j - 1].page > moved.page; j--) layout->glyphs[j] = layout->glyphs[j - 1];
+        layout->glyphs[j] = moved;
+    }
+    layout->hash = hash;
+    layout->last_used = text_layouts_tick;
+    layout->glyph_cache_generation = text_layout_cached ? glyph_cache.generation : 0;
+    layout->text_length = length;
+    memcpy(layout->text, text, length);
+    return layout;
+}
+
+static void canvas_draw_glyphs(CanvasTextGlyph *glyphs, uint32_t glyphs_size, float x, float y, float scale,
+                               uint32_t color) {
+    // Recorded text goes into the batch without matrix loads
+    if (canvas.recording != NULL) {
+        for (uint32_t i = 0; i < glyphs_size; i++) {
+            CanvasTextGlyph *glyph = &glyphs[i];
+            uint32_t c = (glyph->flags & FONT_GLYPH_COLORED) ? 0xffffffff : color;
+            if (glyph->page >= CANVAS_TEXT_PAGE_CACHE) glyph_cache_touch(glyph->page - CANVAS_TEXT_PAGE_CACHE);
+            canvas_push_quad(canvas_text_page(glyph->page), x + glyph->x * scale, y + glyph->y * scale,
+                             glyph->width * scale, glyph->height * scale, glyph->left, glyph->top, glyph->right,
+                             glyph->bottom, c, 0.5, 0.5, false);
+        }
+        return;
+    }
+    if (glyphs_size == 0) return;
+
+    // Load text matrix
+    Mtx matrix;
+    guMtxCopy(canvas.transform_matrix, matrix);
+    matrix[0][3] += x;
+    matrix[1][3] += y;
+    canvas_load_matrix(matrix);
+    canvas.identity_loaded = false;
+
+    // Draw characters, one begin per page run
+    uint32_t run_start = 0;
+    while (run_start < glyphs_size) {
+        uint8_t page_index = glyphs[run_start].page;
+        uint32_t run_end = run_start + 1;
+        while (run_end < glyphs_size && glyphs[run_end].page == page_index) run_end++;
+        if (page_index >= CANVAS_TEXT_PAGE_CACHE) glyph_cache_touch(page_index - CANVAS_TEXT_PAGE_CACHE);
+
+        GXTexObj *page = canvas_text_page(page_index);
+        canvas_load_texture(page);
+        canvas_begin_quads(page, (run_end - run_start) * 4);
+        for (uint32_t i = run_start; i < run_end; i++) {
+            CanvasTextGlyph *glyph = &glyphs[i];
+            uint32_t c = (glyph->flags & FONT_GLYPH_COLORED) ? 0xffffffff : color;
+            float left = glyph->x * scale;
+            float top = glyph->y * scale;
+            float right = left + glyph->width * scale;
+            float bottom = top + glyph->height * scale;
+            canvas_emit_vertex(right, top, c, glyph->right, glyph->top);
+            canvas_emit_vertex(right, bottom, c, glyph->right, glyph->bottom);
+            canvas_emit_vertex(left, bottom, c, glyph->left, glyph->bottom);
+            canvas_emit_vertex(left, top, c, glyph->left, glyph->top);
+        }
+        canvas_end_quads((run_end - run_start) * 4);
+        run_start = run_end;
+    }
 }
 
 void canvas_fill_text(char *text, float x, float y, float text_size, uint32_t color) {
-    // Load font texture
-    GX_LoadTexObj(&canvas.font_texture, GX_TEXMAP0);
+    // Draw pending batch first
+    if (canvas.recording == NULL) {
+        canvas_flush();
+        canvas_set_indexed(false);
+    }
 
-    // Draw text characters
+    // Draw cached layout, then the rest of long text in chunks
     float scale = text_size / FONT_RENDER_SIZE;
-    int index = 0;
-    uint32_t code_point;
-    while ((code_point = get_next_code_point(text, &index)) != 0) {
-        if (code_point == ' ') {
-            x += 16 * scale;
-            continue;
-        }
-
-        // Get right char
-        FontChar *font_char = &font[code_point - 33];
-        if (code_point > 127) {
-            for (int32_t i = 0; i < sizeof(font) / sizeof(FontChar); i++) {
-                if (font[i].n == code_point) {
-                    font_char = &font[i];
-                    break;
-                }
-            }
+    size_t length = strlen(text);
+    text_layout_cached = false;
+    size_t index = 0;
+    CanvasTextPen pen = {0, FONT_GLYPH_NONE};
+    CanvasTextLayout *layout = canvas_layout_text(text, length);
+    if (layout != NULL) {
+        canvas_draw_glyphs(layout->glyphs, layout->glyphs_size, x, y, scale, color);
+        index = layout->text_index;
+        pen = layout->pen;
+    }
+    CanvasTextGlyph glyphs[CANVAS_TEXT_MAX_GLYPHS];
+    uint32_t glyphs_size = 0;
+    while (canvas_layout_next_glyph(text, length, &index, &pen, &glyphs[glyphs_size])) {
+        if (++glyphs_size == CANVAS_TEXT_MAX_GLYPHS) {
+            canvas_draw_glyphs(glyphs, glyphs_size, x, y, scale, color);
+            glyphs_size = 0;
         }
+    }
+    canvas_draw_glyphs(glyphs, glyphs_size, x, y, scale, color);
 
-        // Set quad matrix
-        float width = font_char->w * scale;
-        float height = font_char->h * scale;
-        // clang-format off
-        Mtx matrix = {
-            {width, 0, 0, x + width / 2},
-            {0, height, 0, y + font_char->a * scale + height / 2},
-            {0, 0, 1, 0}
-        };
-        // clang-format on
-        GX_LoadPosMtxImm(matrix, GX_PNMTX0);
+    // Record lists again when the glyph cache changes
+    if (canvas.recording != NULL && text_layout_cached) {
+        canvas.recording->glyph_cache_generation = glyph_cache.generation;
+    }
+}
 
-        // Draw character
-        float left = font_char->x / 480.f;
-        float top = font_char->y / 480.f;
-        float right = (font_char->x + font_char->w) / 480.f;
-        float bottom = (font_char->y + font_char->h) / 480.f;
-        uint32_t c = font_char->c ? 0xffffffff : color;
-
-        GX_Begin(GX_QUADS, GX_VTXFMT0, 4);
-        GX_Position2f32(0.5, -0.5);
-        GX_Color1u32(c);
-        GX_TexCoord2f32(right, top);
-        GX_Position2f32(0.5, 0.5);
-        GX_Color1u32(c);
-        GX_TexCoord2f32(right, bottom);
-        GX_Position2f32(-0.5, 0.5);
-        GX_Color1u32(c);
-        GX_TexCoord2f32(left, bottom);
-        GX_Position2f32(-0.5, -0.5);
-        GX_Color1u32(c);
-        GX_TexCoord2f32(left, top);
-        GX_End();
+// Glyphs of formatted text, drawn in chunks
+typedef struct CanvasTextWriter {
+    float x;
+    float y;
+    float scale;
+    uint32_t color;
+    CanvasTextPen pen;
+    uint32_t glyphs_size;
+    CanvasTextGlyph glyphs[CANVAS_TEXT_MAX_GLYPHS];
+} CanvasTextWriter;
+
+static void canvas_write_code_point(void *context, uint32_t code_point) {
+    CanvasTextWriter *writer = context;
+    if (!canvas_layout_code_point(code_point, &writer->pen, &writer->glyphs[writer->glyphs_size])) return;
+    if (++writer->glyphs_size == CANVAS_TEXT_MAX_GLYPHS) {
+        canvas_draw_glyphs(writer->glyphs, writer->glyphs_size, writer->x, writer->y, writer->scale, writer->color);
+        writer->glyphs_size = 0;
+    }
+}
+
+void canvas_fill_textf(float x, float y, float text_size, uint32_t color, const char *format, ...) {
+    if (canvas.recording == NULL) {
+        canvas_flush();
+        canvas_set_indexed(false);
+    }
+
+    // Format straight into glyphs
+    CanvasTextWriter writer;
+    writer.x = x;
+    writer.y = y;
+    writer.scale = text_size / FONT_RENDER_SIZE;
+    writer.color = color;
+    writer.pen = (CanvasTextPen){0, FONT_GLYPH_NONE};
+    writer.glyphs_size = 0;
+    text_layout_cached = false;
+    va_list arguments;
+    va_start(arguments, format);
+    format_write(format, arguments, canvas_write_code_point, &writer);
+    va_end(arguments);
+    canvas_draw_glyphs(writer.glyphs, writer.glyphs_size, x, y, writer.scale, color);
+    if (canvas.recording != NULL && text_layout_cached) {
+        canvas.recording->glyph_cache_generation = glyph_cache.generation;
+    }
+}
+
+void canvas_fill_text_id(uint32_t id, float x, float y, float text_size, uint32_t color) {
+    if (id >= FONT_STRINGS_SIZE) return;
+    if (canvas.recording == NULL) {
+        canvas_flush();
+        canvas_set_indexed(false);
+    }
+
+    // Table strings are already laid out, only their page rects are filled in
+    const FontString *string = &font_strings[id];
+    float scale = text_size / FONT_RENDER_SIZE;
+    CanvasTextGlyph glyphs[CANVAS_TEXT_MAX_GLYPHS];
+    uint32_t glyphs_size = 0;
+    for (uint32_t i = 0; i < string->glyphs_size; i++) {
+        canvas_layout_font_glyph(string->glyphs[i].glyph, string->glyphs[i].x, &glyphs[glyphs_size]);
+        if (++glyphs_size == CANVAS_TEXT_MAX_GLYPHS) {
+            canvas_draw_glyphs(glyphs, glyphs_size, x, y, scale, color);
+            glyphs_size = 0;
+        }
+    }
+    canvas_draw_glyphs(glyphs, glyphs_size, x, y, scale, color);
+}
+
+float canvas_measure_text(char *text, float text_size) {
+    float scale = text_size / FONT_RENDER_SIZE;
+    size_t length = strlen(text);
+    size_t index = 0;
+    CanvasTextPen pen = {0, FONT_GLYPH_NONE};
+    CanvasTextLayout *layout = canvas_layout_text(text, length);
+    if (layout != NULL) {
+        index = layout->text_index;
+        pen = layout->pen;
+    }
+    CanvasTextGlyph glyph;
+    while (canvas_layout_next_glyph(text, length, &index, &pen, &glyph)) {
+    }
+    return pen.advance * scale;
+}
+
+float canvas_measure_text_id(uint32_t id, float text_size) {
+    return id < FONT_STRINGS_SIZE ? font_strings[id].advance * text_size / FONT_RENDER_SIZE : 0;
+}
 
-        x += (font_char->w + 2) * scale;
+uint32_t canvas_hash(const void *data, size_t size, uint32_t hash) {
+    // FNV-1a, pass 2166136261 or a previous hash to chain inputs
+    const uint8_t *bytes = data;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 16777619;
     }
+    return hash;
+}
+
+static uint32_t canvas_list_textures_hash(CanvasList *list) {
+    uint32_t hash = 2166136261;
+    for (uint32_t i = 0; i < list->textures_size; i++) {
+        hash = canvas_hash(&list->textures[i], sizeof(GXTexObj *), hash);
+        hash = canvas_hash(list->textures[i], sizeof(GXTexObj), hash);
+    }
+    return hash;
+}
+
+void canvas_list_init(CanvasList *list, uint32_t capacity) {
+    list->data = memalign(32, capacity);
+    list->capacity = capacity;
+    list->size = 0;
+    list->textures_size = 0;
+    list->glyph_cache_generation = 0;
+    list->overflowed = false;
+    list->offset = false;
+    guMtxIdentity(list->offset_matrix);
+}
+
+bool canvas_record_begin(CanvasList *list, uint32_t key, MtxP offset_matrix) {
+    assert(canvas.recording == NULL && canvas.immediate == NULL);
+    list->offset = offset_matrix != NULL;
+    if (offset_matrix != NULL) {
+        guMtxCopy(offset_matrix, list->offset_matrix);
+    } else {
+        guMtxIdentity(list->offset_matrix);
+    }
+
+    // A list that outgrew its capacity is drawn every time instead
+    if (list->overflowed) {
+        canvas_flush();
+        canvas.immediate = list;
+        canvas.identity_loaded = false;
+        return true;
+    }
+
+    // Keep list when its key and textures match
+    if (list->size != 0 && list->key == key && list->textures_hash == canvas_list_textures_hash(list) &&
+        (list->glyph_cache_generation == 0 || list->glyph_cache_generation == glyph_cache.generation)) {
+        return false;
+    }
+
+    // Draw pending batch before redirecting the fifo
+    canvas_flush();
+    canvas.recording = list;
+    canvas.recording_batching = canvas.batching;
+    canvas.recording_stats = canvas.stats;
+    canvas.batching = true;
+    list->key = key;
+    list->size = 0;
+    list->textures_size = 0;
+    list->glyph_cache_generation = 0;
+
+    DCInvalidateRange(list->data, list->capacity);
+    GX_BeginDispList(list->data, list->capacity);
+
+    // Make the list emit its own vertex state
+    canvas_invalidate_state();
+    canvas.identity_loaded = true;
+    return true;
+}
+
+void canvas_record_end(CanvasList *list) {
+    if (list->overflowed) {
+        canvas_flush();
+        canvas.immediate = NULL;
+        canvas.identity_loaded = false;
+        return;
+    }
+
+    // Draw the batch immediately when the list overflowed
+    uint32_t batch_size = canvas.batch_size;
+    canvas_draw_batch();
+    list->size = GX_EndDispList();
+    if (list->size == 0) {
+        canvas.batch_size = batch_size;
+        canvas_record_overflow(list);
+        canvas_record_end(list);
+        return;
+    }
+    list->textures_hash = canvas_list_textures_hash(list);
+
+    // Restore canvas state, nothing recorded reached the gpu
+    canvas.recording = NULL;
+    canvas.batching = canvas.recording_batching;
+    canvas.stats = canvas.recording_stats;
+    canvas_invalidate_state();
+}
+
+void canvas_call_list(CanvasList *list) {
+    // Overflowed lists were drawn by their recording
+    if (list->size == 0) return;
+    canvas_flush();
+
+    // Load offset matrix
+    if (list->offset) {
+        canvas_load_matrix(list->offset_matrix);
+        canvas.identity_loaded = false;
+    } else if (!canvas.identity_loaded) {
+        Mtx identity_matrix;
+        guMtxIdentity(identity_matrix);
+        canvas_load_matrix(identity_matrix);
+        canvas.identity_loaded = true;
+    }
+
+    // Keep the glyph cache pages the list draws from
+    for (uint32_t i = 0; i < list->textures_size; i++) {
+        int32_t page = canvas_glyph_cache_page(list->textures[i]);
+        if (page != -1) glyph_cache_touch(page);
+    }
+
+    // Replay list and restore the vertex state it changed
+    GX_CallDispList(list->data, list->size);
+    canvas.stats.draw_calls++;
+    canvas.stats.fifo_bytes += FIFO_CALL_LIST_BYTES;
+    bool identity_loaded = canvas.identity_loaded;
+    canvas_invalidate_state();
+    canvas.identity_loaded = identity_loaded;
 }
@@ -0,0 +1,310 @@
+#include "cmpr.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+// Least squares passes over the endpoints in high quality mode
+#define CMPR_REFINE_STEPS 2
+
+// Power iterations for the principal axis of a block
+#define CMPR_AXIS_STEPS 8
+
+// Rounds of single level steps of the end colors in high quality mode
+#define CMPR_SEARCH_STEPS 16
+
+typedef struct CmprBlock {
+    int32_t pixels[16][3];
+    // Bit per texel at or above CMPR_ALPHA_THRESHOLD
+    uint16_t opaque;
+} CmprBlock;
+
+typedef struct CmprResult {
+    uint32_t error;
+    uint16_t colors[2];
+    uint8_t indices[16];
+} CmprResult;
+
+uint32_t cmpr_size(int32_t width, int32_t height) {
+    return ((width + 7) / 8) * ((height + 7) / 8) * 32;
+}
+
+static void cmpr_unpack(uint16_t color, int32_t rgb[3]) {
+    // Bit replication like GX widens the channels
+    rgb[0] = ((color >> 8) & 0xf8) | (color >> 13);
+    rgb[1] = ((color >> 3) & 0xfc) | ((color >> 9) & 0x3);
+    rgb[2] = ((color << 3) & 0xf8) | ((color >> 2) & 0x7);
+}
+
+static uint16_t cmpr_pack(const float rgb[3]) {
+    int32_t levels[3];
+    static const int32_t maxima[3] = {31, 63, 31};
+    for (int32_t c = 0; c < 3; c++) {
+        float value = rgb[c] * maxima[c] / 255.0f + 0.5f;
+        levels[c] = value < 0 ? 0 : value > maxima[c] ? maxima[c] : (int32_t)value;
+    }
+    return (levels[0] << 11) | (levels[1] << 5) | levels[2];
+}
+
+static void cmpr_palette(uint16_t color0, uint16_t color1, int32_t palette[4][3]) {
+    // Four color blocks blend 5/8 and 3/8 on GX rather than the 2/3 and 1/3 of DXT1, three color blocks average
+    cmpr_unpack(color0, palette[0]);
+    cmpr_unpack(color1, palette[1]);
+    for (int32_t c = 0; c < 3; c++) {
+        if (color0 > color1) {
+            palette[2][c] = (palette[0][c] * 5 + palette[1][c] * 3) >> 3;
+            palette[3][c] = (palette[0][c] * 3 + palette[1][c] * 5) >> 3;
+        } else {
+            palette[2][c] = palette[3][c] = (palette[0][c] + palette[1][c]) / 2;
+        }
+    }
+}
+
+static void cmpr_try_packed(const CmprBlock *block, uint16_t a, uint16_t b, bool four_colors, CmprResult *best) {
+    // Four color blocks need the larger color first, equal colors fall back to three colors
+    if (a == b) four_colors = false;
+    CmprResult result;
+    result.colors[0] = four_colors == (a > b) ? a : b;
+    result.colors[1] = four_colors == (a > b) ? b : a;
+    int32_t palette[4][3];
+    cmpr_palette(result.colors[0], result.colors[1], palette);
+
+    result.error = 0;
+    int32_t colors_size = four_colors ? 4 : 3;
+    for (int32_t i = 0; i < 16; i++) {
+        if (!(block->opaque & (1 << i))) {
+            result.indices[i] = 3;
+            continue;
+        }
+        uint32_t best_error = UINT32_MAX;
+        for (int32_t j = 0; j < colors_size; j++) {
+            uint32_t error = 0;
+            for (int32_t c = 0; c < 3; c++) {
+                int32_t delta = block->pixels[i][c] - palette[j][c];
+                error += delta * delta;
+            }
+            if (error < best_error) {
+                best_error = error;
+                result.indices[i] = j;
+            }
+        }
+        result.error += best_error;
+        if (result.error >= best->error) return;
+    }
+    *best = result;
+}
+
+static void cmpr_try(const CmprBlock *block, const float first[3], const float second[3], bool four_colors,
+                     CmprResult *best) {
+    cmpr_try_packed(block, cmpr_pack(first), cmpr_pack(second), four_colors, best);
+}
+
+static void cmpr_search(const CmprBlock *block, bool transparent, CmprResult *best) {
+    // Least squares can't see the rounding to RGB565 or the GX blend weights, so step every channel of either end
+    // color by one level while that lowers the error, in both block modes for opaque blocks
+    static const uint16_t shifts[3] = {11, 5, 0}, maxima[3] = {31, 63, 31};
+    for (int32_t step = 0; step < CMPR_SEARCH_STEPS && best->error > 0; step++) {
+        CmprResult start = *best;
+        for (int32_t end = 0; end < 2; end++) {
+            for (int32_t c = 0; c < 3; c++) {
+                int32_t level = (start.colors[end] >> shifts[c]) & maxima[c];
+                for (int32_t delta = -1; delta <= 1; delta += 2) {
+                    if (level + delta < 0 || level + delta > maxima[c]) continue;
+                    uint16_t colors[2] = {start.colors[0], start.colors[1]};
+                    colors[end] += delta * (1 << shifts[c]);
+                    cmpr_try_packed(block, colors[0], colors[1], !transparent, best);
+                    if (!transparent) cmpr_try_packed(block, colors[0], colors[1], false, best);
+                }
+            }
+        }
+        if (best->error == start.error) break;
+    }
+}
+
+static void cmpr_bounding_box(const CmprBlock *block, float first[3], float second[3]) {
+    // Box corners along the diagonal that follows the sign of the red and blue covariance with green
+    int32_t minima[3] = {255, 255, 255}, maxima[3] = {0, 0, 0}, sums[3] = {0, 0, 0}, count = 0;
+    for (int32_t i = 0; i < 16; i++) {
+        if (!(block->opaque & (1 << i))) continue;
+        for (int32_t c = 0; c < 3; c++) {
+            int32_t value = block->pixels[i][c];
+            if (value < minima[c]) minima[c] = value;
+            if (value > maxima[c]) maxima[c] = value;
+            sums[c] += value;
+        }
+        count++;
+    }
+    int32_t covariances[3] = {0, 0, 0};
+    for (int32_t i = 0; i < 16; i++) {
+        if (!(block->opaque & (1 << i))) continue;
+        int32_t green = block->pixels[i][1] * count - sums[1];
+        covariances[0] += (block->pixels[i][0] * count - sums[0]) * green;
+        covariances[2] += (block->pixels[i][2] * count - sums[2]) * green;
+    }
+
+    // Inset the box so the end colors sit inside the block colors instead of on its extremes
+    for (int32_t c = 0; c < 3; c++) {
+        float inset = (maxima[c] - minima[c]) / 16.0f;
+        first[c] = maxima[c] - inset;
+        second[c] = minima[c] + inset;
+        if (covariances[c] < 0) {
+            float swap = first[c];
+            first[c] = second[c];
+            second[c] = swap;
+        }
+    }
+}
+
+static void cmpr_principal_axis(const CmprBlock *block, float first[3], float second[3]) {
+    float mean[3] = {0, 0, 0};
+    int32_t count = 0;
+    for (int32_t i = 0; i < 16; i++) {
+        if (!(block->opaque & (1 << i))) continue;
+        for (int32_t c = 0; c < 3; c++) mean[c] += block->pixels[i][c];
+        count++;
+    }
+    for (int32_t c = 0; c < 3; c++) mean[c] /= count;
+    float covariance[3][3] = {{0}};
+    for (int32_t i = 0; i < 16; i++) {
+        if (!(block->opaque & (1 << i))) continue;
+        for (int32_t r = 0; r < 3; r++) {
+            for (int32_t c = 0; c < 3; c++) {
+                covariance[r][c] += (block->pixels[i][r] - mean[r]) * (block->pixels[i][c] - mean[c]);
+            }
+        }
+    }
+
+    // Power iteration, normalized by the largest component so it can't overflow
+    float axis[3] = {1, 1, 1};
+    for (int32_t step = 0; step < CMPR_AXIS_STEPS; step++) {
+        float next[3], largest = 0;
+        for (int32_t r = 0; r < 3; r++) {
+            next[r] = covariance[r][0] * axis[0] + covariance[r][1] * axis[1] + covariance[r][2] * axis[2];
+            float magnitude = next[r] < 0 ? -next[r] : next[r];
+            if (magnitude > largest) largest = magnitude;
+        }
+        if (largest == 0) break;
+        for (int32_t c = 0; c < 3; c++) axis[c] = next[c] / largest;
+    }
+
+    // End colors at the extreme projections onto the axis
+    float axis_length = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+    float low = 0, high = 0;
+    for (int32_t i = 0; i < 16; i++) {
+        if (!(block->opaque & (1 << i))) continue;
+        float t = 0;
+        for (int32_t c = 0; c < 3; c++) t += (block->pixels[i][c] - mean[c]) * axis[c];
+        t /= axis_length;
+        if (t < low) low = t;
+        if (t > high) high = t;
+    }
+    for (int32_t c = 0; c < 3; c++) {
+        first[c] = mean[c] + axis[c] * high;
+        second[c] = mean[c] + axis[c] * low;
+    }
+}
+
+static bool cmpr_least_squares(const CmprBlock *block, const CmprResult *result, float first[3], float second[3]) {
+    // Solve for the end colors that best reproduce the texels with their current indices
+    static const float four_weights[4] = {1, 0, 5.0f / 8, 3.0f / 8};
+    static const float three_weights[3] = {1, 0, 0.5f};
+    bool four_colors = result->colors[0] > result->colors[1];
+    float aa = 0, ab = 0, bb = 0, ax[3] = {0, 0, 0}, bx[3] = {0, 0, 0};
+    for (int32_t i = 0; i < 16; i++) {
+        if (!(block->opaque & (1 << i))) continue;
+        float a = four_colors ? four_weights[result->indices[i]] : three_weights[result->indices[i]];
+        float b = 1 - a;
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        for (int32_t c = 0; c < 3; c++) {
+            ax[c] += a * block->pixels[i][c];
+            bx[c] += b * block->pixels[i][c];
+        }
+    }
+    float determinant = aa * bb - ab * ab;
+    if (determinant < 1e-3f) return false;
+    for (int32_t c = 0; c < 3; c++) {
+        first[c] = (bb * ax[c] - ab * bx[c]) / determinant;
+        second[c] = (aa * bx[c] - ab * ax[c]) / determinant;
+    }
+    return true;
+}
+
+static void cmpr_encode_block(const CmprBlock *block, CmprQuality quality, uint8_t *dst) {
+    CmprResult best;
+    best.error = UINT32_MAX;
+    if (block->opaque == 0) {
+        // Fully transparent blocks are all index 3 of a three color block
+        best.colors[0] = best.colors[1] = 0;
+        memset(best.indices, 3, sizeof(best.indices));
+    } else {
+        // Blocks with transparent texels need three colors, opaque ones try four colors and in high quality both
+        bool transparent = block->opaque != 0xffff;
+        float first[3], second[3];
+        if (quality == CMPR_QUALITY_FAST) {
+            cmpr_bounding_box(block, first, second);
+        } else {
+            cmpr_principal_axis(block, first, second);
+        }
+        cmpr_try(block, first, second, !transparent, &best);
+        if (quality == CMPR_QUALITY_HIGH) {
+            if (!transparent) cmpr_try(block, first, second, false, &best);
+            for (int32_t step = 0; step < CMPR_REFINE_STEPS && best.error > 0; step++) {
+                if (!cmpr_least_squares(block, &best, first, second)) break;
+                cmpr_try(block, first, second, best.colors[0] > best.colors[1], &best);
+            }
+            cmpr_search(block, transparent, &best);
+        }
+    }
+
+    dst[0] = best.colors[0] >> 8;
+    dst[1] = best.colors[0] & 0xff;
+    dst[2] = best.colors[1] >> 8;
+    dst[3] = best.colors[1] & 0xff;
+    for (int32_t y = 0; y < 4; y++) {
+        const uint8_t *row = &best.indices[y * 4];
+        dst[4 + y] = (row[0] << 6) | (row[1] << 4) | (row[2] << 2) | row[3];
+    }
+}
+
+void cmpr_encode(const uint8_t *src, int32_t width, int32_t height, CmprQuality quality, uint8_t *dst) {
+    // Each 8x8 tile holds its four blocks in the order top left, top right, bottom left, bottom right
+    for (int32_t tile_y = 0; tile_y < height; tile_y += 8) {
+        for (int32_t tile_x = 0; tile_x < width; tile_x += 8) {
+            for (int32_t i = 0; i < 4; i++, dst += 8) {
+                int32_t block_x = tile_x + (i & 1) * 4, block_y = tile_y + (i >> 1) * 4;
+                CmprBlock block;
+                block.opaque = 0;
+                for (int32_t j = 0; j < 16; j++) {
+                    int32_t x = block_x + (j & 3), y = block_y + (j >> 2);
+                    if (x >= width) x = width - 1;
+                    if (y >= height) y = height - 1;
+                    const uint8_t *pixel = &src[(y * width + x) * 4];
+                    for (int32_t c = 0; c < 3; c++) block.pixels[j][c] = pixel[c];
+                    if (pixel[3] >= CMPR_ALPHA_THRESHOLD) block.opaque |= 1 << j;
+                }
+                cmpr_encode_block(&block, quality, dst);
+            }
+        }
+    }
+}
+
+void cmpr_decode(const uint8_t *src, int32_t width, int32_t height, uint8_t *dst) {
+    for (int32_t tile_y = 0; tile_y < height; tile_y += 8) {
+        for (int32_t tile_x = 0; tile_x < width; tile_x += 8) {
+            for (int32_t i = 0; i < 4; i++, src += 8) {
+                int32_t palette[4][3];
+                uint16_t color0 = (src[0] << 8) | src[1], color1 = (src[2] << 8) | src[3];
+                cmpr_palette(color0, color1, palette);
+                for (int32_t j = 0; j < 16; j++) {
+                    int32_t x = tile_x + (i & 1) * 4 + (j & 3), y = tile_y + (i >> 1) * 4 + (j >> 2);
+                    if (x >= width || y >= height) continue;
+                    uint32_t index = (src[4 + (j >> 2)] >> (6 - (j & 3) * 2)) & 3;
+                    uint8_t *pixel = &dst[(y * width + x) * 4];
+                    for (int32_t c = 0; c < 3; c++) pixel[c] = palette[index][c];
+                    pixel[3] = color0 <= color1 && index == 3 ? 0 : 0xff;
+                }
+            }
+        }
+    }
+}
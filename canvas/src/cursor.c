@@ -1,22 +1,26 @@
 #include "cursor.h"
 
 #include <gccore.h>
+#include <string.h>
 
 #include "canvas.h"
 #include "cursor1_png.h"
 #include "cursor2_png.h"
 #include "cursor3_png.h"
 #include "cursor4_png.h"
-#include "texture.h"
 
 Cursor cursors[4] = {0};
 
 void cursor_init(void) {
-    // Load cursor textures
-    texture_load_png_rgba8(&cursors[0].texture, cursor1_png, cursor1_png_size);
-    texture_load_png_rgba8(&cursors[1].texture, cursor2_png, cursor2_png_size);
-    texture_load_png_rgba8(&cursors[2].texture, cursor3_png, cursor3_png_size);
-    texture_load_png_rgba8(&cursors[3].texture, cursor4_png, cursor4_png_size);
+    // Load cursor images into the canvas atlas, tints only swap their palette entries
+    const uint8_t *images[] = {cursor1_png, cursor2_png, cursor3_png, cursor4_png};
+    const size_t images_size[] = {cursor1_png_size, cursor2_png_size, cursor3_png_size, cursor4_png_size};
+    for (int32_t i = 0; i < 4; i++) {
+        Cursor *cursor = &cursors[i];
+        atlas_add_png(&canvas.atlas, &cursor->image, images[i], images_size[i], CURSOR_COLORS);
+        memcpy(cursor->colors, &cursor->image.page->colors[cursor->image.colors_start * 4],
+               cursor->image.colors_size * 4);
+    }
 
     // Read cursors state
     WPAD_ScanPads();
@@ -47,13 +51,41 @@ void cursor_update(void) {
     }
 }
 
+void cursor_set_tint(int32_t index, uint32_t color) {
+    Cursor *cursor = &cursors[index];
+    // Cursors that didn't fit the atlas have no colors to tint
+    if (cursor->image.page == NULL) return;
+    if (color == 0) {
+        atlas_set_colors(&cursor->image, cursor->colors);
+        return;
+    }
+
+    // Every palette color keeps its brightness and saturation and takes the tint as its hue, grays stay gray
+    uint8_t tinted[CURSOR_COLORS * 4];
+    uint8_t tint[3] = {color >> 24, (color >> 16) & 0xff, (color >> 8) & 0xff};
+    for (uint32_t i = 0; i < cursor->image.colors_size; i++) {
+        const uint8_t *original = &cursor->colors[i * 4];
+        uint32_t max = original[0], min = original[0];
+        for (int32_t c = 1; c < 3; c++) {
+            if (original[c] > max) max = original[c];
+            if (original[c] < min) min = original[c];
+        }
+        uint32_t saturation = max != 0 ? (max - min) * 255 / max : 0;
+        for (int32_t c = 0; c < 3; c++) {
+            tinted[i * 4 + c] = max * (255 * 255 - saturation * (255 - tint[c])) / (255 * 255);
+        }
+        tinted[i * 4 + 3] = original[3];
+    }
+    atlas_set_colors(&cursor->image, tinted);
+}
+
 void cursor_render(void) {
     // Draw enabled cursors on screen
     for (int32_t i = 0; i < 4; i++) {
         Cursor *cursor = &cursors[i];
         if (cursor->enabled) {
             guMtxRotDeg(canvas.transform_matrix, 'z', cursor->angle);
-            canvas_draw_image(&cursor->texture, cursor->x - 96 / 2, cursor->y - 96 / 2, 96, 96, 0xffffffff);
+            canvas_draw_atlas(&cursor->image, cursor->x - 96 / 2, cursor->y - 96 / 2, 96, 96, 0xffffffff);
         }
     }
     guMtxIdentity(canvas.transform_matrix);
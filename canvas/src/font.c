@@ -1,3 +1,742 @@
-#include "font.h"
-
-FontChar font[101] = { { .n = 0x21, .x = 0, .y = 0, .w = 7, .h = 47, .a = 7, .c = false }, { .n = 0x22, .x = 7, .y = 0, .w = 19, .h = 19, .a = 5, .c = false }, { .n = 0x23, .x = 26, .y = 0, .w = 41, .h = 47, .a = 7, .c = false }, { .n = 0x24, .x = 67, .y = 0, .w = 32, .h = 61, .a = 4, .c = false }, { .n = 0x25, .x = 99, .y = 0, .w = 60, .h = 49, .a = 6, .c = false }, { .n = 0x26, .x = 159, .y = 0, .w = 45, .h = 49, .a = 6, .c = false }, { .n = 0x27, .x = 204, .y = 0, .w = 7, .h = 19, .a = 5, .c = false }, { .n = 0x28, .x = 211, .y = 0, .w = 19, .h = 62, .a = 5, .c = false }, { .n = 0x29, .x = 230, .y = 0, .w = 19, .h = 62, .a = 5, .c = false }, { .n = 0x2a, .x = 249, .y = 0, .w = 31, .h = 29, .a = 5, .c = false }, { .n = 0x2b, .x = 280, .y = 0, .w = 40, .h = 39, .a = 14, .c = false }, { .n = 0x2c, .x = 320, .y = 0, .w = 14, .h = 21, .a = 45, .c = false }, { .n = 0x2d, .x = 334, .y = 0, .w = 20, .h = 6, .a = 30, .c = false }, { .n = 0x2e, .x = 354, .y = 0, .w = 8, .h = 9, .a = 45, .c = false }, { .n = 0x2f, .x = 362, .y = 0, .w = 28, .h = 58, .a = 5, .c = false }, { .n = 0x30, .x = 390, .y = 0, .w = 33, .h = 49, .a = 6, .c = false }, { .n = 0x31, .x = 423, .y = 0, .w = 26, .h = 47, .a = 7, .c = false }, { .n = 0x32, .x = 0, .y = 62, .w = 32, .h = 48, .a = 6, .c = false }, { .n = 0x33, .x = 32, .y = 62, .w = 31, .h = 49, .a = 6, .c = false }, { .n = 0x34, .x = 63, .y = 62, .w = 36, .h = 47, .a = 7, .c = false }, { .n = 0x35, .x = 99, .y = 62, .w = 31, .h = 48, .a = 7, .c = false }, { .n = 0x36, .x = 130, .y = 62, .w = 33, .h = 49, .a = 6, .c = false }, { .n = 0x37, .x = 163, .y = 62, .w = 32, .h = 47, .a = 7, .c = false }, { .n = 0x38, .x = 195, .y = 62, .w = 33, .h = 49, .a = 6, .c = false }, { .n = 0x39, .x = 228, .y = 62, .w = 33, .h = 49, .a = 6, .c = false }, { .n = 0x3a, .x = 261, .y = 62, .w = 8, .h = 35, .a = 19, .c = false }, { .n = 0x3b, .x = 269, .y = 62, .w = 14, .h = 47, .a = 19, .c = false }, { .n = 0x3c, .x = 283, .y = 62, .w = 36, .h = 36, .a = 15, .c = false }, { .n = 0x3d, .x = 319, .y = 62, .w = 37, .h = 19, .a = 24, .c = false }, { .n = 0x3e, .x = 356, .y = 62, .w = 36, .h = 36, .a = 15, .c = false }, { .n = 0x3f, .x = 392, .y = 62, .w = 27, .h = 48, .a = 6, .c = false }, { .n = 0x40, .x = 419, .y = 62, .w = 53, .h = 55, .a = 6, .c = false }, { .n = 0x41, .x = 0, .y = 117, .w = 42, .h = 47, .a = 7, .c = false }, { .n = 0x42, .x = 42, .y = 117, .w = 35, .h = 47, .a = 7, .c = false }, { .n = 0x43, .x = 77, .y = 117, .w = 39, .h = 49, .a = 6, .c = false }, { .n = 0x44, .x = 116, .y = 117, .w = 40, .h = 47, .a = 7, .c = false }, { .n = 0x45, .x = 156, .y = 117, .w = 31, .h = 47, .a = 7, .c = false }, { .n = 0x46, .x = 187, .y = 117, .w = 30, .h = 47, .a = 7, .c = false }, { .n = 0x47, .x = 217, .y = 117, .w = 42, .h = 49, .a = 6, .c = false }, { .n = 0x48, .x = 259, .y = 117, .w = 36, .h = 47, .a = 7, .c = false }, { .n = 0x49, .x = 295, .y = 117, .w = 19, .h = 47, .a = 7, .c = false }, { .n = 0x4a, .x = 314, .y = 117, .w = 22, .h = 48, .a = 7, .c = false }, { .n = 0x4b, .x = 336, .y = 117, .w = 38, .h = 47, .a = 7, .c = false }, { .n = 0x4c, .x = 374, .y = 117, .w = 30, .h = 47, .a = 7, .c = false }, { .n = 0x4d, .x = 404, .y = 117, .w = 42, .h = 47, .a = 7, .c = false }, { .n = 0x4e, .x = 0, .y = 166, .w = 36, .h = 47, .a = 7, .c = false }, { .n = 0x4f, .x = 36, .y = 166, .w = 44, .h = 49, .a = 6, .c = false }, { .n = 0x50, .x = 80, .y = 166, .w = 31, .h = 47, .a = 7, .c = false }, { .n = 0x51, .x = 111, .y = 166, .w = 44, .h = 60, .a = 6, .c = false }, { .n = 0x52, .x = 155, .y = 166, .w = 39, .h = 47, .a = 7, .c = false }, { .n = 0x53, .x = 194, .y = 166, .w = 36, .h = 49, .a = 6, .c = false }, { .n = 0x54, .x = 230, .y = 166, .w = 40, .h = 47, .a = 7, .c = false }, { .n = 0x55, .x = 270, .y = 166, .w = 36, .h = 48, .a = 7, .c = false }, { .n = 0x56, .x = 306, .y = 166, .w = 42, .h = 47, .a = 7, .c = false }, { .n = 0x57, .x = 348, .y = 166, .w = 58, .h = 47, .a = 7, .c = false }, { .n = 0x58, .x = 406, .y = 166, .w = 40, .h = 47, .a = 7, .c = false }, { .n = 0x59, .x = 0, .y = 226, .w = 39, .h = 47, .a = 7, .c = false }, { .n = 0x5a, .x = 39, .y = 226, .w = 37, .h = 47, .a = 7, .c = false }, { .n = 0x5b, .x = 76, .y = 226, .w = 17, .h = 61, .a = 5, .c = false }, { .n = 0x5c, .x = 93, .y = 226, .w = 28, .h = 58, .a = 5, .c = false }, { .n = 0x5d, .x = 121, .y = 226, .w = 17, .h = 61, .a = 5, .c = false }, { .n = 0x5e, .x = 138, .y = 226, .w = 41, .h = 26, .a = 7, .c = false }, { .n = 0x5f, .x = 179, .y = 226, .w = 41, .h = 4, .a = 59, .c = false }, { .n = 0x60, .x = 220, .y = 226, .w = 14, .h = 12, .a = 1, .c = false }, { .n = 0x61, .x = 234, .y = 226, .w = 30, .h = 37, .a = 18, .c = false }, { .n = 0x62, .x = 264, .y = 226, .w = 31, .h = 50, .a = 5, .c = false }, { .n = 0x63, .x = 295, .y = 226, .w = 29, .h = 37, .a = 18, .c = false }, { .n = 0x64, .x = 324, .y = 226, .w = 31, .h = 50, .a = 5, .c = false }, { .n = 0x65, .x = 355, .y = 226, .w = 32, .h = 37, .a = 18, .c = false }, { .n = 0x66, .x = 387, .y = 226, .w = 23, .h = 49, .a = 5, .c = false }, { .n = 0x67, .x = 410, .y = 226, .w = 31, .h = 49, .a = 18, .c = false }, { .n = 0x68, .x = 441, .y = 226, .w = 30, .h = 49, .a = 5, .c = false }, { .n = 0x69, .x = 471, .y = 226, .w = 7, .h = 47, .a = 7, .c = false }, { .n = 0x6a, .x = 0, .y = 287, .w = 19, .h = 60, .a = 7, .c = false }, { .n = 0x6b, .x = 19, .y = 287, .w = 32, .h = 49, .a = 5, .c = false }, { .n = 0x6c, .x = 51, .y = 287, .w = 6, .h = 49, .a = 5, .c = false }, { .n = 0x6d, .x = 57, .y = 287, .w = 51, .h = 36, .a = 18, .c = false }, { .n = 0x6e, .x = 108, .y = 287, .w = 30, .h = 36, .a = 18, .c = false }, { .n = 0x6f, .x = 138, .y = 287, .w = 33, .h = 37, .a = 18, .c = false }, { .n = 0x70, .x = 171, .y = 287, .w = 31, .h = 49, .a = 18, .c = false }, { .n = 0x71, .x = 202, .y = 287, .w = 31, .h = 49, .a = 18, .c = false }, { .n = 0x72, .x = 233, .y = 287, .w = 22, .h = 35, .a = 19, .c = false }, { .n = 0x73, .x = 255, .y = 287, .w = 28, .h = 37, .a = 18, .c = false }, { .n = 0x74, .x = 283, .y = 287, .w = 22, .h = 46, .a = 9, .c = false }, { .n = 0x75, .x = 305, .y = 287, .w = 30, .h = 36, .a = 19, .c = false }, { .n = 0x76, .x = 335, .y = 287, .w = 34, .h = 35, .a = 19, .c = false }, { .n = 0x77, .x = 369, .y = 287, .w = 47, .h = 35, .a = 19, .c = false }, { .n = 0x78, .x = 416, .y = 287, .w = 34, .h = 35, .a = 19, .c = false }, { .n = 0x79, .x = 0, .y = 347, .w = 34, .h = 48, .a = 19, .c = false }, { .n = 0x7a, .x = 34, .y = 347, .w = 29, .h = 35, .a = 19, .c = false }, { .n = 0x7b, .x = 63, .y = 347, .w = 30, .h = 61, .a = 5, .c = false }, { .n = 0x7c, .x = 93, .y = 347, .w = 6, .h = 61, .a = 5, .c = false }, { .n = 0x7d, .x = 99, .y = 347, .w = 30, .h = 61, .a = 5, .c = false }, { .n = 0x7e, .x = 129, .y = 347, .w = 41, .h = 17, .a = 25, .c = false }, { .n = 0x1faa8, .x = 170, .y = 347, .w = 64, .h = 64, .a = -1, .c = true }, { .n = 0x26a1, .x = 234, .y = 347, .w = 38, .h = 63, .a = 0, .c = true }, { .n = 0x1f969, .x = 272, .y = 347, .w = 69, .h = 68, .a = -3, .c = true }, { .n = 0x1f4a7, .x = 341, .y = 347, .w = 58, .h = 66, .a = -3, .c = true }, { .n = 0x2601, .x = 399, .y = 347, .w = 67, .h = 45, .a = 8, .c = true }, { .n = 0xfe0f, .x = 466, .y = 347, .w = 0, .h = 0, .a = 53, .c = true }, { .n = 0x1f3e0, .x = 0, .y = 415, .w = 66, .h = 62, .a = 1, .c = true } };
+// Generated by tools/font_atlas.c from data/lato.ttf, fonts/charset.txt and fonts/strings.txt, do not edit
+
+#include "font.h"
+
+FontChar font[FONT_CHARS_SIZE] = {
+    { .n = 0x20, .x = 0, .y = 0, .w = 0, .h = 0, .a = 0, .b = 0, .d = 10, .c = false },
+    { .n = 0x21, .x = 24, .y = 215, .w = 8, .h = 40, .a = 14, .b = 5, .d = 18, .c = false },
+    { .n = 0x22, .x = 223, .y = 240, .w = 14, .h = 15, .a = 14, .b = 4, .d = 21, .c = false },
+    { .n = 0x23, .x = 166, .y = 41, .w = 29, .h = 39, .a = 14, .b = 1, .d = 31, .c = false },
+    { .n = 0x24, .x = 0, .y = 63, .w = 27, .h = 51, .a = 9, .b = 2, .d = 31, .c = false },
+    { .n = 0x25, .x = 69, .y = 111, .w = 39, .h = 40, .a = 14, .b = 1, .d = 42, .c = false },
+    { .n = 0x26, .x = 61, .y = 195, .w = 36, .h = 40, .a = 14, .b = 2, .d = 37, .c = false },
+    { .n = 0x27, .x = 238, .y = 240, .w = 5, .h = 15, .a = 14, .b = 4, .d = 12, .c = false },
+    { .n = 0x28, .x = 0, .y = 167, .w = 11, .h = 50, .a = 11, .b = 3, .d = 16, .c = false },
+    { .n = 0x29, .x = 5, .y = 115, .w = 12, .h = 50, .a = 11, .b = 1, .d = 16, .c = false },
+    { .n = 0x2a, .x = 85, .y = 236, .w = 17, .h = 18, .a = 12, .b = 2, .d = 21, .c = false },
+    { .n = 0x2b, .x = 360, .y = 0, .w = 27, .h = 28, .a = 21, .b = 2, .d = 31, .c = false },
+    { .n = 0x2c, .x = 109, .y = 127, .w = 7, .h = 15, .a = 46, .b = 2, .d = 11, .c = false },
+    { .n = 0x2d, .x = 166, .y = 203, .w = 14, .h = 5, .a = 35, .b = 2, .d = 19, .c = false },
+    { .n = 0x2e, .x = 109, .y = 143, .w = 7, .h = 8, .a = 46, .b = 2, .d = 11, .c = false },
+    { .n = 0x2f, .x = 38, .y = 163, .w = 22, .h = 43, .a = 13, .b = -1, .d = 20, .c = false },
+    { .n = 0x30, .x = 87, .y = 152, .w = 29, .h = 40, .a = 14, .b = 1, .d = 31, .c = false },
+    { .n = 0x31, .x = 171, .y = 0, .w = 24, .h = 39, .a = 14, .b = 5, .d = 31, .c = false },
+    { .n = 0x32, .x = 162, .y = 123, .w = 27, .h = 39, .a = 14, .b = 2, .d = 31, .c = false },
+    { .n = 0x33, .x = 98, .y = 193, .w = 27, .h = 40, .a = 14, .b = 2, .d = 31, .c = false },
+    { .n = 0x34, .x = 169, .y = 81, .w = 29, .h = 39, .a = 14, .b = 1, .d = 31, .c = false },
+    { .n = 0x35, .x = 83, .y = 45, .w = 26, .h = 40, .a = 14, .b = 2, .d = 31, .c = false },
+    { .n = 0x36, .x = 108, .y = 0, .w = 27, .h = 40, .a = 14, .b = 2, .d = 31, .c = false },
+    { .n = 0x37, .x = 166, .y = 163, .w = 27, .h = 39, .a = 14, .b = 2, .d = 31, .c = false },
+    { .n = 0x38, .x = 109, .y = 86, .w = 27, .h = 40, .a = 14, .b = 2, .d = 31, .c = false },
+    { .n = 0x39, .x = 190, .y = 121, .w = 26, .h = 39, .a = 14, .b = 3, .d = 31, .c = false },
+    { .n = 0x3a, .x = 318, .y = 180, .w = 8, .h = 28, .a = 26, .b = 3, .d = 13, .c = false },
+    { .n = 0x3b, .x = 0, .y = 218, .w = 8, .h = 35, .a = 26, .b = 3, .d = 13, .c = false },
+    { .n = 0x3c, .x = 83, .y = 86, .w = 22, .h = 24, .a = 23, .b = 3, .d = 31, .c = false },
+    { .n = 0x3d, .x = 244, .y = 240, .w = 23, .h = 14, .a = 28, .b = 4, .d = 31, .c = false },
+    { .n = 0x3e, .x = 350, .y = 70, .w = 21, .h = 24, .a = 23, .b = 6, .d = 31, .c = false },
+    { .n = 0x3f, .x = 110, .y = 41, .w = 21, .h = 40, .a = 14, .b = 0, .d = 21, .c = false },
+    { .n = 0x40, .x = 67, .y = 0, .w = 40, .h = 44, .a = 16, .b = 2, .d = 44, .c = false },
+    { .n = 0x41, .x = 185, .y = 203, .w = 37, .h = 39, .a = 14, .b = 0, .d = 36, .c = false },
+    { .n = 0x42, .x = 194, .y = 161, .w = 28, .h = 39, .a = 14, .b = 4, .d = 35, .c = false },
+    { .n = 0x43, .x = 132, .y = 41, .w = 33, .h = 40, .a = 14, .b = 2, .d = 37, .c = false },
+    { .n = 0x44, .x = 196, .y = 0, .w = 34, .h = 39, .a = 14, .b = 4, .d = 40, .c = false },
+    { .n = 0x45, .x = 196, .y = 40, .w = 25, .h = 39, .a = 14, .b = 4, .d = 31, .c = false },
+    { .n = 0x46, .x = 199, .y = 80, .w = 25, .h = 39, .a = 14, .b = 4, .d = 30, .c = false },
+    { .n = 0x47, .x = 136, .y = 0, .w = 34, .h = 40, .a = 14, .b = 2, .d = 39, .c = false },
+    { .n = 0x48, .x = 222, .y = 40, .w = 32, .h = 39, .a = 14, .b = 4, .d = 40, .c = false },
+    { .n = 0x49, .x = 12, .y = 216, .w = 6, .h = 39, .a = 14, .b = 5, .d = 16, .c = false },
+    { .n = 0x4a, .x = 117, .y = 127, .w = 19, .h = 40, .a = 14, .b = 1, .d = 24, .c = false },
+    { .n = 0x4b, .x = 231, .y = 0, .w = 31, .h = 39, .a = 14, .b = 5, .d = 36, .c = false },
+    { .n = 0x4c, .x = 217, .y = 120, .w = 23, .h = 39, .a = 14, .b = 4, .d = 27, .c = false },
+    { .n = 0x4d, .x = 225, .y = 80, .w = 41, .h = 39, .a = 14, .b = 4, .d = 49, .c = false },
+    { .n = 0x4e, .x = 255, .y = 40, .w = 32, .h = 39, .a = 14, .b = 4, .d = 40, .c = false },
+    { .n = 0x4f, .x = 126, .y = 168, .w = 39, .h = 40, .a = 14, .b = 2, .d = 43, .c = false },
+    { .n = 0x50, .x = 263, .y = 0, .w = 26, .h = 39, .a = 14, .b = 5, .d = 33, .c = false },
+    { .n = 0x51, .x = 42, .y = 63, .w = 40, .h = 47, .a = 14, .b = 2, .d = 43, .c = false },
+    { .n = 0x52, .x = 223, .y = 160, .w = 29, .h = 39, .a = 14, .b = 5, .d = 34, .c = false },
+    { .n = 0x53, .x = 126, .y = 209, .w = 26, .h = 40, .a = 14, .b = 1, .d = 28, .c = false },
+    { .n = 0x54, .x = 241, .y = 120, .w = 31, .h = 39, .a = 14, .b = 0, .d = 31, .c = false },
+    { .n = 0x55, .x = 153, .y = 209, .w = 31, .h = 40, .a = 14, .b = 4, .d = 39, .c = false },
+    { .n = 0x56, .x = 267, .y = 80, .w = 37, .h = 39, .a = 14, .b = 0, .d = 36, .c = false },
+    { .n = 0x57, .x = 288, .y = 40, .w = 54, .h = 39, .a = 14, .b = 0, .d = 54, .c = false },
+    { .n = 0x58, .x = 290, .y = 0, .w = 34, .h = 39, .a = 14, .b = 0, .d = 34, .c = false },
+    { .n = 0x59, .x = 325, .y = 0, .w = 34, .h = 39, .a = 14, .b = 0, .d = 34, .c = false },
+    { .n = 0x5a, .x = 223, .y = 200, .w = 30, .h = 39, .a = 14, .b = 2, .d = 33, .c = false },
+    { .n = 0x5b, .x = 12, .y = 166, .w = 11, .h = 49, .a = 12, .b = 3, .d = 16, .c = false },
+    { .n = 0x5c, .x = 38, .y = 207, .w = 22, .h = 43, .a = 13, .b = -1, .d = 20, .c = false },
+    { .n = 0x5d, .x = 18, .y = 115, .w = 11, .h = 49, .a = 12, .b = 2, .d = 16, .c = false },
+    { .n = 0x5e, .x = 61, .y = 236, .w = 23, .h = 19, .a = 14, .b = 4, .d = 31, .c = false },
+    { .n = 0x5f, .x = 33, .y = 251, .w = 22, .h = 4, .a = 57, .b = 0, .d = 21, .c = false },
+    { .n = 0x60, .x = 299, .y = 150, .w = 11, .h = 8, .a = 14, .b = 1, .d = 16, .c = false },
+    { .n = 0x61, .x = 299, .y = 120, .w = 22, .h = 29, .a = 25, .b = 2, .d = 27, .c = false },
+    { .n = 0x62, .x = 44, .y = 111, .w = 24, .h = 41, .a = 13, .b = 4, .d = 30, .c = false },
+    { .n = 0x63, .x = 305, .y = 80, .w = 23, .h = 29, .a = 25, .b = 1, .d = 25, .c = false },
+    { .n = 0x64, .x = 61, .y = 153, .w = 25, .h = 41, .a = 13, .b = 1, .d = 30, .c = false },
+    { .n = 0x65, .x = 317, .y = 150, .w = 25, .h = 29, .a = 25, .b = 1, .d = 28, .c = false },
+    { .n = 0x66, .x = 253, .y = 160, .w = 18, .h = 39, .a = 14, .b = 0, .d = 18, .c = false },
+    { .n = 0x67, .x = 263, .y = 200, .w = 26, .h = 38, .a = 25, .b = 1, .d = 27, .c = false },
+    { .n = 0x68, .x = 137, .y = 82, .w = 24, .h = 40, .a = 13, .b = 3, .d = 30, .c = false },
+    { .n = 0x69, .x = 254, .y = 200, .w = 8, .h = 39, .a = 14, .b = 3, .d = 14, .c = false },
+    { .n = 0x6a, .x = 28, .y = 63, .w = 13, .h = 49, .a = 14, .b = -2, .d = 14, .c = false },
+    { .n = 0x6b, .x = 137, .y = 123, .w = 24, .h = 40, .a = 13, .b = 4, .d = 28, .c = false },
+    { .n = 0x6c, .x = 162, .y = 82, .w = 6, .h = 40, .a = 13, .b = 4, .d = 14, .c = false },
+    { .n = 0x6d, .x = 318, .y = 209, .w = 38, .h = 28, .a = 25, .b = 3, .d = 44, .c = false },
+    { .n = 0x6e, .x = 327, .y = 180, .w = 24, .h = 28, .a = 25, .b = 3, .d = 30, .c = false },
+    { .n = 0x6f, .x = 322, .y = 110, .w = 27, .h = 29, .a = 25, .b = 1, .d = 30, .c = false },
+    { .n = 0x70, .x = 272, .y = 160, .w = 25, .h = 38, .a = 25, .b = 3, .d = 29, .c = false },
+    { .n = 0x71, .x = 273, .y = 120, .w = 25, .h = 38, .a = 25, .b = 1, .d = 30, .c = false },
+    { .n = 0x72, .x = 343, .y = 140, .w = 18, .h = 28, .a = 25, .b = 3, .d = 21, .c = false },
+    { .n = 0x73, .x = 329, .y = 80, .w = 20, .h = 29, .a = 25, .b = 1, .d = 23, .c = false },
+    { .n = 0x74, .x = 298, .y = 159, .w = 18, .h = 37, .a = 17, .b = 1, .d = 20, .c = false },
+    { .n = 0x75, .x = 343, .y = 40, .w = 23, .h = 29, .a = 25, .b = 3, .d = 30, .c = false },
+    { .n = 0x76, .x = 352, .y = 169, .w = 27, .h = 28, .a = 25, .b = 0, .d = 27, .c = false },
+    { .n = 0x77, .x = 357, .y = 198, .w = 41, .h = 28, .a = 25, .b = 0, .d = 41, .c = false },
+    { .n = 0x78, .x = 357, .y = 227, .w = 27, .h = 28, .a = 25, .b = 0, .d = 27, .c = false },
+    { .n = 0x79, .x = 290, .y = 199, .w = 27, .h = 38, .a = 25, .b = 0, .d = 27, .c = false },
+    { .n = 0x7a, .x = 385, .y = 227, .w = 22, .h = 28, .a = 25, .b = 1, .d = 25, .c = false },
+    { .n = 0x7b, .x = 24, .y = 165, .w = 13, .h = 49, .a = 12, .b = 1, .d = 16, .c = false },
+    { .n = 0x7c, .x = 0, .y = 115, .w = 4, .h = 51, .a = 12, .b = 6, .d = 16, .c = false },
+    { .n = 0x7d, .x = 30, .y = 113, .w = 13, .h = 49, .a = 12, .b = 2, .d = 16, .c = false },
+    { .n = 0x7e, .x = 360, .y = 29, .w = 25, .h = 10, .a = 32, .b = 3, .d = 31, .c = false },
+    { .n = 0x1f3e0, .x = 0, .y = 0, .w = 66, .h = 62, .a = 1, .b = 0, .d = 68, .c = true }
+};
+
+FontKerning font_kernings[FONT_KERNINGS_SIZE] = {
+    { .l = 0x22, .r = 0x26, .k = -5 },
+    { .l = 0x22, .r = 0x2c, .k = -6 },
+    { .l = 0x22, .r = 0x2d, .k = -5 },
+    { .l = 0x22, .r = 0x2e, .k = -6 },
+    { .l = 0x22, .r = 0x2f, .k = -5 },
+    { .l = 0x22, .r = 0x40, .k = -1 },
+    { .l = 0x22, .r = 0x41, .k = -5 },
+    { .l = 0x22, .r = 0x43, .k = -1 },
+    { .l = 0x22, .r = 0x47, .k = -1 },
+    { .l = 0x22, .r = 0x4f, .k = -1 },
+    { .l = 0x22, .r = 0x51, .k = -1 },
+    { .l = 0x22, .r = 0x56, .k = 1 },
+    { .l = 0x22, .r = 0x57, .k = 1 },
+    { .l = 0x22, .r = 0x59, .k = 1 },
+    { .l = 0x22, .r = 0x5c, .k = 1 },
+    { .l = 0x22, .r = 0x61, .k = -2 },
+    { .l = 0x22, .r = 0x63, .k = -2 },
+    { .l = 0x22, .r = 0x64, .k = -2 },
+    { .l = 0x22, .r = 0x65, .k = -2 },
+    { .l = 0x22, .r = 0x6f, .k = -2 },
+    { .l = 0x22, .r = 0x71, .k = -2 },
+    { .l = 0x27, .r = 0x26, .k = -5 },
+    { .l = 0x27, .r = 0x2c, .k = -6 },
+    { .l = 0x27, .r = 0x2d, .k = -5 },
+    { .l = 0x27, .r = 0x2e, .k = -6 },
+    { .l = 0x27, .r = 0x2f, .k = -5 },
+    { .l = 0x27, .r = 0x40, .k = -1 },
+    { .l = 0x27, .r = 0x41, .k = -5 },
+    { .l = 0x27, .r = 0x43, .k = -1 },
+    { .l = 0x27, .r = 0x47, .k = -1 },
+    { .l = 0x27, .r = 0x4f, .k = -1 },
+    { .l = 0x27, .r = 0x51, .k = -1 },
+    { .l = 0x27, .r = 0x56, .k = 1 },
+    { .l = 0x27, .r = 0x57, .k = 1 },
+    { .l = 0x27, .r = 0x59, .k = 1 },
+    { .l = 0x27, .r = 0x5c, .k = 1 },
+    { .l = 0x27, .r = 0x61, .k = -2 },
+    { .l = 0x27, .r = 0x63, .k = -2 },
+    { .l = 0x27, .r = 0x64, .k = -2 },
+    { .l = 0x27, .r = 0x65, .k = -2 },
+    { .l = 0x27, .r = 0x6f, .k = -2 },
+    { .l = 0x27, .r = 0x71, .k = -2 },
+    { .l = 0x28, .r = 0x40, .k = -1 },
+    { .l = 0x28, .r = 0x43, .k = -1 },
+    { .l = 0x28, .r = 0x47, .k = -1 },
+    { .l = 0x28, .r = 0x4f, .k = -1 },
+    { .l = 0x28, .r = 0x51, .k = -1 },
+    { .l = 0x28, .r = 0x63, .k = -1 },
+    { .l = 0x28, .r = 0x64, .k = -1 },
+    { .l = 0x28, .r = 0x65, .k = -1 },
+    { .l = 0x28, .r = 0x6f, .k = -1 },
+    { .l = 0x28, .r = 0x71, .k = -1 },
+    { .l = 0x2a, .r = 0x26, .k = -5 },
+    { .l = 0x2a, .r = 0x2c, .k = -6 },
+    { .l = 0x2a, .r = 0x2d, .k = -5 },
+    { .l = 0x2a, .r = 0x2e, .k = -6 },
+    { .l = 0x2a, .r = 0x2f, .k = -5 },
+    { .l = 0x2a, .r = 0x40, .k = -1 },
+    { .l = 0x2a, .r = 0x41, .k = -5 },
+    { .l = 0x2a, .r = 0x43, .k = -1 },
+    { .l = 0x2a, .r = 0x47, .k = -1 },
+    { .l = 0x2a, .r = 0x4f, .k = -1 },
+    { .l = 0x2a, .r = 0x51, .k = -1 },
+    { .l = 0x2a, .r = 0x56, .k = 1 },
+    { .l = 0x2a, .r = 0x57, .k = 1 },
+    { .l = 0x2a, .r = 0x59, .k = 1 },
+    { .l = 0x2a, .r = 0x5c, .k = 1 },
+    { .l = 0x2a, .r = 0x61, .k = -2 },
+    { .l = 0x2a, .r = 0x63, .k = -2 },
+    { .l = 0x2a, .r = 0x64, .k = -2 },
+    { .l = 0x2a, .r = 0x65, .k = -2 },
+    { .l = 0x2a, .r = 0x6f, .k = -2 },
+    { .l = 0x2a, .r = 0x71, .k = -2 },
+    { .l = 0x2c, .r = 0x22, .k = -6 },
+    { .l = 0x2c, .r = 0x27, .k = -6 },
+    { .l = 0x2c, .r = 0x2a, .k = -6 },
+    { .l = 0x2c, .r = 0x2d, .k = -4 },
+    { .l = 0x2c, .r = 0x40, .k = -1 },
+    { .l = 0x2c, .r = 0x43, .k = -1 },
+    { .l = 0x2c, .r = 0x47, .k = -1 },
+    { .l = 0x2c, .r = 0x4f, .k = -1 },
+    { .l = 0x2c, .r = 0x51, .k = -1 },
+    { .l = 0x2c, .r = 0x54, .k = -5 },
+    { .l = 0x2c, .r = 0x56, .k = -5 },
+    { .l = 0x2c, .r = 0x57, .k = -3 },
+    { .l = 0x2c, .r = 0x59, .k = -4 },
+    { .l = 0x2c, .r = 0x5c, .k = -5 },
+    { .l = 0x2c, .r = 0x76, .k = -4 },
+    { .l = 0x2c, .r = 0x77, .k = -2 },
+    { .l = 0x2c, .r = 0x79, .k = -4 },
+    { .l = 0x2d, .r = 0x22, .k = -5 },
+    { .l = 0x2d, .r = 0x26, .k = -1 },
+    { .l = 0x2d, .r = 0x27, .k = -5 },
+    { .l = 0x2d, .r = 0x2a, .k = -5 },
+    { .l = 0x2d, .r = 0x2c, .k = -4 },
+    { .l = 0x2d, .r = 0x2e, .k = -4 },
+    { .l = 0x2d, .r = 0x2f, .k = -1 },
+    { .l = 0x2d, .r = 0x41, .k = -1 },
+    { .l = 0x2d, .r = 0x54, .k = -5 },
+    { .l = 0x2d, .r = 0x56, .k = -3 },
+    { .l = 0x2d, .r = 0x57, .k = -1 },
+    { .l = 0x2d, .r = 0x58, .k = -2 },
+    { .l = 0x2d, .r = 0x59, .k = -4 },
+    { .l = 0x2d, .r = 0x5a, .k = -1 },
+    { .l = 0x2d, .r = 0x5c, .k = -3 },
+    { .l = 0x2e, .r = 0x22, .k = -6 },
+    { .l = 0x2e, .r = 0x27, .k = -6 },
+    { .l = 0x2e, .r = 0x2a, .k = -6 },
+    { .l = 0x2e, .r = 0x2d, .k = -4 },
+    { .l = 0x2e, .r = 0x40, .k = -1 },
+    { .l = 0x2e, .r = 0x43, .k = -1 },
+    { .l = 0x2e, .r = 0x47, .k = -1 },
+    { .l = 0x2e, .r = 0x4f, .k = -1 },
+    { .l = 0x2e, .r = 0x51, .k = -1 },
+    { .l = 0x2e, .r = 0x54, .k = -5 },
+    { .l = 0x2e, .r = 0x56, .k = -5 },
+    { .l = 0x2e, .r = 0x57, .k = -3 },
+    { .l = 0x2e, .r = 0x59, .k = -4 },
+    { .l = 0x2e, .r = 0x5c, .k = -5 },
+    { .l = 0x2e, .r = 0x76, .k = -4 },
+    { .l = 0x2e, .r = 0x77, .k = -2 },
+    { .l = 0x2e, .r = 0x79, .k = -4 },
+    { .l = 0x2f, .r = 0x22, .k = 1 },
+    { .l = 0x2f, .r = 0x26, .k = -4 },
+    { .l = 0x2f, .r = 0x27, .k = 1 },
+    { .l = 0x2f, .r = 0x2a, .k = 1 },
+    { .l = 0x2f, .r = 0x2c, .k = -5 },
+    { .l = 0x2f, .r = 0x2d, .k = -3 },
+    { .l = 0x2f, .r = 0x2e, .k = -5 },
+    { .l = 0x2f, .r = 0x2f, .k = -4 },
+    { .l = 0x2f, .r = 0x3a, .k = -2 },
+    { .l = 0x2f, .r = 0x3b, .k = -2 },
+    { .l = 0x2f, .r = 0x3f, .k = 1 },
+    { .l = 0x2f, .r = 0x40, .k = -1 },
+    { .l = 0x2f, .r = 0x41, .k = -4 },
+    { .l = 0x2f, .r = 0x43, .k = -1 },
+    { .l = 0x2f, .r = 0x47, .k = -1 },
+    { .l = 0x2f, .r = 0x4a, .k = -4 },
+    { .l = 0x2f, .r = 0x4f, .k = -1 },
+    { .l = 0x2f, .r = 0x51, .k = -1 },
+    { .l = 0x2f, .r = 0x61, .k = -3 },
+    { .l = 0x2f, .r = 0x63, .k = -3 },
+    { .l = 0x2f, .r = 0x64, .k = -3 },
+    { .l = 0x2f, .r = 0x65, .k = -3 },
+    { .l = 0x2f, .r = 0x66, .k = -1 },
+    { .l = 0x2f, .r = 0x67, .k = -4 },
+    { .l = 0x2f, .r = 0x6d, .k = -2 },
+    { .l = 0x2f, .r = 0x6e, .k = -2 },
+    { .l = 0x2f, .r = 0x6f, .k = -3 },
+    { .l = 0x2f, .r = 0x70, .k = -2 },
+    { .l = 0x2f, .r = 0x71, .k = -3 },
+    { .l = 0x2f, .r = 0x72, .k = -2 },
+    { .l = 0x2f, .r = 0x73, .k = -3 },
+    { .l = 0x2f, .r = 0x74, .k = -1 },
+    { .l = 0x2f, .r = 0x75, .k = -2 },
+    { .l = 0x2f, .r = 0x76, .k = -1 },
+    { .l = 0x2f, .r = 0x78, .k = -1 },
+    { .l = 0x2f, .r = 0x79, .k = -1 },
+    { .l = 0x2f, .r = 0x7a, .k = -2 },
+    { .l = 0x40, .r = 0x22, .k = -1 },
+    { .l = 0x40, .r = 0x26, .k = -1 },
+    { .l = 0x40, .r = 0x27, .k = -1 },
+    { .l = 0x40, .r = 0x29, .k = -1 },
+    { .l = 0x40, .r = 0x2a, .k = -1 },
+    { .l = 0x40, .r = 0x2c, .k = -1 },
+    { .l = 0x40, .r = 0x2e, .k = -1 },
+    { .l = 0x40, .r = 0x2f, .k = -1 },
+    { .l = 0x40, .r = 0x41, .k = -1 },
+    { .l = 0x40, .r = 0x54, .k = -3 },
+    { .l = 0x40, .r = 0x56, .k = -1 },
+    { .l = 0x40, .r = 0x58, .k = -1 },
+    { .l = 0x40, .r = 0x59, .k = -2 },
+    { .l = 0x40, .r = 0x5a, .k = -2 },
+    { .l = 0x40, .r = 0x5c, .k = -1 },
+    { .l = 0x40, .r = 0x5d, .k = -1 },
+    { .l = 0x40, .r = 0x7d, .k = -1 },
+    { .l = 0x41, .r = 0x22, .k = -5 },
+    { .l = 0x41, .r = 0x27, .k = -5 },
+    { .l = 0x41, .r = 0x2a, .k = -5 },
+    { .l = 0x41, .r = 0x2d, .k = -1 },
+    { .l = 0x41, .r = 0x3f, .k = -1 },
+    { .l = 0x41, .r = 0x40, .k = -1 },
+    { .l = 0x41, .r = 0x43, .k = -1 },
+    { .l = 0x41, .r = 0x47, .k = -1 },
+    { .l = 0x41, .r = 0x4a, .k = 1 },
+    { .l = 0x41, .r = 0x4f, .k = -1 },
+    { .l = 0x41, .r = 0x51, .k = -1 },
+    { .l = 0x41, .r = 0x54, .k = -4 },
+    { .l = 0x41, .r = 0x55, .k = -1 },
+    { .l = 0x41, .r = 0x56, .k = -4 },
+    { .l = 0x41, .r = 0x57, .k = -2 },
+    { .l = 0x41, .r = 0x59, .k = -4 },
+    { .l = 0x41, .r = 0x5c, .k = -4 },
+    { .l = 0x41, .r = 0x76, .k = -2 },
+    { .l = 0x41, .r = 0x79, .k = -2 },
+    { .l = 0x43, .r = 0x2d, .k = -4 },
+    { .l = 0x44, .r = 0x22, .k = -1 },
+    { .l = 0x44, .r = 0x26, .k = -1 },
+    { .l = 0x44, .r = 0x27, .k = -1 },
+    { .l = 0x44, .r = 0x29, .k = -1 },
+    { .l = 0x44, .r = 0x2a, .k = -1 },
+    { .l = 0x44, .r = 0x2c, .k = -1 },
+    { .l = 0x44, .r = 0x2e, .k = -1 },
+    { .l = 0x44, .r = 0x2f, .k = -1 },
+    { .l = 0x44, .r = 0x41, .k = -1 },
+    { .l = 0x44, .r = 0x54, .k = -3 },
+    { .l = 0x44, .r = 0x56, .k = -1 },
+    { .l = 0x44, .r = 0x58, .k = -1 },
+    { .l = 0x44, .r = 0x59, .k = -2 },
+    { .l = 0x44, .r = 0x5a, .k = -2 },
+    { .l = 0x44, .r = 0x5c, .k = -1 },
+    { .l = 0x44, .r = 0x5d, .k = -1 },
+    { .l = 0x44, .r = 0x7d, .k = -1 },
+    { .l = 0x46, .r = 0x26, .k = -4 },
+    { .l = 0x46, .r = 0x2c, .k = -5 },
+    { .l = 0x46, .r = 0x2e, .k = -5 },
+    { .l = 0x46, .r = 0x2f, .k = -4 },
+    { .l = 0x46, .r = 0x3a, .k = -2 },
+    { .l = 0x46, .r = 0x3b, .k = -2 },
+    { .l = 0x46, .r = 0x3f, .k = 1 },
+    { .l = 0x46, .r = 0x41, .k = -4 },
+    { .l = 0x46, .r = 0x4a, .k = -5 },
+    { .l = 0x46, .r = 0x63, .k = -2 },
+    { .l = 0x46, .r = 0x64, .k = -2 },
+    { .l = 0x46, .r = 0x65, .k = -2 },
+    { .l = 0x46, .r = 0x6d, .k = -2 },
+    { .l = 0x46, .r = 0x6e, .k = -2 },
+    { .l = 0x46, .r = 0x6f, .k = -2 },
+    { .l = 0x46, .r = 0x70, .k = -2 },
+    { .l = 0x46, .r = 0x71, .k = -2 },
+    { .l = 0x46, .r = 0x72, .k = -2 },
+    { .l = 0x46, .r = 0x75, .k = -2 },
+    { .l = 0x4a, .r = 0x26, .k = -1 },
+    { .l = 0x4a, .r = 0x2c, .k = -1 },
+    { .l = 0x4a, .r = 0x2e, .k = -1 },
+    { .l = 0x4a, .r = 0x2f, .k = -1 },
+    { .l = 0x4a, .r = 0x41, .k = -1 },
+    { .l = 0x4b, .r = 0x2d, .k = -2 },
+    { .l = 0x4b, .r = 0x40, .k = -1 },
+    { .l = 0x4b, .r = 0x43, .k = -1 },
+    { .l = 0x4b, .r = 0x47, .k = -1 },
+    { .l = 0x4b, .r = 0x4f, .k = -1 },
+    { .l = 0x4b, .r = 0x51, .k = -1 },
+    { .l = 0x4b, .r = 0x63, .k = -1 },
+    { .l = 0x4b, .r = 0x64, .k = -1 },
+    { .l = 0x4b, .r = 0x65, .k = -1 },
+    { .l = 0x4b, .r = 0x66, .k = -1 },
+    { .l = 0x4b, .r = 0x6f, .k = -1 },
+    { .l = 0x4b, .r = 0x71, .k = -1 },
+    { .l = 0x4b, .r = 0x74, .k = -2 },
+    { .l = 0x4b, .r = 0x76, .k = -2 },
+    { .l = 0x4b, .r = 0x77, .k = -1 },
+    { .l = 0x4b, .r = 0x79, .k = -2 },
+    { .l = 0x4c, .r = 0x22, .k = -8 },
+    { .l = 0x4c, .r = 0x27, .k = -8 },
+    { .l = 0x4c, .r = 0x2a, .k = -8 },
+    { .l = 0x4c, .r = 0x2c, .k = 1 },
+    { .l = 0x4c, .r = 0x2d, .k = -5 },
+    { .l = 0x4c, .r = 0x2e, .k = 1 },
+    { .l = 0x4c, .r = 0x3f, .k = -1 },
+    { .l = 0x4c, .r = 0x40, .k = -2 },
+    { .l = 0x4c, .r = 0x43, .k = -2 },
+    { .l = 0x4c, .r = 0x47, .k = -2 },
+    { .l = 0x4c, .r = 0x4f, .k = -2 },
+    { .l = 0x4c, .r = 0x51, .k = -2 },
+    { .l = 0x4c, .r = 0x54, .k = -5 },
+    { .l = 0x4c, .r = 0x56, .k = -5 },
+    { .l = 0x4c, .r = 0x57, .k = -4 },
+    { .l = 0x4c, .r = 0x59, .k = -6 },
+    { .l = 0x4c, .r = 0x5c, .k = -5 },
+    { .l = 0x4c, .r = 0x63, .k = -1 },
+    { .l = 0x4c, .r = 0x64, .k = -1 },
+    { .l = 0x4c, .r = 0x65, .k = -1 },
+    { .l = 0x4c, .r = 0x6f, .k = -1 },
+    { .l = 0x4c, .r = 0x71, .k = -1 },
+    { .l = 0x4c, .r = 0x76, .k = -3 },
+    { .l = 0x4c, .r = 0x77, .k = -2 },
+    { .l = 0x4c, .r = 0x79, .k = -3 },
+    { .l = 0x4f, .r = 0x22, .k = -1 },
+    { .l = 0x4f, .r = 0x26, .k = -1 },
+    { .l = 0x4f, .r = 0x27, .k = -1 },
+    { .l = 0x4f, .r = 0x29, .k = -1 },
+    { .l = 0x4f, .r = 0x2a, .k = -1 },
+    { .l = 0x4f, .r = 0x2c, .k = -1 },
+    { .l = 0x4f, .r = 0x2e, .k = -1 },
+    { .l = 0x4f, .r = 0x2f, .k = -1 },
+    { .l = 0x4f, .r = 0x41, .k = -1 },
+    { .l = 0x4f, .r = 0x54, .k = -3 },
+    { .l = 0x4f, .r = 0x56, .k = -1 },
+    { .l = 0x4f, .r = 0x58, .k = -1 },
+    { .l = 0x4f, .r = 0x59, .k = -2 },
+    { .l = 0x4f, .r = 0x5a, .k = -2 },
+    { .l = 0x4f, .r = 0x5c, .k = -1 },
+    { .l = 0x4f, .r = 0x5d, .k = -1 },
+    { .l = 0x4f, .r = 0x7d, .k = -1 },
+    { .l = 0x50, .r = 0x26, .k = -4 },
+    { .l = 0x50, .r = 0x2c, .k = -7 },
+    { .l = 0x50, .r = 0x2e, .k = -7 },
+    { .l = 0x50, .r = 0x2f, .k = -4 },
+    { .l = 0x50, .r = 0x41, .k = -4 },
+    { .l = 0x50, .r = 0x4a, .k = -5 },
+    { .l = 0x50, .r = 0x61, .k = -1 },
+    { .l = 0x50, .r = 0x63, .k = -1 },
+    { .l = 0x50, .r = 0x64, .k = -1 },
+    { .l = 0x50, .r = 0x65, .k = -1 },
+    { .l = 0x50, .r = 0x6f, .k = -1 },
+    { .l = 0x50, .r = 0x71, .k = -1 },
+    { .l = 0x51, .r = 0x22, .k = -1 },
+    { .l = 0x51, .r = 0x26, .k = -1 },
+    { .l = 0x51, .r = 0x27, .k = -1 },
+    { .l = 0x51, .r = 0x29, .k = -1 },
+    { .l = 0x51, .r = 0x2a, .k = -1 },
+    { .l = 0x51, .r = 0x2c, .k = -1 },
+    { .l = 0x51, .r = 0x2e, .k = -1 },
+    { .l = 0x51, .r = 0x2f, .k = -1 },
+    { .l = 0x51, .r = 0x41, .k = -1 },
+    { .l = 0x51, .r = 0x54, .k = -3 },
+    { .l = 0x51, .r = 0x56, .k = -1 },
+    { .l = 0x51, .r = 0x58, .k = -1 },
+    { .l = 0x51, .r = 0x59, .k = -2 },
+    { .l = 0x51, .r = 0x5a, .k = -2 },
+    { .l = 0x51, .r = 0x5c, .k = -1 },
+    { .l = 0x51, .r = 0x5d, .k = -1 },
+    { .l = 0x51, .r = 0x7d, .k = -1 },
+    { .l = 0x52, .r = 0x40, .k = -1 },
+    { .l = 0x52, .r = 0x43, .k = -1 },
+    { .l = 0x52, .r = 0x47, .k = -1 },
+    { .l = 0x52, .r = 0x4f, .k = -1 },
+    { .l = 0x52, .r = 0x51, .k = -1 },
+    { .l = 0x52, .r = 0x54, .k = -1 },
+    { .l = 0x52, .r = 0x55, .k = -1 },
+    { .l = 0x54, .r = 0x26, .k = -4 },
+    { .l = 0x54, .r = 0x2c, .k = -5 },
+    { .l = 0x54, .r = 0x2d, .k = -5 },
+    { .l = 0x54, .r = 0x2e, .k = -5 },
+    { .l = 0x54, .r = 0x2f, .k = -4 },
+    { .l = 0x54, .r = 0x3a, .k = -4 },
+    { .l = 0x54, .r = 0x3b, .k = -4 },
+    { .l = 0x54, .r = 0x40, .k = -3 },
+    { .l = 0x54, .r = 0x41, .k = -4 },
+    { .l = 0x54, .r = 0x43, .k = -3 },
+    { .l = 0x54, .r = 0x47, .k = -3 },
+    { .l = 0x54, .r = 0x4a, .k = -5 },
+    { .l = 0x54, .r = 0x4f, .k = -3 },
+    { .l = 0x54, .r = 0x51, .k = -3 },
+    { .l = 0x54, .r = 0x61, .k = -7 },
+    { .l = 0x54, .r = 0x63, .k = -6 },
+    { .l = 0x54, .r = 0x64, .k = -6 },
+    { .l = 0x54, .r = 0x65, .k = -6 },
+    { .l = 0x54, .r = 0x67, .k = -5 },
+    { .l = 0x54, .r = 0x6d, .k = -4 },
+    { .l = 0x54, .r = 0x6e, .k = -4 },
+    { .l = 0x54, .r = 0x6f, .k = -6 },
+    { .l = 0x54, .r = 0x70, .k = -4 },
+    { .l = 0x54, .r = 0x71, .k = -6 },
+    { .l = 0x54, .r = 0x72, .k = -4 },
+    { .l = 0x54, .r = 0x73, .k = -4 },
+    { .l = 0x54, .r = 0x75, .k = -4 },
+    { .l = 0x54, .r = 0x76, .k = -5 },
+    { .l = 0x54, .r = 0x77, .k = -4 },
+    { .l = 0x54, .r = 0x78, .k = -4 },
+    { .l = 0x54, .r = 0x79, .k = -5 },
+    { .l = 0x54, .r = 0x7a, .k = -3 },
+    { .l = 0x55, .r = 0x26, .k = -1 },
+    { .l = 0x55, .r = 0x2c, .k = -1 },
+    { .l = 0x55, .r = 0x2e, .k = -1 },
+    { .l = 0x55, .r = 0x2f, .k = -1 },
+    { .l = 0x55, .r = 0x41, .k = -1 },
+    { .l = 0x56, .r = 0x22, .k = 1 },
+    { .l = 0x56, .r = 0x26, .k = -4 },
+    { .l = 0x56, .r = 0x27, .k = 1 },
+    { .l = 0x56, .r = 0x2a, .k = 1 },
+    { .l = 0x56, .r = 0x2c, .k = -5 },
+    { .l = 0x56, .r = 0x2d, .k = -3 },
+    { .l = 0x56, .r = 0x2e, .k = -5 },
+    { .l = 0x56, .r = 0x2f, .k = -4 },
+    { .l = 0x56, .r = 0x3a, .k = -2 },
+    { .l = 0x56, .r = 0x3b, .k = -2 },
+    { .l = 0x56, .r = 0x3f, .k = 1 },
+    { .l = 0x56, .r = 0x40, .k = -1 },
+    { .l = 0x56, .r = 0x41, .k = -4 },
+    { .l = 0x56, .r = 0x43, .k = -1 },
+    { .l = 0x56, .r = 0x47, .k = -1 },
+    { .l = 0x56, .r = 0x4a, .k = -4 },
+    { .l = 0x56, .r = 0x4f, .k = -1 },
+    { .l = 0x56, .r = 0x51, .k = -1 },
+    { .l = 0x56, .r = 0x61, .k = -3 },
+    { .l = 0x56, .r = 0x63, .k = -3 },
+    { .l = 0x56, .r = 0x64, .k = -3 },
+    { .l = 0x56, .r = 0x65, .k = -3 },
+    { .l = 0x56, .r = 0x66, .k = -1 },
+    { .l = 0x56, .r = 0x67, .k = -4 },
+    { .l = 0x56, .r = 0x6d, .k = -2 },
+    { .l = 0x56, .r = 0x6e, .k = -2 },
+    { .l = 0x56, .r = 0x6f, .k = -3 },
+    { .l = 0x56, .r = 0x70, .k = -2 },
+    { .l = 0x56, .r = 0x71, .k = -3 },
+    { .l = 0x56, .r = 0x72, .k = -2 },
+    { .l = 0x56, .r = 0x73, .k = -3 },
+    { .l = 0x56, .r = 0x74, .k = -1 },
+    { .l = 0x56, .r = 0x75, .k = -2 },
+    { .l = 0x56, .r = 0x76, .k = -1 },
+    { .l = 0x56, .r = 0x78, .k = -1 },
+    { .l = 0x56, .r = 0x79, .k = -1 },
+    { .l = 0x56, .r = 0x7a, .k = -2 },
+    { .l = 0x57, .r = 0x22, .k = 1 },
+    { .l = 0x57, .r = 0x26, .k = -3 },
+    { .l = 0x57, .r = 0x27, .k = 1 },
+    { .l = 0x57, .r = 0x2a, .k = 1 },
+    { .l = 0x57, .r = 0x2c, .k = -3 },
+    { .l = 0x57, .r = 0x2d, .k = -1 },
+    { .l = 0x57, .r = 0x2e, .k = -3 },
+    { .l = 0x57, .r = 0x2f, .k = -3 },
+    { .l = 0x57, .r = 0x3f, .k = 1 },
+    { .l = 0x57, .r = 0x41, .k = -3 },
+    { .l = 0x57, .r = 0x4a, .k = -3 },
+    { .l = 0x57, .r = 0x61, .k = -2 },
+    { .l = 0x57, .r = 0x63, .k = -1 },
+    { .l = 0x57, .r = 0x64, .k = -1 },
+    { .l = 0x57, .r = 0x65, .k = -1 },
+    { .l = 0x57, .r = 0x67, .k = -3 },
+    { .l = 0x57, .r = 0x6f, .k = -1 },
+    { .l = 0x57, .r = 0x71, .k = -1 },
+    { .l = 0x57, .r = 0x73, .k = -1 },
+    { .l = 0x58, .r = 0x2d, .k = -2 },
+    { .l = 0x58, .r = 0x40, .k = -1 },
+    { .l = 0x58, .r = 0x43, .k = -1 },
+    { .l = 0x58, .r = 0x47, .k = -1 },
+    { .l = 0x58, .r = 0x4f, .k = -1 },
+    { .l = 0x58, .r = 0x51, .k = -1 },
+    { .l = 0x58, .r = 0x63, .k = -1 },
+    { .l = 0x58, .r = 0x64, .k = -1 },
+    { .l = 0x58, .r = 0x65, .k = -1 },
+    { .l = 0x58, .r = 0x66, .k = -1 },
+    { .l = 0x58, .r = 0x6f, .k = -1 },
+    { .l = 0x58, .r = 0x71, .k = -1 },
+    { .l = 0x58, .r = 0x74, .k = -2 },
+    { .l = 0x58, .r = 0x76, .k = -2 },
+    { .l = 0x58, .r = 0x77, .k = -1 },
+    { .l = 0x58, .r = 0x79, .k = -2 },
+    { .l = 0x59, .r = 0x22, .k = 1 },
+    { .l = 0x59, .r = 0x26, .k = -4 },
+    { .l = 0x59, .r = 0x27, .k = 1 },
+    { .l = 0x59, .r = 0x2a, .k = 1 },
+    { .l = 0x59, .r = 0x2c, .k = -4 },
+    { .l = 0x59, .r = 0x2d, .k = -4 },
+    { .l = 0x59, .r = 0x2e, .k = -4 },
+    { .l = 0x59, .r = 0x2f, .k = -4 },
+    { .l = 0x59, .r = 0x3a, .k = -3 },
+    { .l = 0x59, .r = 0x3b, .k = -3 },
+    { .l = 0x59, .r = 0x3f, .k = 1 },
+    { .l = 0x59, .r = 0x40, .k = -2 },
+    { .l = 0x59, .r = 0x41, .k = -4 },
+    { .l = 0x59, .r = 0x43, .k = -2 },
+    { .l = 0x59, .r = 0x47, .k = -2 },
+    { .l = 0x59, .r = 0x4a, .k = -5 },
+    { .l = 0x59, .r = 0x4f, .k = -2 },
+    { .l = 0x59, .r = 0x51, .k = -2 },
+    { .l = 0x59, .r = 0x61, .k = -3 },
+    { .l = 0x59, .r = 0x63, .k = -4 },
+    { .l = 0x59, .r = 0x64, .k = -4 },
+    { .l = 0x59, .r = 0x65, .k = -4 },
+    { .l = 0x59, .r = 0x67, .k = -5 },
+    { .l = 0x59, .r = 0x6d, .k = -3 },
+    { .l = 0x59, .r = 0x6e, .k = -3 },
+    { .l = 0x59, .r = 0x6f, .k = -4 },
+    { .l = 0x59, .r = 0x70, .k = -3 },
+    { .l = 0x59, .r = 0x71, .k = -4 },
+    { .l = 0x59, .r = 0x72, .k = -3 },
+    { .l = 0x59, .r = 0x73, .k = -3 },
+    { .l = 0x59, .r = 0x75, .k = -3 },
+    { .l = 0x59, .r = 0x76, .k = -3 },
+    { .l = 0x59, .r = 0x77, .k = -2 },
+    { .l = 0x59, .r = 0x78, .k = -4 },
+    { .l = 0x59, .r = 0x79, .k = -3 },
+    { .l = 0x5a, .r = 0x2d, .k = -2 },
+    { .l = 0x5a, .r = 0x3f, .k = 1 },
+    { .l = 0x5a, .r = 0x40, .k = -2 },
+    { .l = 0x5a, .r = 0x43, .k = -2 },
+    { .l = 0x5a, .r = 0x47, .k = -2 },
+    { .l = 0x5a, .r = 0x4f, .k = -2 },
+    { .l = 0x5a, .r = 0x51, .k = -2 },
+    { .l = 0x5a, .r = 0x63, .k = -1 },
+    { .l = 0x5a, .r = 0x64, .k = -1 },
+    { .l = 0x5a, .r = 0x65, .k = -1 },
+    { .l = 0x5a, .r = 0x6f, .k = -1 },
+    { .l = 0x5a, .r = 0x71, .k = -1 },
+    { .l = 0x5a, .r = 0x73, .k = -1 },
+    { .l = 0x5a, .r = 0x76, .k = -1 },
+    { .l = 0x5a, .r = 0x79, .k = -1 },
+    { .l = 0x5b, .r = 0x40, .k = -1 },
+    { .l = 0x5b, .r = 0x43, .k = -1 },
+    { .l = 0x5b, .r = 0x47, .k = -1 },
+    { .l = 0x5b, .r = 0x4f, .k = -1 },
+    { .l = 0x5b, .r = 0x51, .k = -1 },
+    { .l = 0x5b, .r = 0x63, .k = -1 },
+    { .l = 0x5b, .r = 0x64, .k = -1 },
+    { .l = 0x5b, .r = 0x65, .k = -1 },
+    { .l = 0x5b, .r = 0x6f, .k = -1 },
+    { .l = 0x5b, .r = 0x71, .k = -1 },
+    { .l = 0x5c, .r = 0x22, .k = -5 },
+    { .l = 0x5c, .r = 0x27, .k = -5 },
+    { .l = 0x5c, .r = 0x2a, .k = -5 },
+    { .l = 0x5c, .r = 0x2d, .k = -1 },
+    { .l = 0x5c, .r = 0x3f, .k = -1 },
+    { .l = 0x5c, .r = 0x40, .k = -1 },
+    { .l = 0x5c, .r = 0x43, .k = -1 },
+    { .l = 0x5c, .r = 0x47, .k = -1 },
+    { .l = 0x5c, .r = 0x4a, .k = 1 },
+    { .l = 0x5c, .r = 0x4f, .k = -1 },
+    { .l = 0x5c, .r = 0x51, .k = -1 },
+    { .l = 0x5c, .r = 0x54, .k = -4 },
+    { .l = 0x5c, .r = 0x55, .k = -1 },
+    { .l = 0x5c, .r = 0x56, .k = -4 },
+    { .l = 0x5c, .r = 0x57, .k = -2 },
+    { .l = 0x5c, .r = 0x59, .k = -4 },
+    { .l = 0x5c, .r = 0x5c, .k = -4 },
+    { .l = 0x5c, .r = 0x76, .k = -2 },
+    { .l = 0x5c, .r = 0x79, .k = -2 },
+    { .l = 0x61, .r = 0x22, .k = -2 },
+    { .l = 0x61, .r = 0x27, .k = -2 },
+    { .l = 0x61, .r = 0x2a, .k = -2 },
+    { .l = 0x61, .r = 0x76, .k = -1 },
+    { .l = 0x61, .r = 0x79, .k = -1 },
+    { .l = 0x62, .r = 0x22, .k = -2 },
+    { .l = 0x62, .r = 0x27, .k = -2 },
+    { .l = 0x62, .r = 0x29, .k = -1 },
+    { .l = 0x62, .r = 0x2a, .k = -2 },
+    { .l = 0x62, .r = 0x56, .k = -3 },
+    { .l = 0x62, .r = 0x57, .k = -1 },
+    { .l = 0x62, .r = 0x5c, .k = -3 },
+    { .l = 0x62, .r = 0x5d, .k = -1 },
+    { .l = 0x62, .r = 0x76, .k = -1 },
+    { .l = 0x62, .r = 0x78, .k = -2 },
+    { .l = 0x62, .r = 0x79, .k = -1 },
+    { .l = 0x62, .r = 0x7d, .k = -1 },
+    { .l = 0x65, .r = 0x22, .k = -2 },
+    { .l = 0x65, .r = 0x27, .k = -2 },
+    { .l = 0x65, .r = 0x29, .k = -1 },
+    { .l = 0x65, .r = 0x2a, .k = -2 },
+    { .l = 0x65, .r = 0x56, .k = -3 },
+    { .l = 0x65, .r = 0x57, .k = -1 },
+    { .l = 0x65, .r = 0x5c, .k = -3 },
+    { .l = 0x65, .r = 0x5d, .k = -1 },
+    { .l = 0x65, .r = 0x76, .k = -1 },
+    { .l = 0x65, .r = 0x78, .k = -2 },
+    { .l = 0x65, .r = 0x79, .k = -1 },
+    { .l = 0x65, .r = 0x7d, .k = -1 },
+    { .l = 0x66, .r = 0x22, .k = 2 },
+    { .l = 0x66, .r = 0x27, .k = 2 },
+    { .l = 0x66, .r = 0x2a, .k = 2 },
+    { .l = 0x66, .r = 0x2c, .k = -3 },
+    { .l = 0x66, .r = 0x2e, .k = -3 },
+    { .l = 0x68, .r = 0x22, .k = -2 },
+    { .l = 0x68, .r = 0x27, .k = -2 },
+    { .l = 0x68, .r = 0x2a, .k = -2 },
+    { .l = 0x68, .r = 0x76, .k = -1 },
+    { .l = 0x68, .r = 0x79, .k = -1 },
+    { .l = 0x6b, .r = 0x63, .k = -2 },
+    { .l = 0x6b, .r = 0x64, .k = -2 },
+    { .l = 0x6b, .r = 0x65, .k = -2 },
+    { .l = 0x6b, .r = 0x6f, .k = -2 },
+    { .l = 0x6b, .r = 0x71, .k = -2 },
+    { .l = 0x6d, .r = 0x22, .k = -2 },
+    { .l = 0x6d, .r = 0x27, .k = -2 },
+    { .l = 0x6d, .r = 0x2a, .k = -2 },
+    { .l = 0x6d, .r = 0x76, .k = -1 },
+    { .l = 0x6d, .r = 0x79, .k = -1 },
+    { .l = 0x6e, .r = 0x22, .k = -2 },
+    { .l = 0x6e, .r = 0x27, .k = -2 },
+    { .l = 0x6e, .r = 0x2a, .k = -2 },
+    { .l = 0x6e, .r = 0x76, .k = -1 },
+    { .l = 0x6e, .r = 0x79, .k = -1 },
+    { .l = 0x6f, .r = 0x22, .k = -2 },
+    { .l = 0x6f, .r = 0x27, .k = -2 },
+    { .l = 0x6f, .r = 0x29, .k = -1 },
+    { .l = 0x6f, .r = 0x2a, .k = -2 },
+    { .l = 0x6f, .r = 0x56, .k = -3 },
+    { .l = 0x6f, .r = 0x57, .k = -1 },
+    { .l = 0x6f, .r = 0x5c, .k = -3 },
+    { .l = 0x6f, .r = 0x5d, .k = -1 },
+    { .l = 0x6f, .r = 0x76, .k = -1 },
+    { .l = 0x6f, .r = 0x78, .k = -2 },
+    { .l = 0x6f, .r = 0x79, .k = -1 },
+    { .l = 0x6f, .r = 0x7d, .k = -1 },
+    { .l = 0x70, .r = 0x22, .k = -2 },
+    { .l = 0x70, .r = 0x27, .k = -2 },
+    { .l = 0x70, .r = 0x29, .k = -1 },
+    { .l = 0x70, .r = 0x2a, .k = -2 },
+    { .l = 0x70, .r = 0x56, .k = -3 },
+    { .l = 0x70, .r = 0x57, .k = -1 },
+    { .l = 0x70, .r = 0x5c, .k = -3 },
+    { .l = 0x70, .r = 0x5d, .k = -1 },
+    { .l = 0x70, .r = 0x76, .k = -1 },
+    { .l = 0x70, .r = 0x78, .k = -2 },
+    { .l = 0x70, .r = 0x79, .k = -1 },
+    { .l = 0x70, .r = 0x7d, .k = -1 },
+    { .l = 0x72, .r = 0x2c, .k = -4 },
+    { .l = 0x72, .r = 0x2e, .k = -4 },
+    { .l = 0x72, .r = 0x61, .k = -1 },
+    { .l = 0x76, .r = 0x26, .k = -2 },
+    { .l = 0x76, .r = 0x2c, .k = -4 },
+    { .l = 0x76, .r = 0x2e, .k = -4 },
+    { .l = 0x76, .r = 0x2f, .k = -2 },
+    { .l = 0x76, .r = 0x41, .k = -2 },
+    { .l = 0x76, .r = 0x63, .k = -1 },
+    { .l = 0x76, .r = 0x64, .k = -1 },
+    { .l = 0x76, .r = 0x65, .k = -1 },
+    { .l = 0x76, .r = 0x6f, .k = -1 },
+    { .l = 0x76, .r = 0x71, .k = -1 },
+    { .l = 0x77, .r = 0x2c, .k = -2 },
+    { .l = 0x77, .r = 0x2e, .k = -2 },
+    { .l = 0x78, .r = 0x63, .k = -2 },
+    { .l = 0x78, .r = 0x64, .k = -2 },
+    { .l = 0x78, .r = 0x65, .k = -2 },
+    { .l = 0x78, .r = 0x6f, .k = -2 },
+    { .l = 0x78, .r = 0x71, .k = -2 },
+    { .l = 0x79, .r = 0x26, .k = -2 },
+    { .l = 0x79, .r = 0x2c, .k = -4 },
+    { .l = 0x79, .r = 0x2e, .k = -4 },
+    { .l = 0x79, .r = 0x2f, .k = -2 },
+    { .l = 0x79, .r = 0x41, .k = -2 },
+    { .l = 0x79, .r = 0x63, .k = -1 },
+    { .l = 0x79, .r = 0x64, .k = -1 },
+    { .l = 0x79, .r = 0x65, .k = -1 },
+    { .l = 0x79, .r = 0x6f, .k = -1 },
+    { .l = 0x79, .r = 0x71, .k = -1 },
+    { .l = 0x7b, .r = 0x40, .k = -1 },
+    { .l = 0x7b, .r = 0x43, .k = -1 },
+    { .l = 0x7b, .r = 0x47, .k = -1 },
+    { .l = 0x7b, .r = 0x4f, .k = -1 },
+    { .l = 0x7b, .r = 0x51, .k = -1 },
+    { .l = 0x7b, .r = 0x63, .k = -1 },
+    { .l = 0x7b, .r = 0x64, .k = -1 },
+    { .l = 0x7b, .r = 0x65, .k = -1 },
+    { .l = 0x7b, .r = 0x6f, .k = -1 },
+    { .l = 0x7b, .r = 0x71, .k = -1 }
+};
@@ -0,0 +1,60 @@
+// Generated by tools/font_atlas.c from fonts/strings.txt, do not edit
+
+#include "font_strings.h"
+
+static const FontStringGlyph font_string_0[] = {
+    { .glyph = 40, .x = 4 },
+    { .glyph = 69, .x = 41 },
+    { .glyph = 76, .x = 72 },
+    { .glyph = 76, .x = 86 },
+    { .glyph = 79, .x = 97 },
+    { .glyph = 55, .x = 136 },
+    { .glyph = 73, .x = 193 },
+    { .glyph = 73, .x = 207 },
+    { .glyph = 1, .x = 301 },
+    { .glyph = 95, .x = 228 },
+};
+
+static const FontStringGlyph font_string_1[] = {
+    { .glyph = 52, .x = 0 },
+    { .glyph = 72, .x = 34 },
+    { .glyph = 69, .x = 62 },
+    { .glyph = 81, .x = 100 },
+    { .glyph = 85, .x = 132 },
+    { .glyph = 73, .x = 162 },
+    { .glyph = 67, .x = 174 },
+    { .glyph = 75, .x = 202 },
+    { .glyph = 66, .x = 240 },
+    { .glyph = 82, .x = 269 },
+    { .glyph = 79, .x = 288 },
+    { .glyph = 87, .x = 317 },
+    { .glyph = 78, .x = 361 },
+    { .glyph = 70, .x = 398 },
+    { .glyph = 79, .x = 417 },
+    { .glyph = 88, .x = 444 },
+    { .glyph = 74, .x = 479 },
+    { .glyph = 85, .x = 498 },
+    { .glyph = 77, .x = 528 },
+    { .glyph = 80, .x = 572 },
+    { .glyph = 83, .x = 599 },
+    { .glyph = 79, .x = 632 },
+    { .glyph = 86, .x = 660 },
+    { .glyph = 69, .x = 687 },
+    { .glyph = 82, .x = 717 },
+    { .glyph = 84, .x = 746 },
+    { .glyph = 72, .x = 768 },
+    { .glyph = 69, .x = 796 },
+    { .glyph = 76, .x = 837 },
+    { .glyph = 65, .x = 849 },
+    { .glyph = 90, .x = 875 },
+    { .glyph = 89, .x = 899 },
+    { .glyph = 68, .x = 937 },
+    { .glyph = 79, .x = 967 },
+    { .glyph = 71, .x = 997 },
+    { .glyph = 14, .x = 1025 },
+};
+
+const FontString font_strings[FONT_STRINGS_SIZE] = {
+    [FONT_STRING_HELLO] = { font_string_0, 10, 314 },
+    [FONT_STRING_QUICK_FOX] = { font_string_1, 36, 1034 },
+};
@@ -0,0 +1,64 @@
+#include <string.h>
+
+#include "font.h"
+
+FontTable font_table;
+
+void font_table_init(void) {
+    memset(&font_table, 0, sizeof(FontTable));
+    memset(font_table.page_glyphs, FONT_GLYPH_NONE, sizeof(font_table.page_glyphs));
+
+    // Pack glyph metrics and give each used page of code points its own index page
+    for (uint32_t i = 0; i < sizeof(font) / sizeof(FontChar) && i < FONT_GLYPHS_MAX; i++) {
+        FontChar *font_char = &font[i];
+        if (font_char->n >= 0x20000) continue;
+        uint8_t *page = &font_table.pages[font_char->n >> FONT_PAGE_BITS];
+        if (*page == 0) {
+            if (font_table.pages_size == FONT_PAGES_MAX) continue;
+            *page = ++font_table.pages_size;
+        }
+
+        uint8_t index = font_table.glyphs_size++;
+        font_table.glyphs[index] = (FontGlyph){
+            .x = font_char->x,
+            .y = font_char->y,
+            .width = font_char->w,
+            .height = font_char->h,
+            .ascent = font_char->a,
+            .bearing = font_char->b,
+            .advance = font_char->d,
+            .flags = font_char->c ? FONT_GLYPH_COLORED : 0,
+        };
+        font_table.page_glyphs[*page - 1][font_char->n & ((1 << FONT_PAGE_BITS) - 1)] = index;
+    }
+
+    // Key kerning pairs by glyph index, insertion sorted because the table is built once
+    for (uint32_t i = 0; i < sizeof(font_kernings) / sizeof(FontKerning); i++) {
+        FontKerning *kerning = &font_kernings[i];
+        uint8_t left = font_table_find(kerning->l), right = font_table_find(kerning->r);
+        if (left == FONT_GLYPH_NONE || right == FONT_GLYPH_NONE) continue;
+        uint16_t key = (left << 8) | right;
+        uint32_t j = font_table.kernings_size++;
+        while (j > 0 && font_table.kerning_keys[j - 1] > key) {
+            font_table.kerning_keys[j] = font_table.kerning_keys[j - 1];
+            font_table.kerning_values[j] = font_table.kerning_values[j - 1];
+            j--;
+        }
+        font_table.kerning_keys[j] = key;
+        font_table.kerning_values[j] = kerning->k;
+    }
+}
+
+int8_t font_table_find_kerning(uint8_t left, uint8_t right) {
+    uint16_t key = (left << 8) | right;
+    uint32_t low = 0, high = font_table.kernings_size;
+    while (low < high) {
+        uint32_t middle = (low + high) / 2;
+        if (font_table.kerning_keys[middle] < key) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low < font_table.kernings_size && font_table.kerning_keys[low] == key ? font_table.kerning_values[low] : 0;
+}
@@ -0,0 +1,127 @@
+#include "format.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "utf8.h"
+
+typedef struct FormatWriter {
+    FormatEmit emit;
+    void *context;
+} FormatWriter;
+
+static void format_pad(FormatWriter *writer, uint32_t width, uint32_t size, char pad) {
+    for (; width > size; width--) writer->emit(writer->context, pad);
+}
+
+static void format_digits(FormatWriter *writer, uint32_t value, uint32_t base, uint32_t count) {
+    // Digits come out lowest first, so they are collected in reverse
+    char digits[32];
+    for (uint32_t i = 0; i < count; i++, value /= base) digits[i] = "0123456789abcdef"[value % base];
+    while (count > 0) writer->emit(writer->context, digits[--count]);
+}
+
+static void format_number(FormatWriter *writer, bool negative, uint32_t integer, uint32_t base, uint32_t fraction,
+                          uint32_t precision, uint32_t width, char pad) {
+    // Spaces go before the sign and zeros after it, like printf
+    uint32_t count = 1;
+    for (uint32_t i = integer; i >= base; i /= base) count++;
+    uint32_t size = negative + count + (precision > 0 ? precision + 1 : 0);
+    if (negative && pad == '0') writer->emit(writer->context, '-');
+    format_pad(writer, width, size, pad);
+    if (negative && pad != '0') writer->emit(writer->context, '-');
+    format_digits(writer, integer, base, count);
+    if (precision == 0) return;
+    writer->emit(writer->context, '.');
+    format_digits(writer, fraction, 10, precision);
+}
+
+static void format_float(FormatWriter *writer, float value, uint32_t precision, uint32_t width, char pad) {
+    // Fixed point with up to FORMAT_MAX_PRECISION decimals, rounded half away from zero
+    static const uint32_t powers[FORMAT_MAX_PRECISION + 1] = {1, 10, 100, 1000, 10000};
+    if (precision > FORMAT_MAX_PRECISION) precision = FORMAT_MAX_PRECISION;
+    bool negative = value < 0;
+    if (negative) value = -value;
+    if (!(value < 4e9f / powers[precision])) value = value > 0 ? 4e9f / powers[precision] : 0;
+    uint32_t fixed = (uint32_t)(value * powers[precision] + 0.5f);
+    format_number(writer, negative, fixed / powers[precision], 10, fixed % powers[precision], precision, width,
+                  pad);
+}
+
+static void format_string(FormatWriter *writer, const char *text, uint32_t precision, uint32_t width, char pad) {
+    // Count the code points that fit the precision first, the padding goes before them
+    if (text == NULL) text = "(null)";
+    size_t length = strlen(text);
+    size_t end = 0;
+    uint32_t size = 0;
+    for (; end < length && size < precision; size++) utf8_decode_next(text, length, &end);
+    format_pad(writer, width, size, pad);
+    size_t index = 0;
+    while (index < end) writer->emit(writer->context, utf8_decode_next(text, end, &index));
+}
+
+void format_write(const char *format, va_list arguments, FormatEmit emit, void *context) {
+    FormatWriter writer = {emit, context};
+    size_t length = strlen(format);
+    size_t index = 0;
+    while (index < length) {
+        size_t start = index;
+        uint32_t code_point = utf8_decode_next(format, length, &index);
+        if (code_point != '%') {
+            emit(context, code_point);
+            continue;
+        }
+
+        // %[0][width][.precision] followed by d, u, x, f, s, c or %, anything else prints as written
+        char pad = ' ';
+        uint32_t width = 0, precision = UINT32_MAX;
+        if (index < length && format[index] == '0') {
+            pad = '0';
+            index++;
+        }
+        while (index < length && format[index] >= '0' && format[index] <= '9') {
+            width = width * 10 + format[index++] - '0';
+        }
+        if (index < length && format[index] == '.') {
+            precision = 0;
+            index++;
+            while (index < length && format[index] >= '0' && format[index] <= '9') {
+                precision = precision * 10 + format[index++] - '0';
+            }
+        }
+        char conversion = index < length ? format[index++] : '\0';
+        switch (conversion) {
+            case 'd': {
+                int value = va_arg(arguments, int);
+                uint32_t magnitude = value < 0 ? -(uint32_t)value : (uint32_t)value;
+                format_number(&writer, value < 0, magnitude, 10, 0, 0, width, pad);
+                break;
+            }
+            case 'u':
+                format_number(&writer, false, va_arg(arguments, unsigned int), 10, 0, 0, width, pad);
+                break;
+            case 'x':
+                format_number(&writer, false, va_arg(arguments, unsigned int), 16, 0, 0, width, pad);
+                break;
+            case 'f':
+                format_float(&writer, (float)va_arg(arguments, double),
+                             precision == UINT32_MAX ? FORMAT_MAX_PRECISION : precision, width, pad);
+                break;
+            case 's':
+                format_string(&writer, va_arg(arguments, const char *), precision, width, pad);
+                break;
+            case 'c':
+                format_pad(&writer, width, 1, pad);
+                emit(context, va_arg(arguments, int));
+                break;
+            case '%':
+                emit(context, '%');
+                break;
+            default:
+                // A conversion byte that starts a multibyte code point is decoded again as text
+                if ((uint8_t)conversion >= 0x80) index--;
+                while (start < index) emit(context, format[start++]);
+                break;
+        }
+    }
+}
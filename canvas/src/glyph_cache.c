@@ -0,0 +1,174 @@
+#include "glyph_cache.h"
+
+#include <malloc.h>
+#include <ogc/lwp_watchdog.h>
+#include <string.h>
+
+GlyphCache glyph_cache;
+
+// Scratch buffer of one glyph
+static uint8_t glyph_pixels[TRUETYPE_MAX_RASTER * TRUETYPE_MAX_RASTER];
+
+bool glyph_cache_init(const uint8_t *data, uint32_t size, float scale) {
+    memset(&glyph_cache, 0, sizeof(GlyphCache));
+    glyph_cache.scale = scale;
+    glyph_cache.generation = 1;
+    return truetype_init(&glyph_cache.font, data, size);
+}
+
+static void glyph_cache_queue(uint16_t entry_index) {
+    GlyphCacheEntry *entry = &glyph_cache.entries[entry_index];
+    if (glyph_cache.queue_size == GLYPH_CACHE_QUEUE_SIZE) return;
+    glyph_cache.queue[glyph_cache.queue_size++] = entry_index;
+    entry->state = GLYPH_CACHE_QUEUED;
+}
+
+GlyphCacheEntry *glyph_cache_find(uint32_t code_point) {
+    if (glyph_cache.font.data == NULL) return NULL;
+
+    // Open addressing with linear probing
+    uint32_t mask = GLYPH_CACHE_ENTRIES_SIZE - 1;
+    uint32_t index = (code_point * 2654435761u) >> 23;
+    for (uint32_t i = 0; i < GLYPH_CACHE_ENTRIES_SIZE; i++, index = (index + 1) & mask) {
+        GlyphCacheEntry *entry = &glyph_cache.entries[index];
+        if (entry->state != GLYPH_CACHE_EMPTY && entry->code_point != code_point) continue;
+        if (entry->state == GLYPH_CACHE_MISSING) return NULL;
+        if (entry->state == GLYPH_CACHE_EVICTED) glyph_cache_queue(index);
+        if (entry->state != GLYPH_CACHE_EMPTY) return entry;
+
+        // Queue glyph on first use
+        entry->code_point = code_point;
+        entry->glyph = truetype_find_glyph(&glyph_cache.font, code_point);
+        if (entry->glyph == 0) {
+            entry->state = GLYPH_CACHE_MISSING;
+            return NULL;
+        }
+        float advance = truetype_get_advance(&glyph_cache.font, entry->glyph) * glyph_cache.scale;
+        entry->advance = advance < 255 ? advance + 0.5f : 255;
+        TrueTypeBox box;
+        if (truetype_get_box(&glyph_cache.font, entry->glyph, glyph_cache.scale, &box) &&
+            box.x1 - box.x0 <= TRUETYPE_MAX_RASTER && box.y1 - box.y0 <= TRUETYPE_MAX_RASTER) {
+            entry->box_x = box.x0;
+            entry->box_y = box.y0;
+            entry->width = box.x1 - box.x0;
+            entry->height = box.y1 - box.y0;
+            entry->state = GLYPH_CACHE_EVICTED;
+            glyph_cache_queue(index);
+        } else {
+            // Empty glyphs like spaces only advance
+            entry->state = GLYPH_CACHE_READY;
+        }
+        return entry;
+    }
+    return NULL;
+}
+
+static GlyphCachePage *glyph_cache_new_page(void) {
+    if (glyph_cache.pages_size < GLYPH_CACHE_PAGES_MAX) {
+        GlyphCachePage *page = &glyph_cache.pages[glyph_cache.pages_size++];
+        page->texels = memalign(32, GLYPH_CACHE_PAGE_SIZE * GLYPH_CACHE_PAGE_SIZE);
+        memset(page->texels, 0, GLYPH_CACHE_PAGE_SIZE * GLYPH_CACHE_PAGE_SIZE);
+        DCFlushRange(page->texels, GLYPH_CACHE_PAGE_SIZE * GLYPH_CACHE_PAGE_SIZE);
+        GX_InitTexObj(&page->texture, page->texels, GLYPH_CACHE_PAGE_SIZE, GLYPH_CACHE_PAGE_SIZE, GX_TF_I8, GX_CLAMP,
+                      GX_CLAMP, GX_FALSE);
+        page->last_used = glyph_cache.frame;
+        return page;
+    }
+
+    // Clear the least recently drawn page not filled by this update
+    GlyphCachePage *oldest = NULL;
+    for (uint32_t i = 0; i < glyph_cache.pages_size; i++) {
+        GlyphCachePage *page = &glyph_cache.pages[i];
+        if (page->last_used == glyph_cache.frame) continue;
+        if (oldest == NULL || page->last_used < oldest->last_used) oldest = page;
+    }
+    if (oldest == NULL) return NULL;
+    uint8_t page_index = oldest - glyph_cache.pages;
+    for (uint32_t i = 0; i < GLYPH_CACHE_ENTRIES_SIZE; i++) {
+        GlyphCacheEntry *entry = &glyph_cache.entries[i];
+        if (entry->state == GLYPH_CACHE_READY && entry->width != 0 && entry->page == page_index) {
+            entry->state = GLYPH_CACHE_EVICTED;
+        }
+    }
+    memset(oldest->texels, 0, GLYPH_CACHE_PAGE_SIZE * GLYPH_CACHE_PAGE_SIZE);
+    DCFlushRange(oldest->texels, GLYPH_CACHE_PAGE_SIZE * GLYPH_CACHE_PAGE_SIZE);
+    oldest->shelf_x = 0;
+    oldest->shelf_y = 0;
+    oldest->shelf_height = 0;
+    oldest->last_used = glyph_cache.frame;
+    glyph_cache.evicted++;
+    glyph_cache.generation++;
+    return oldest;
+}
+
+static bool glyph_cache_place(GlyphCacheEntry *entry) {
+    // Shelf pack into the newest page with a one texel gap
+    uint32_t width = entry->width + 1, height = entry->height + 1;
+    GlyphCachePage *page = glyph_cache.pages_size > 0 ? &glyph_cache.pages[glyph_cache.pages_size - 1] : NULL;
+    if (glyph_cache.pages_size > 0) {
+        // Evicted pages are refilled before the newest one
+        for (uint32_t i = 0; i < glyph_cache.pages_size; i++) {
+            if (glyph_cache.pages[i].shelf_y < page->shelf_y) page = &glyph_cache.pages[i];
+        }
+        if (page->shelf_x + width > GLYPH_CACHE_PAGE_SIZE) {
+            page->shelf_x = 0;
+            page->shelf_y += page->shelf_height;
+            page->shelf_height = 0;
+        }
+    }
+    if (page == NULL || page->shelf_y + height > GLYPH_CACHE_PAGE_SIZE) {
+        page = glyph_cache_new_page();
+        if (page == NULL) return false;
+    }
+    page->last_used = glyph_cache.frame;
+    entry->page = page - glyph_cache.pages;
+    entry->x = page->shelf_x;
+    entry->y = page->shelf_y;
+    page->shelf_x += width;
+    if (height > page->shelf_height) page->shelf_height = height;
+    return true;
+}
+
+static void glyph_cache_rasterize(GlyphCacheEntry *entry) {
+    TrueTypeBox box = {entry->box_x, entry->box_y, entry->box_x + entry->width, entry->box_y + entry->height};
+    truetype_rasterize(&glyph_cache.font, entry->glyph, glyph_cache.scale, &box, glyph_pixels, entry->width);
+
+    // Write into the 8x4 texel tiles of the I8 page
+    GlyphCachePage *page = &glyph_cache.pages[entry->page];
+    for (uint32_t y = 0; y < entry->height; y++) {
+        uint32_t page_y = entry->y + y;
+        uint8_t *row = &page->texels[(page_y / 4) * (GLYPH_CACHE_PAGE_SIZE / 8) * 32 + (page_y % 4) * 8];
+        for (uint32_t x = 0; x < entry->width; x++) {
+            uint32_t page_x = entry->x + x;
+            row[(page_x / 8) * 32 + page_x % 8] = glyph_pixels[y * entry->width + x];
+        }
+    }
+
+    // Flush the tile rows the glyph touched
+    uint32_t row_bytes = (GLYPH_CACHE_PAGE_SIZE / 8) * 32;
+    uint32_t first_row = entry->y / 4, last_row = (entry->y + entry->height - 1) / 4;
+    DCFlushRange(&page->texels[first_row * row_bytes], (last_row - first_row + 1) * row_bytes);
+}
+
+void glyph_cache_update(uint32_t budget_us) {
+    glyph_cache.frame++;
+    if (glyph_cache.queue_size == 0) return;
+
+    // Rasterize at least one glyph
+    uint64_t start = gettime();
+    uint32_t done = 0;
+    while (done < glyph_cache.queue_size) {
+        if (done > 0 && diff_usec(start, gettime()) >= budget_us) break;
+        GlyphCacheEntry *entry = &glyph_cache.entries[glyph_cache.queue[done]];
+        if (!glyph_cache_place(entry)) break;
+        glyph_cache_rasterize(entry);
+        entry->state = GLYPH_CACHE_READY;
+        glyph_cache.rasterized++;
+        done++;
+    }
+    glyph_cache.queue_size -= done;
+    memmove(glyph_cache.queue, &glyph_cache.queue[done], glyph_cache.queue_size * sizeof(uint16_t));
+    if (done == 0) return;
+    glyph_cache.generation++;
+    GX_InvalidateTexAll();
+}
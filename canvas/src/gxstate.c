@@ -0,0 +1,304 @@
+#include "gxstate.h"
+
+#include <malloc.h>
+#include <string.h>
+
+GXState gxstate;
+
+void gxstate_invalidate(void) {
+    // Forget shadowed state
+    uint8_t vtx_desc[GXSTATE_MAX_ATTRS];
+    uint32_t vtx_desc_touched = gxstate.vtx_desc_touched;
+    memcpy(vtx_desc, gxstate.vtx_desc, sizeof(vtx_desc));
+    uint32_t issued = gxstate.issued;
+    uint32_t elided = gxstate.elided;
+    memset(&gxstate, 0, sizeof(GXState));
+    memcpy(gxstate.vtx_desc, vtx_desc, sizeof(vtx_desc));
+    gxstate.vtx_desc_touched = vtx_desc_touched;
+    gxstate.issued = issued;
+    gxstate.elided = elided;
+}
+
+void gxstate_reset_stats(void) {
+    gxstate.issued = 0;
+    gxstate.elided = 0;
+}
+
+void gxstate_set_z_mode(uint8_t enable, uint8_t func, uint8_t update) {
+    if (gxstate.z_mode_valid && gxstate.z_enable == enable && gxstate.z_func == func && gxstate.z_update == update) {
+        gxstate.elided++;
+        return;
+    }
+    GX_SetZMode(enable, func, update);
+    gxstate.z_mode_valid = true;
+    gxstate.z_enable = enable;
+    gxstate.z_func = func;
+    gxstate.z_update = update;
+    gxstate.issued++;
+}
+
+void gxstate_set_cull_mode(uint8_t mode) {
+    if (gxstate.cull_mode_valid && gxstate.cull_mode == mode) {
+        gxstate.elided++;
+        return;
+    }
+    GX_SetCullMode(mode);
+    gxstate.cull_mode_valid = true;
+    gxstate.cull_mode = mode;
+    gxstate.issued++;
+}
+
+void gxstate_set_blend_mode(uint8_t type, uint8_t src_fact, uint8_t dst_fact, uint8_t op) {
+    if (gxstate.blend_mode_valid && gxstate.blend_type == type && gxstate.blend_src_fact == src_fact &&
+        gxstate.blend_dst_fact == dst_fact && gxstate.blend_op == op) {
+        gxstate.elided++;
+        return;
+    }
+    GX_SetBlendMode(type, src_fact, dst_fact, op);
+    gxstate.blend_mode_valid = true;
+    gxstate.blend_type = type;
+    gxstate.blend_src_fact = src_fact;
+    gxstate.blend_dst_fact = dst_fact;
+    gxstate.blend_op = op;
+    gxstate.issued++;
+}
+
+void gxstate_set_num_chans(uint8_t num) {
+    if (gxstate.num_chans_valid && gxstate.num_chans == num) {
+        gxstate.elided++;
+        return;
+    }
+    GX_SetNumChans(num);
+    gxstate.num_chans_valid = true;
+    gxstate.num_chans = num;
+    gxstate.issued++;
+}
+
+void gxstate_set_num_tex_gens(uint32_t num) {
+    if (gxstate.num_tex_gens_valid && gxstate.num_tex_gens == num) {
+        gxstate.elided++;
+        return;
+    }
+    GX_SetNumTexGens(num);
+    gxstate.num_tex_gens_valid = true;
+    gxstate.num_tex_gens = num;
+    gxstate.issued++;
+}
+
+void gxstate_set_num_tev_stages(uint8_t num) {
+    if (gxstate.num_tev_stages_valid && gxstate.num_tev_stages == num) {
+        gxstate.elided++;
+        return;
+    }
+    GX_SetNumTevStages(num);
+    gxstate.num_tev_stages_valid = true;
+    gxstate.num_tev_stages = num;
+    gxstate.issued++;
+}
+
+void gxstate_set_alpha_compare(uint8_t comp0, uint8_t ref0, uint8_t aop, uint8_t comp1, uint8_t ref1) {
+    uint8_t alpha_compare[5] = {comp0, ref0, aop, comp1, ref1};
+    if (gxstate.alpha_compare_valid && memcmp(gxstate.alpha_compare, alpha_compare, sizeof(alpha_compare)) == 0) {
+        gxstate.elided++;
+        return;
+    }
+    GX_SetAlphaCompare(comp0, ref0, aop, comp1, ref1);
+    gxstate.alpha_compare_valid = true;
+    memcpy(gxstate.alpha_compare, alpha_compare, sizeof(alpha_compare));
+    gxstate.issued++;
+}
+
+void gxstate_set_tex_coord_gen(uint16_t texcoord, uint32_t func, uint32_t src, uint32_t mtx) {
+    GXStateTexCoordGen *gen = &gxstate.tex_coord_gens[texcoord];
+    if (gen->valid && gen->func == func && gen->src == src && gen->mtx == mtx) {
+        gxstate.elided++;
+        return;
+    }
+    GX_SetTexCoordGen(texcoord, func, src, mtx);
+    *gen = (GXStateTexCoordGen){true, func, src, mtx};
+    gxstate.issued++;
+}
+
+void gxstate_clear_vtx_desc(void) {
+    for (uint8_t attr = 0; attr < GXSTATE_MAX_ATTRS; attr++) {
+        if (gxstate.vtx_desc[attr] != GX_NONE) {
+            gxstate.vtx_desc[attr] = GX_NONE;
+            gxstate.vtx_desc_touched |= 1 << attr;
+        }
+    }
+}
+
+void gxstate_set_vtx_desc(uint8_t attr, uint8_t type) {
+    gxstate.vtx_desc[attr] = type;
+    gxstate.vtx_desc_touched |= 1 << attr;
+}
+
+void gxstate_set_vtx_attr_fmt(uint8_t vtxfmt, uint32_t attr, uint32_t comp_count, uint32_t comp_type, uint32_t frac) {
+    GXStateVtxAttrFmt *fmt = &gxstate.vtx_attr_fmts[vtxfmt][attr];
+    if (fmt->valid && fmt->comp_count == comp_count && fmt->comp_type == comp_type && fmt->frac == frac) {
+        gxstate.elided++;
+        return;
+    }
+    GX_SetVtxAttrFmt(vtxfmt, attr, comp_count, comp_type, frac);
+    *fmt = (GXStateVtxAttrFmt){true, comp_count, comp_type, frac};
+    gxstate.issued++;
+}
+
+void gxstate_set_tev_order(uint8_t stage, uint8_t texcoord, uint32_t texmap, uint8_t color) {
+    GXStateTevStage *tev_stage = &gxstate.tev_stages[stage];
+    if (tev_stage->order_valid && tev_stage->texcoord == texcoord && tev_stage->texmap == texmap &&
+        tev_stage->color == color) {
+        gxstate.elided++;
+        return;
+    }
+    GX_SetTevOrder(stage, texcoord, texmap, color);
+    tev_stage->order_valid = true;
+    tev_stage->texcoord = texcoord;
+    tev_stage->texmap = texmap;
+    tev_stage->color = color;
+    gxstate.issued++;
+}
+
+void gxstate_set_tev_op(uint8_t stage, uint8_t op) {
+    GXStateTevStage *tev_stage = &gxstate.tev_stages[stage];
+    if (tev_stage->op_valid && tev_stage->op == op) {
+        gxstate.elided++;
+        return;
+    }
+    GX_SetTevOp(stage, op);
+    tev_stage->op_valid = true;
+    tev_stage->op = op;
+    tev_stage->color_in_valid = false;
+    tev_stage->alpha_in_valid = false;
+    tev_stage->alpha_op_valid = false;
+    gxstate.issued++;
+}
+
+void gxstate_set_tev_color_in(uint8_t stage, uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+    GXStateTevStage *tev_stage = &gxstate.tev_stages[stage];
+    uint8_t color_in[4] = {a, b, c, d};
+    if (tev_stage->color_in_valid && memcmp(tev_stage->color_in, color_in, sizeof(color_in)) == 0) {
+        gxstate.elided++;
+        return;
+    }
+    GX_SetTevColorIn(stage, a, b, c, d);
+    tev_stage->op_valid = false;
+    tev_stage->color_in_valid = true;
+    memcpy(tev_stage->color_in, color_in, sizeof(color_in));
+    gxstate.issued++;
+}
+
+void gxstate_set_tev_alpha_in(uint8_t stage, uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+    GXStateTevStage *tev_stage = &gxstate.tev_stages[stage];
+    uint8_t alpha_in[4] = {a, b, c, d};
+    if (tev_stage->alpha_in_valid && memcmp(tev_stage->alpha_in, alpha_in, sizeof(alpha_in)) == 0) {
+        gxstate.elided++;
+        return;
+    }
+    GX_SetTevAlphaIn(stage, a, b, c, d);
+    tev_stage->op_valid = false;
+    tev_stage->alpha_in_valid = true;
+    memcpy(tev_stage->alpha_in, alpha_in, sizeof(alpha_in));
+    gxstate.issued++;
+}
+
+void gxstate_set_tev_alpha_op(uint8_t stage, uint8_t op, uint8_t bias, uint8_t scale, uint8_t clamp, uint8_t reg) {
+    GXStateTevStage *tev_stage = &gxstate.tev_stages[stage];
+    uint8_t alpha_op[5] = {op, bias, scale, clamp, reg};
+    if (tev_stage->alpha_op_valid && memcmp(tev_stage->alpha_op, alpha_op, sizeof(alpha_op)) == 0) {
+        gxstate.elided++;
+        return;
+    }
+    GX_SetTevAlphaOp(stage, op, bias, scale, clamp, reg);
+    tev_stage->op_valid = false;
+    tev_stage->alpha_op_valid = true;
+    memcpy(tev_stage->alpha_op, alpha_op, sizeof(alpha_op));
+    gxstate.issued++;
+}
+
+void gxstate_set_tev_k_alpha_sel(uint8_t stage, uint8_t sel) {
+    GXStateTevStage *tev_stage = &gxstate.tev_stages[stage];
+    if (tev_stage->k_alpha_sel_valid && tev_stage->k_alpha_sel == sel) {
+        gxstate.elided++;
+        return;
+    }
+    GX_SetTevKAlphaSel(stage, sel);
+    tev_stage->k_alpha_sel_valid = true;
+    tev_stage->k_alpha_sel = sel;
+    gxstate.issued++;
+}
+
+bool gxstate_load_tex_obj(GXTexObj *texture, uint8_t map) {
+    // Compare the whole texture object
+    GXStateTexMap *tex_map = &gxstate.tex_maps[map];
+    if (tex_map->valid && memcmp(&tex_map->texture, texture, sizeof(GXTexObj)) == 0) {
+        gxstate.elided++;
+        return false;
+    }
+    GX_LoadTexObj(texture, map);
+    tex_map->valid = true;
+    tex_map->texture = *texture;
+    gxstate.issued++;
+    return true;
+}
+
+void gxstate_commit(void) {
+    // Commit changed vertex descriptors
+    if (!gxstate.vtx_desc_valid) {
+        GX_ClearVtxDesc();
+        gxstate.issued++;
+        for (uint8_t attr = 0; attr < GXSTATE_MAX_ATTRS; attr++) {
+            if (gxstate.vtx_desc[attr] != GX_NONE) {
+                GX_SetVtxDesc(attr, gxstate.vtx_desc[attr]);
+                gxstate.issued++;
+            }
+            gxstate.vtx_desc_committed[attr] = gxstate.vtx_desc[attr];
+        }
+        gxstate.vtx_desc_valid = true;
+    } else if (gxstate.vtx_desc_touched != 0) {
+        for (uint8_t attr = 0; attr < GXSTATE_MAX_ATTRS; attr++) {
+            if ((gxstate.vtx_desc_touched & (1 << attr)) == 0) continue;
+            if (gxstate.vtx_desc[attr] != gxstate.vtx_desc_committed[attr]) {
+                GX_SetVtxDesc(attr, gxstate.vtx_desc[attr]);
+                gxstate.vtx_desc_committed[attr] = gxstate.vtx_desc[attr];
+                gxstate.issued++;
+            } else {
+                gxstate.elided++;
+            }
+        }
+    }
+    gxstate.vtx_desc_touched = 0;
+}
+
+void gxstate_begin(uint8_t primitive, uint8_t vtxfmt, uint16_t vertex_count) {
+    gxstate_commit();
+    GX_Begin(primitive, vtxfmt, vertex_count);
+}
+
+void gxstate_block_begin(GXStateBlock *block, uint32_t capacity) {
+    // Start recording from an unknown state
+    block->data = memalign(32, capacity);
+    DCInvalidateRange(block->data, capacity);
+    gxstate_invalidate();
+    GX_BeginDispList(block->data, capacity);
+}
+
+void gxstate_block_end(GXStateBlock *block) {
+    gxstate_commit();
+    block->size = GX_EndDispList();
+    block->state = gxstate;
+
+    // Nothing recorded reached the gpu
+    gxstate_invalidate();
+}
+
+void gxstate_block_apply(GXStateBlock *block) {
+    GX_CallDispList(block->data, block->size);
+
+    // The shadow now matches the state after the block
+    uint32_t issued = gxstate.issued;
+    uint32_t elided = gxstate.elided;
+    gxstate = block->state;
+    gxstate.issued = issued + 1;
+    gxstate.elided = elided;
+}
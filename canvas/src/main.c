@@ -1,5 +1,6 @@
 #include <gccore.h>
 #include <malloc.h>
+#include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -7,12 +8,22 @@
 #include <string.h>
 #include <wiiuse/wpad.h>
 
-#include "blocks_texture.h"
-#include "blocks_texture_tpl.h"
 #include "canvas.h"
 #include "cursor.h"
+#include "dirt_grass_png.h"
+#include "font_strings.h"
+#include "glyph_cache.h"
+#include "gxstate.h"
+#include "matrix.h"
+#include "stone_coal_tpl.h"
+#include "texture.h"
 
 #define DEFAULT_FIFO_SIZE (256 * 1024)
+// After the canvas atlas TLUTs
+#define DIRT_GRASS_TLUT (CANVAS_ATLAS_TLUT + ATLAS_MAX_PAGES)
+
+// Cursor tints the minus button cycles through, 0 is the original colors
+static const uint32_t cursor_tints[] = {0, 0xff0000ff, 0x00c000ff, 0xffc000ff};
 
 GXRModeObj *screenmode;
 
@@ -85,20 +96,58 @@ int main(void) {
     cursor_init();
 
     // Load textures
-    TPLFile blocks_tpl;
-    TPL_OpenTPLFromMemory(&blocks_tpl, (void *)blocks_texture_tpl, blocks_texture_tpl_size);
     GXTexObj dirt_grass_texture;
-    TPL_GetTexture(&blocks_tpl, dirt_grass, &dirt_grass_texture);
+    TexturePalette dirt_grass_palette;
+    texture_load_png_palette(&dirt_grass_texture, &dirt_grass_palette, DIRT_GRASS_TLUT, NULL, dirt_grass_png,
+                             dirt_grass_png_size, TEXTURE_FORMAT_AUTO);
+    TPLFile stone_coal_file;
+    TPL_OpenTPLFromMemory(&stone_coal_file, (void *)stone_coal_tpl, stone_coal_tpl_size);
     GXTexObj stone_coal_texture;
-    TPL_GetTexture(&blocks_tpl, stone_coal, &stone_coal_texture);
+    TPL_GetTexture(&stone_coal_file, 0, &stone_coal_texture);
+
+    // Record cube state block, it uses its own vertex format so it never clashes with the canvas formats
+    GXStateBlock cube_state_block;
+    gxstate_block_begin(&cube_state_block, 512);
+    {
+        // Enable depth test and disable culling
+        gxstate_set_z_mode(GX_ENABLE, GX_LEQUAL, GX_TRUE);
+        gxstate_set_cull_mode(GX_CULL_NONE);
+
+        // Set vertex pipeline
+        gxstate_clear_vtx_desc();
+        gxstate_set_vtx_desc(GX_VA_POS, GX_DIRECT);
+        gxstate_set_vtx_desc(GX_VA_TEX0, GX_DIRECT);
+        gxstate_set_vtx_attr_fmt(GX_VTXFMT2, GX_VA_POS, GX_POS_XYZ, GX_F32, 0);
+        gxstate_set_vtx_attr_fmt(GX_VTXFMT2, GX_VA_TEX0, GX_TEX_ST, GX_F32, 0);
+        gxstate_set_num_chans(1);
+        gxstate_set_num_tex_gens(1);
+        gxstate_set_tex_coord_gen(GX_TEXCOORD0, GX_TG_MTX2x4, GX_TG_TEX0, GX_IDENTITY);
+        // One stage that replaces with the texture, undoing whatever the text stages left behind
+        gxstate_set_num_tev_stages(1);
+        gxstate_set_tev_order(GX_TEVSTAGE0, GX_TEXCOORD0, GX_TEXMAP0, GX_COLOR0A0);
+        gxstate_set_tev_op(GX_TEVSTAGE0, GX_REPLACE);
+        gxstate_set_tev_alpha_op(GX_TEVSTAGE0, GX_TEV_ADD, GX_TB_ZERO, GX_CS_SCALE_1, GX_TRUE, GX_TEVPREV);
+        gxstate_set_tev_k_alpha_sel(GX_TEVSTAGE0, GX_TEV_KASEL_1);
+        gxstate_set_alpha_compare(GX_ALWAYS, 0, GX_AOP_AND, GX_ALWAYS, 0);
+    }
+    gxstate_block_end(&cube_state_block);
+
+    // Display list for static text
+    CanvasList quick_fox_list;
+    canvas_list_init(&quick_fox_list, 4 * 1024);
 
     // Game state
     float rotation = 0;
+    CanvasStats canvas_stats = {0};
+    uint32_t gxstate_issued = 0;
+    uint32_t gxstate_elided = 0;
+    uint32_t cursor_tint_indices[4] = {0};
 
     // Game loop
     while (running) {
         // Update
         rotation += 1;
+        gxstate_reset_stats();
 
         // Read buttons
         cursor_update();
@@ -106,6 +155,15 @@ int main(void) {
             Cursor *cursor = &cursors[i];
             if (cursor->enabled) {
                 if (cursor->buttons_down & WPAD_BUTTON_HOME) running = false;
+                if (cursor->buttons_down & WPAD_BUTTON_A) canvas.batching = !canvas.batching;
+                if (cursor->buttons_down & WPAD_BUTTON_B) canvas.deferred = !canvas.deferred;
+                if (cursor->buttons_down & WPAD_BUTTON_1) canvas.indexed = !canvas.indexed;
+                if (cursor->buttons_down & WPAD_BUTTON_2) canvas.compact = !canvas.compact;
+                if (cursor->buttons_down & WPAD_BUTTON_PLUS) canvas.sdf = !canvas.sdf;
+                if (cursor->buttons_down & WPAD_BUTTON_MINUS) {
+                    cursor_tint_indices[i] = (cursor_tint_indices[i] + 1) % 4;
+                    cursor_set_tint(i, cursor_tints[cursor_tint_indices[i]]);
+                }
             }
         }
 
@@ -116,36 +174,21 @@ int main(void) {
             guPerspective(perspective_matrix, 45, (float)screenmode->viWidth / (float)screenmode->viHeight, 0.1, 1000);
             GX_LoadProjectionMtx(perspective_matrix, GX_PERSPECTIVE);
 
-            // Enable depth test and disable culling
-            GX_SetZMode(GX_ENABLE, GX_LEQUAL, GX_TRUE);
-            GX_SetCullMode(GX_CULL_NONE);
-
-            // Set vertex pipeline
-            GX_ClearVtxDesc();
-            GX_SetVtxDesc(GX_VA_POS, GX_DIRECT);
-            GX_SetVtxDesc(GX_VA_TEX0, GX_DIRECT);
-            GX_SetVtxAttrFmt(GX_VTXFMT0, GX_VA_POS, GX_POS_XYZ, GX_F32, 0);
-            GX_SetVtxAttrFmt(GX_VTXFMT0, GX_VA_TEX0, GX_TEX_ST, GX_F32, 0);
-            GX_SetNumChans(1);
-            GX_SetNumTexGens(1);
-            GX_SetTexCoordGen(GX_TEXCOORD0, GX_TG_MTX2x4, GX_TG_TEX0, GX_IDENTITY);
-            GX_SetTevOrder(GX_TEVSTAGE0, GX_TEXCOORD0, GX_TEXMAP0, GX_COLOR0A0);
-            GX_SetTevOp(GX_TEVSTAGE0, GX_REPLACE);
+            // Set cube state
+            gxstate_block_apply(&cube_state_block);
 
             // Load texture
-            GX_LoadTexObj(&stone_coal_texture, GX_TEXMAP0);
+            gxstate_load_tex_obj(&stone_coal_texture, GX_TEXMAP0);
 
-            // Set cube matrix
+            // Set cube matrix, the x and y rotations use the same angle so sin and cos are computed once
+            float rotation_sin = sinf(DegToRad(rotation));
+            float rotation_cos = cosf(DegToRad(rotation));
             Mtx cube_matrix;
-            guMtxRotDeg(cube_matrix, 'x', rotation);
-            Mtx temp_matrix;
-            guMtxRotDeg(temp_matrix, 'y', rotation);
-            guMtxConcat(cube_matrix, temp_matrix, cube_matrix);
-            guMtxTransApply(cube_matrix, cube_matrix, 0, 0, -8);
+            matrix_rotation_xy(cube_matrix, rotation_sin, rotation_cos, rotation_sin, rotation_cos, 0, 0, -8);
             GX_LoadPosMtxImm(cube_matrix, GX_PNMTX0);
 
             // Draw cube
-            GX_Begin(GX_QUADS, GX_VTXFMT0, 24);
+            gxstate_begin(GX_QUADS, GX_VTXFMT2, 24);
             GX_Position3f32(-1.0f, 1.0f, -1.0f);
             GX_TexCoord2f32(0.0f, 0.0f);
             GX_Position3f32(-1.0f, 1.0f, 1.0f);
@@ -215,18 +258,48 @@ int main(void) {
         guMtxIdentity(canvas.transform_matrix);
 
         float y = 8;
-        canvas_fill_text(u8"Hello Wii 🏠!", 8, y, 64, 0xffffffff);
+        canvas_fill_text_id(FONT_STRING_HELLO, 8, y, 64, 0xffffffff);
         y += 64 + 8;
-        canvas_fill_text("The quick brown fox jumps over the lazy dog.", 8, y, 24, 0xff0000ff);
+        Mtx offset_matrix;
+        guMtxTrans(offset_matrix, 8, y, 0);
+        if (canvas_record_begin(&quick_fox_list, FONT_STRING_QUICK_FOX, offset_matrix)) {
+            canvas_fill_text_id(FONT_STRING_QUICK_FOX, 0, 0, 24, 0xff0000ff);
+            canvas_record_end(&quick_fox_list);
+        }
+        canvas_call_list(&quick_fox_list);
+        y += 24 + 8;
+        canvas_fill_text(u8"Ça fait plaisir, señor: grüße aus Ålesund, ½ æøå!", 8, y, 24, 0xffff00ff);
         y += 24 + 8;
 
-        char debug_string[255];
-        sprintf(debug_string, "framebuffer=%dx%d viewport=%dx%d", screenmode->fbWidth, screenmode->xfbHeight,
-                screenmode->viWidth, screenmode->viHeight);
-        canvas_fill_text(debug_string, 8, y, 24, 0xffffffff);
+        canvas_fill_textf(8, y, 24, 0xffffffff, "framebuffer=%dx%d viewport=%dx%d font_memory=%dKB",
+                          screenmode->fbWidth, screenmode->xfbHeight, screenmode->viWidth, screenmode->viHeight,
+                          (int)((canvas.sdf ? canvas.font_sdf_memory : canvas.font_memory) / 1024));
+        y += 24 + 8;
+
+        // Show canvas stats of the previous frame
+        canvas_fill_textf(8, y, 24, 0xffffffff, "batching=%s deferred=%s draw_calls=%d matrix_loads=%d fifo_bytes=%d",
+                          canvas.batching ? "on" : "off", canvas.deferred ? "on" : "off",
+                          (int)canvas_stats.draw_calls, (int)canvas_stats.matrix_loads, (int)canvas_stats.fifo_bytes);
+        y += 24 + 8;
+        canvas_fill_textf(8, y, 24, 0xffffffff, "indexed=%s compact=%s sdf=%s texture_loads=%d texture_loads_saved=%d",
+                          canvas.indexed ? "on" : "off", canvas.compact ? "on" : "off", canvas.sdf ? "on" : "off",
+                          (int)canvas_stats.texture_loads, (int)canvas_stats.texture_loads_saved);
+        y += 24 + 8;
+        canvas_fill_textf(8, y, 24, 0xffffffff,
+                          "gx_state_issued=%d gx_state_elided=%d text_cache_hits=%d text_cache_misses=%d",
+                          (int)gxstate_issued, (int)gxstate_elided, (int)canvas_stats.text_cache_hits,
+                          (int)canvas_stats.text_cache_misses);
+        y += 24 + 8;
+        canvas_fill_textf(8, y, 24, 0xffffffff,
+                          "glyph_cache_pages=%d glyph_cache_queued=%d glyphs_rasterized=%d pages_evicted=%d",
+                          (int)glyph_cache.pages_size, (int)glyph_cache.queue_size, (int)glyph_cache.rasterized,
+                          (int)glyph_cache.evicted);
 
         cursor_render();
         canvas_end();
+        canvas_stats = canvas.stats;
+        gxstate_issued = gxstate.issued;
+        gxstate_elided = gxstate.elided;
 
         // Set clear color for next frame
         GX_SetCopyClear((GXColor){128, 128, 128, 255}, GX_MAX_Z24);
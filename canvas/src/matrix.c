@@ -0,0 +1,85 @@
+#include "matrix.h"
+
+#include <math.h>
+
+#ifndef GEKKO
+// The paired singles multiply adds are fused, fmaf rounds the same where it is an instruction. Elsewhere the fallback
+// rounds the product too, within an ulp of the largest product and much faster than a library fmaf.
+static inline float matrix_madd(float a, float b, float c) {
+#ifdef FP_FAST_FMAF
+    return fmaf(a, b, c);
+#else
+    return a * b + c;
+#endif
+}
+#endif
+
+void matrix_concat(Mtx a, Mtx b, Mtx ab) {
+#ifdef GEKKO
+    // libogc already ships a paired singles concat, it is just not the default guMtxConcat
+    ps_guMtxConcat(a, b, ab);
+#else
+    // Multiply adds in the order of the paired singles
+    Mtx temp;
+    for (int32_t row = 0; row < 3; row++) {
+        for (int32_t column = 0; column < 4; column++) {
+            float sum = matrix_madd(a[row][1], b[1][column], a[row][0] * b[0][column]);
+            temp[row][column] = matrix_madd(a[row][2], b[2][column], sum);
+        }
+        temp[row][3] += a[row][3];
+    }
+    for (int32_t row = 0; row < 3; row++) {
+        for (int32_t column = 0; column < 4; column++) {
+            ab[row][column] = temp[row][column];
+        }
+    }
+#endif
+}
+
+void matrix_rotation_xy(Mtx m, float sin_x, float cos_x, float sin_y, float cos_y, float x, float y, float z) {
+    // Same as concatenating the x and y rotations of guMtxRotRad and applying a translation
+    m[0][0] = cos_y;
+    m[0][1] = 0;
+    m[0][2] = sin_y;
+    m[0][3] = x;
+    m[1][0] = sin_x * sin_y;
+    m[1][1] = cos_x;
+    m[1][2] = -sin_x * cos_y;
+    m[1][3] = y;
+    m[2][0] = -cos_x * sin_y;
+    m[2][1] = sin_x;
+    m[2][2] = cos_x * cos_y;
+    m[2][3] = z;
+}
+
+void matrix_transform_points_2d(Mtx m, const float *src, float *dst, uint32_t count) {
+    // Transform xy pairs with the first two rows, as column pairs: dst = column0 * x + column1 * y + column3
+    if (count == 0) return;
+#ifdef GEKKO
+    float columns[6] __attribute__((aligned(8))) = {m[0][0], m[1][0], m[0][1], m[1][1], m[0][3], m[1][3]};
+    __asm__ volatile(
+        "psq_l 2, 0(%[columns]), 0, 0\n"
+        "psq_l 3, 8(%[columns]), 0, 0\n"
+        "psq_l 4, 16(%[columns]), 0, 0\n"
+        "mtctr %[count]\n"
+        "1:\n"
+        "psq_l 0, 0(%[src]), 0, 0\n"
+        "ps_madds0 1, 2, 0, 4\n"
+        "ps_madds1 1, 3, 0, 1\n"
+        "psq_st 1, 0(%[dst]), 0, 0\n"
+        "addi %[src], %[src], 8\n"
+        "addi %[dst], %[dst], 8\n"
+        "bdnz 1b\n"
+        : [src] "+b"(src), [dst] "+b"(dst)
+        : [columns] "b"(columns), [count] "r"(count)
+        : "fr0", "fr1", "fr2", "fr3", "fr4", "ctr", "memory");
+#else
+    // Columns are loaded once like the paired singles do, dst could alias m as far as the compiler knows
+    float m00 = m[0][0], m01 = m[0][1], m03 = m[0][3], m10 = m[1][0], m11 = m[1][1], m13 = m[1][3];
+    for (uint32_t i = 0; i < count; i++) {
+        float x = src[i * 2], y = src[i * 2 + 1];
+        dst[i * 2] = matrix_madd(m01, y, matrix_madd(m00, x, m03));
+        dst[i * 2 + 1] = matrix_madd(m11, y, matrix_madd(m10, x, m13));
+    }
+#endif
+}
@@ -1,26 +1,275 @@
 #include "texture.h"
 
 #include <malloc.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
 
+#include "cmpr.h"
 #include "stb_image.h"
 
+// Loads a pixel stored as R, G, B, A bytes as 0xAARRGGBB
+static inline uint32_t texture_load_argb(const uint8_t *pixel) {
+    uint32_t value;
+    memcpy(&value, pixel, 4);
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return (value >> 8) | (value << 24);
+#else
+    return (value & 0xff00ff00) | ((value >> 16) & 0xff) | ((value & 0xff) << 16);
+#endif
+}
+
+// Stores a word with its most significant byte first, the order GX reads texels in
+static inline void texture_store_be32(uint32_t *dst, uint32_t value) {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    *dst = value;
+#else
+    *dst = __builtin_bswap32(value);
+#endif
+}
+
+static void texture_swizzle_rgba8_tile(const uint8_t *rows[4], uint32_t *dst) {
+    // An RGBA8 tile is 32 bytes of AR pairs followed by 32 bytes of GB pairs, each word holds two texels
+    for (int32_t ry = 0; ry < 4; ry++) {
+        uint32_t p0 = texture_load_argb(rows[ry]);
+        uint32_t p1 = texture_load_argb(rows[ry] + 4);
+        uint32_t p2 = texture_load_argb(rows[ry] + 8);
+        uint32_t p3 = texture_load_argb(rows[ry] + 12);
+        texture_store_be32(&dst[ry * 2], (p0 & 0xffff0000) | (p1 >> 16));
+        texture_store_be32(&dst[ry * 2 + 1], (p2 & 0xffff0000) | (p3 >> 16));
+        texture_store_be32(&dst[8 + ry * 2], (p0 << 16) | (p1 & 0xffff));
+        texture_store_be32(&dst[8 + ry * 2 + 1], (p2 << 16) | (p3 & 0xffff));
+    }
+}
+
 uint8_t *texture_convert_rgba8(uint8_t *src, int32_t width, int32_t height) {
-    uint8_t *dst = memalign(32, height * width * 4);
-    int32_t pos = 0;
+    // Tiles past the image edge are padded with transparent black, GX rounds the texture up to whole tiles
+    int32_t tiles_width = (width + 3) / 4, tiles_height = (height + 3) / 4;
+    uint32_t *dst = memalign(32, tiles_width * tiles_height * 64);
+    uint32_t *tile = dst;
     for (int32_t y = 0; y < height; y += 4) {
-        for (int32_t x = 0; x < width; x += 4) {
-            for (int32_t ry = 0; ry < 4; ry++) {
-                for (int32_t rx = 0; rx < 4; rx++) {
-                    int32_t offset = ((y + ry) * width + (x + rx)) * 4;
-                    dst[pos++] = src[offset + 3];  // alpha
-                    dst[pos++] = src[offset];      // red
+        int32_t x = 0;
+        if (y + 4 <= height) {
+            const uint8_t *rows[4];
+            for (int32_t ry = 0; ry < 4; ry++) rows[ry] = &src[(y + ry) * width * 4];
+            for (; x + 4 <= width; x += 4, tile += 16) {
+                texture_swizzle_rgba8_tile(rows, tile);
+                for (int32_t ry = 0; ry < 4; ry++) rows[ry] += 16;
+            }
+        }
+
+        // Partial tiles on the right and bottom edges are copied out first, so nothing is read past the image
+        for (; x < width; x += 4, tile += 16) {
+            uint8_t padded[4][16] = {{0}};
+            const uint8_t *padded_rows[4] = {padded[0], padded[1], padded[2], padded[3]};
+            int32_t copy_width = width - x < 4 ? width - x : 4;
+            for (int32_t ry = 0; ry < 4 && y + ry < height; ry++) {
+                memcpy(padded[ry], &src[((y + ry) * width + x) * 4], copy_width * 4);
+            }
+            texture_swizzle_rgba8_tile(padded_rows, tile);
+        }
+    }
+    return (uint8_t *)dst;
+}
+
+static uint32_t texture_intensity(const uint8_t *pixel) {
+    return (pixel[0] * 77 + pixel[1] * 150 + pixel[2] * 29) >> 8;
+}
+
+static uint32_t texture_premultiplied_intensity(const uint8_t *pixel) {
+    // Intensity only formats keep the coverage of white images with alpha
+    return (texture_intensity(pixel) * pixel[3] + 127) / 255;
+}
+
+static bool texture_format_tile(uint8_t format, int32_t *tile_width, int32_t *tile_height, int32_t *bits) {
+    switch (format) {
+        case GX_TF_I4:
+        case GX_TF_CI4:
+            *tile_width = 8, *tile_height = 8, *bits = 4;
+            return true;
+        case GX_TF_I8:
+        case GX_TF_IA4:
+        case GX_TF_CI8:
+            *tile_width = 8, *tile_height = 4, *bits = 8;
+            return true;
+        case GX_TF_IA8:
+        case GX_TF_RGB565:
+        case GX_TF_RGB5A3:
+            *tile_width = 4, *tile_height = 4, *bits = 16;
+            return true;
+    }
+    return false;
+}
+
+// Bit replication GX uses to widen a channel of bits to 8 bits
+static int32_t texture_expand(int32_t value, int32_t bits) {
+    int32_t expanded = value << (8 - bits);
+    for (int32_t shift = bits; shift < 8; shift += bits) expanded |= expanded >> shift;
+    return expanded;
+}
+
+// Nearest of the levels of bits to an 8 bit channel
+static uint32_t texture_quantize(uint32_t value, int32_t bits) {
+    return (value * ((1 << bits) - 1) + 127) / 255;
+}
+
+static uint32_t texture_encode_texel(uint8_t format, const uint8_t *pixel) {
+    switch (format) {
+        case GX_TF_I4:
+            return texture_quantize(texture_premultiplied_intensity(pixel), 4);
+        case GX_TF_I8:
+            return texture_premultiplied_intensity(pixel);
+        case GX_TF_IA4:
+            return (texture_quantize(pixel[3], 4) << 4) | texture_quantize(texture_intensity(pixel), 4);
+        case GX_TF_IA8:
+            return (pixel[3] << 8) | texture_intensity(pixel);
+        case GX_TF_RGB565:
+            return (texture_quantize(pixel[0], 5) << 11) | (texture_quantize(pixel[1], 6) << 5) |
+                   texture_quantize(pixel[2], 5);
+        case GX_TF_RGB5A3: {
+            if (pixel[3] >= TEXTURE_RGB5A3_OPAQUE_ALPHA) {
+                // Opaque texels get 5 bits per color channel
+                return 0x8000 | (texture_quantize(pixel[0], 5) << 10) | (texture_quantize(pixel[1], 5) << 5) |
+                       texture_quantize(pixel[2], 5);
+            }
+
+            // Alpha of 7 would be opaque, translucent texels stop at 6
+            uint32_t alpha = texture_quantize(pixel[3], 3);
+            if (alpha == 7) alpha = 6;
+            return (alpha << 12) | (texture_quantize(pixel[0], 4) << 8) | (texture_quantize(pixel[1], 4) << 4) |
+                   texture_quantize(pixel[2], 4);
+        }
+        case GX_TF_CI4:
+        case GX_TF_CI8:
+            return pixel[0];
+    }
+    return 0;
+}
+
+// Channels a format quantizes and their bits, intensity formats write gray pixels the encoder maps back exactly
+static int32_t texture_dither_channels(uint8_t format, const uint8_t *pixel, int32_t values[4], int32_t bits[4]) {
+    switch (format) {
+        case GX_TF_I4:
+            values[0] = texture_premultiplied_intensity(pixel), bits[0] = 4;
+            return 1;
+        case GX_TF_IA4:
+            values[0] = texture_intensity(pixel), bits[0] = 4;
+            values[1] = pixel[3], bits[1] = 4;
+            return 2;
+        case GX_TF_RGB565:
+            values[0] = pixel[0], bits[0] = 5;
+            values[1] = pixel[1], bits[1] = 6;
+            values[2] = pixel[2], bits[2] = 5;
+            return 3;
+        case GX_TF_RGB5A3: {
+            bool opaque = pixel[3] >= TEXTURE_RGB5A3_OPAQUE_ALPHA;
+            for (int32_t i = 0; i < 3; i++) values[i] = pixel[i], bits[i] = opaque ? 5 : 4;
+            values[3] = pixel[3], bits[3] = opaque ? 0 : 3;
+            return 4;
+        }
+    }
+    return 0;
+}
+
+static void texture_dither_store(uint8_t format, uint8_t *pixel, const int32_t values[4]) {
+    switch (format) {
+        case GX_TF_I4:
+            pixel[0] = pixel[1] = pixel[2] = values[0];
+            pixel[3] = 0xff;
+            break;
+        case GX_TF_IA4:
+            pixel[0] = pixel[1] = pixel[2] = values[0];
+            pixel[3] = values[1];
+            break;
+        case GX_TF_RGB565:
+            for (int32_t i = 0; i < 3; i++) pixel[i] = values[i];
+            break;
+        case GX_TF_RGB5A3:
+            for (int32_t i = 0; i < 3; i++) pixel[i] = values[i];
+            if (pixel[3] < TEXTURE_RGB5A3_OPAQUE_ALPHA) pixel[3] = values[3];
+            break;
+    }
+}
+
+void texture_dither(uint8_t *src, int32_t width, int32_t height, uint8_t format, TextureDither dither) {
+    static const uint8_t bayer[4][4] = {{0, 8, 2, 10}, {12, 4, 14, 6}, {3, 11, 1, 9}, {15, 7, 13, 5}};
+    if (dither == TEXTURE_DITHER_NONE) return;
+
+    // Floyd-Steinberg keeps the error of this and the next row, with a texel of margin on both sides
+    int16_t *errors = NULL;
+    int32_t row_size = (width + 2) * 4;
+    if (dither == TEXTURE_DITHER_DIFFUSION) errors = calloc(row_size * 2, sizeof(int16_t));
+    for (int32_t y = 0; y < height; y++) {
+        int16_t *current = errors != NULL ? &errors[(y & 1) * row_size + 4] : NULL;
+        int16_t *next = errors != NULL ? &errors[((y + 1) & 1) * row_size + 4] : NULL;
+        if (next != NULL) memset(next - 4, 0, row_size * sizeof(int16_t));
+        for (int32_t x = 0; x < width; x++) {
+            uint8_t *pixel = &src[(y * width + x) * 4];
+            int32_t values[4], bits[4];
+            int32_t channels = texture_dither_channels(format, pixel, values, bits);
+            for (int32_t c = 0; c < channels; c++) {
+                if (bits[c] == 0) continue;
+                int32_t levels = (1 << bits[c]) - 1;
+                int32_t value = values[c];
+                if (errors != NULL) {
+                    value += current[x * 4 + c] / 16;
+                } else {
+                    value += (2 * bayer[y & 3][x & 3] - 15) * 255 / (levels * 32);
+                }
+                int32_t level = value < 0 ? 0 : value > 255 ? levels : texture_quantize(value, bits[c]);
+
+                // RGB5A3 alpha of 7 would turn the texel opaque
+                if (format == GX_TF_RGB5A3 && c == 3 && level == levels) level--;
+                values[c] = texture_expand(level, bits[c]);
+                if (errors != NULL) {
+                    int32_t error = value - values[c];
+                    current[(x + 1) * 4 + c] += error * 7;
+                    next[(x - 1) * 4 + c] += error * 3;
+                    next[x * 4 + c] += error * 5;
+                    next[(x + 1) * 4 + c] += error;
                 }
             }
-            for (int32_t ry = 0; ry < 4; ry++) {
-                for (int32_t rx = 0; rx < 4; rx++) {
-                    int32_t offset = ((y + ry) * width + (x + rx)) * 4;
-                    dst[pos++] = src[offset + 1];  // green
-                    dst[pos++] = src[offset + 2];  // blue
+            texture_dither_store(format, pixel, values);
+        }
+    }
+    free(errors);
+}
+
+uint8_t *texture_convert_cmpr(uint8_t *src, int32_t width, int32_t height, CmprQuality quality) {
+    uint8_t *dst = memalign(32, cmpr_size(width, height));
+    cmpr_encode(src, width, height, quality, dst);
+    return dst;
+}
+
+uint8_t *texture_convert(uint8_t *src, int32_t width, int32_t height, uint8_t format) {
+    if (format == GX_TF_RGBA8) return texture_convert_rgba8(src, width, height);
+    if (format == GX_TF_CMPR) return texture_convert_cmpr(src, width, height, CMPR_QUALITY_FAST);
+    int32_t tile_width, tile_height, bits;
+    if (!texture_format_tile(format, &tile_width, &tile_height, &bits)) return NULL;
+
+    // Every tile is 32 bytes, tiles past the image edge are padded with zero texels
+    int32_t pixel_size = format == GX_TF_CI4 || format == GX_TF_CI8 ? 1 : 4;
+    int32_t tiles_width = (width + tile_width - 1) / tile_width;
+    int32_t tiles_height = (height + tile_height - 1) / tile_height;
+    uint8_t *dst = memalign(32, tiles_width * tiles_height * 32);
+    uint8_t *texel = dst;
+    for (int32_t y = 0; y < height; y += tile_height) {
+        for (int32_t x = 0; x < width; x += tile_width) {
+            for (int32_t ry = y; ry < y + tile_height; ry++) {
+                for (int32_t rx = x; rx < x + tile_width; rx += bits == 4 ? 2 : 1) {
+                    const uint8_t *pixel = &src[(ry * width + rx) * pixel_size];
+                    uint32_t value = 0;
+                    if (ry < height && rx < width) value = texture_encode_texel(format, pixel);
+                    if (bits == 4) {
+                        uint32_t second = 0;
+                        if (ry < height && rx + 1 < width) second = texture_encode_texel(format, pixel + pixel_size);
+                        *texel++ = (value << 4) | second;
+                    } else if (bits == 8) {
+                        *texel++ = value;
+                    } else {
+                        *texel++ = value >> 8;
+                        *texel++ = value & 0xff;
+                    }
                 }
             }
         }
@@ -28,10 +277,436 @@ uint8_t *texture_convert_rgba8(uint8_t *src, int32_t width, int32_t height) {
     return dst;
 }
 
-void texture_load_png_rgba8(GXTexObj *texture, const uint8_t *data, size_t size) {
+static const char *texture_alpha_names[] = {"no", "1 bit", "full"};
+
+static const char *texture_format_name(uint8_t format) {
+    switch (format) {
+        case GX_TF_I4:
+            return "I4";
+        case GX_TF_I8:
+            return "I8";
+        case GX_TF_IA4:
+            return "IA4";
+        case GX_TF_IA8:
+            return "IA8";
+        case GX_TF_RGB565:
+            return "RGB565";
+        case GX_TF_RGB5A3:
+            return "RGB5A3";
+        case GX_TF_RGBA8:
+            return "RGBA8";
+        case GX_TF_CI4:
+            return "CI4";
+        case GX_TF_CI8:
+            return "CI8";
+        case GX_TF_CMPR:
+            return "CMPR";
+    }
+    return "?";
+}
+
+static void texture_decode_texel(uint8_t format, uint32_t value, uint8_t *pixel) {
+    // As the canvas draws it, I4 is a white coverage mask and the other intensity formats modulate
+    switch (format) {
+        case GX_TF_I4:
+            pixel[0] = pixel[1] = pixel[2] = 0xff;
+            pixel[3] = texture_expand(value, 4);
+            break;
+        case GX_TF_I8:
+            pixel[0] = pixel[1] = pixel[2] = pixel[3] = value;
+            break;
+        case GX_TF_IA4:
+            pixel[0] = pixel[1] = pixel[2] = texture_expand(value & 0xf, 4);
+            pixel[3] = texture_expand(value >> 4, 4);
+            break;
+        case GX_TF_IA8:
+            pixel[0] = pixel[1] = pixel[2] = value & 0xff;
+            pixel[3] = value >> 8;
+            break;
+        case GX_TF_RGB565:
+            pixel[0] = texture_expand(value >> 11, 5);
+            pixel[1] = texture_expand((value >> 5) & 0x3f, 6);
+            pixel[2] = texture_expand(value & 0x1f, 5);
+            pixel[3] = 0xff;
+            break;
+        case GX_TF_RGB5A3:
+            if (value & 0x8000) {
+                pixel[0] = texture_expand((value >> 10) & 0x1f, 5);
+                pixel[1] = texture_expand((value >> 5) & 0x1f, 5);
+                pixel[2] = texture_expand(value & 0x1f, 5);
+                pixel[3] = 0xff;
+            } else {
+                pixel[0] = texture_expand((value >> 8) & 0xf, 4);
+                pixel[1] = texture_expand((value >> 4) & 0xf, 4);
+                pixel[2] = texture_expand(value & 0xf, 4);
+                pixel[3] = texture_expand((value >> 12) & 0x7, 3);
+            }
+            break;
+    }
+}
+
+// Packs a pixel as 0xRRGGBBAA, transparent pixels all become 0 since their color never shows
+static uint32_t texture_pack(const uint8_t *pixel) {
+    if (pixel[3] == 0) return 0;
+    return ((uint32_t)pixel[0] << 24) | (pixel[1] << 16) | (pixel[2] << 8) | pixel[3];
+}
+
+void texture_analyze(const uint8_t *src, int32_t width, int32_t height, TextureAnalysis *analysis) {
+    memset(analysis, 0, sizeof(TextureAnalysis));
+    analysis->gray = true;
+    analysis->alpha = TEXTURE_ALPHA_NONE;
+
+    // Distinct colors go into a small open addressing set until there are too many for a palette
+    uint32_t colors[1 << TEXTURE_ANALYSIS_SET_BITS];
+    bool colors_used[1 << TEXTURE_ANALYSIS_SET_BITS] = {false};
+    for (int32_t i = 0; i < width * height; i++) {
+        const uint8_t *pixel = &src[i * 4];
+        if (pixel[0] != pixel[1] || pixel[1] != pixel[2]) analysis->gray = false;
+        if (pixel[3] != 0 && pixel[3] != 0xff) {
+            analysis->alpha = TEXTURE_ALPHA_FULL;
+        } else if (pixel[3] == 0 && analysis->alpha == TEXTURE_ALPHA_NONE) {
+            analysis->alpha = TEXTURE_ALPHA_BINARY;
+        }
+
+        if (analysis->colors_size <= TEXTURE_ANALYSIS_MAX_COLORS) {
+            uint32_t color = texture_pack(pixel);
+            uint32_t slot = (color * 2654435761u) >> (32 - TEXTURE_ANALYSIS_SET_BITS);
+            while (colors_used[slot] && colors[slot] != color) {
+                slot = (slot + 1) & ((1 << TEXTURE_ANALYSIS_SET_BITS) - 1);
+            }
+            if (!colors_used[slot]) {
+                colors_used[slot] = true;
+                colors[slot] = color;
+                analysis->colors_size++;
+            }
+        }
+
+        // Largest channel error of every quantized format, the color of invisible texels doesn't matter
+        for (uint8_t format = 0; format < TEXTURE_ANALYSIS_FORMATS; format++) {
+            uint8_t decoded[4];
+            texture_decode_texel(format, texture_encode_texel(format, pixel), decoded);
+            for (int32_t c = pixel[3] == 0 && decoded[3] == 0 ? 3 : 0; c < 4; c++) {
+                int32_t error = decoded[c] > pixel[c] ? decoded[c] - pixel[c] : pixel[c] - decoded[c];
+                if (error > analysis->errors[format]) analysis->errors[format] = error;
+            }
+        }
+    }
+}
+
+static float texture_cmpr_psnr(const uint8_t *src, int32_t width, int32_t height) {
+    uint8_t *texels = malloc(cmpr_size(width, height));
+    uint8_t *decoded = malloc(width * height * 4);
+    cmpr_encode(src, width, height, CMPR_QUALITY_FAST, texels);
+    cmpr_decode(texels, width, height, decoded);
+    float error = 0;
+    for (int32_t i = 0; i < width * height * 4; i++) {
+        float delta = (float)src[i] - decoded[i];
+        if ((i & 3) != 3 && src[i | 3] < CMPR_ALPHA_THRESHOLD) continue;
+        error += delta * delta;
+    }
+    free(texels);
+    free(decoded);
+    if (error == 0) return INFINITY;
+    return 10 * log10f(255.0f * 255.0f * width * height * 4 / error);
+}
+
+// TLUT entries hold the texels of the 16 bit format of the same name
+static uint8_t texture_palette_texel_format(uint8_t palette_format) {
+    return palette_format == GX_TL_IA8 ? GX_TF_IA8 : palette_format == GX_TL_RGB565 ? GX_TF_RGB565 : GX_TF_RGB5A3;
+}
+
+static float texture_palette_psnr(const uint8_t *src, int32_t width, int32_t height, uint32_t colors_max) {
+    // Quantized colors as their TLUT entries draw them, invisible texels only count their alpha like for CMPR
+    uint8_t colors[TEXTURE_PALETTE_MAX_COLORS * 4];
+    uint8_t *indices = malloc(width * height);
+    uint32_t colors_size = texture_quantize_palette(src, width, height, colors_max, colors, indices);
+    uint8_t format = texture_palette_texel_format(texture_palette_format(colors, colors_size));
+    for (uint32_t i = 0; i < colors_size; i++) {
+        texture_decode_texel(format, texture_encode_texel(format, &colors[i * 4]), &colors[i * 4]);
+    }
+    float error = 0;
+    for (int32_t i = 0; i < width * height; i++) {
+        const uint8_t *pixel = &src[i * 4], *decoded = &colors[indices[i] * 4];
+        for (int32_t c = pixel[3] == 0 && decoded[3] == 0 ? 3 : 0; c < 4; c++) {
+            float delta = (float)pixel[c] - decoded[c];
+            error += delta * delta;
+        }
+    }
+    free(indices);
+    if (error == 0) return INFINITY;
+    return 10 * log10f(255.0f * 255.0f * width * height * 4 / error);
+}
+
+uint8_t texture_pick_format(const uint8_t *src, int32_t width, int32_t height, const TextureAnalysis *analysis,
+                            uint8_t max_error, float min_psnr, bool palette) {
+    // Formats from the fewest bits per texel up, CMPR is only tried after the exact 4 bit formats and CI8 after the
+    // 8 bit formats that need no TLUT
+    static const uint8_t formats[] = {GX_TF_I4,  GX_TF_CI4, GX_TF_CMPR,   GX_TF_I8,    GX_TF_IA4,
+                                      GX_TF_CI8, GX_TF_IA8, GX_TF_RGB565, GX_TF_RGB5A3};
+
+    // A palette of every color is as exact as the TLUT format texture_palette_format picks for it
+    uint8_t palette_format = analysis->gray                         ? GX_TF_IA8
+                             : analysis->alpha == TEXTURE_ALPHA_NONE ? GX_TF_RGB565
+                                                                     : GX_TF_RGB5A3;
+    for (uint32_t i = 0; i < sizeof(formats); i++) {
+        uint8_t format = formats[i];
+        if (format == GX_TF_CMPR) {
+            if (analysis->alpha != TEXTURE_ALPHA_FULL && texture_cmpr_psnr(src, width, height) >= min_psnr) {
+                return format;
+            }
+        } else if (format == GX_TF_CI4 || format == GX_TF_CI8) {
+            // Images with more colors than the palette holds are quantized and held to min_psnr like CMPR
+            uint32_t colors_max = format == GX_TF_CI4 ? TEXTURE_PALETTE_CI4_COLORS : TEXTURE_PALETTE_MAX_COLORS;
+            if (!palette) continue;
+            if (analysis->colors_size <= colors_max) {
+                if (analysis->errors[palette_format] <= max_error) return format;
+            } else if (texture_palette_psnr(src, width, height, colors_max) >= min_psnr) {
+                return format;
+            }
+        } else if (analysis->errors[format] <= max_error) {
+            return format;
+        }
+    }
+    return GX_TF_RGBA8;
+}
+
+// Range of distinct colors the median cut splits along its widest channel
+typedef struct TextureQuantizeBox {
+    uint32_t start;
+    uint32_t size;
+    uint32_t weight;
+    int32_t channel;
+    uint8_t min;
+    uint8_t max;
+} TextureQuantizeBox;
+
+static uint8_t texture_channel(uint32_t color, int32_t channel) { return color >> (24 - channel * 8); }
+
+static int texture_compare_colors(const void *a, const void *b) {
+    uint32_t first = *(const uint32_t *)a, second = *(const uint32_t *)b;
+    return first < second ? -1 : first > second;
+}
+
+static void texture_box_measure(const uint32_t *colors, const uint32_t *counts, TextureQuantizeBox *box) {
+    uint8_t min[4] = {0xff, 0xff, 0xff, 0xff}, max[4] = {0};
+    box->weight = 0;
+    for (uint32_t i = box->start; i < box->start + box->size; i++) {
+        for (int32_t c = 0; c < 4; c++) {
+            uint8_t value = texture_channel(colors[i], c);
+            if (value < min[c]) min[c] = value;
+            if (value > max[c]) max[c] = value;
+        }
+        box->weight += counts[i];
+    }
+    box->channel = 0;
+    for (int32_t c = 1; c < 4; c++) {
+        if (max[c] - min[c] > max[box->channel] - min[box->channel]) box->channel = c;
+    }
+    box->min = min[box->channel];
+    box->max = max[box->channel];
+}
+
+static uint32_t texture_box_split(uint32_t *colors, uint32_t *counts, const TextureQuantizeBox *box) {
+    // Weighted median of the widest channel, kept below its maximum so both halves get colors
+    uint32_t histogram[256] = {0};
+    uint32_t end = box->start + box->size;
+    for (uint32_t i = box->start; i < end; i++) histogram[texture_channel(colors[i], box->channel)] += counts[i];
+    uint32_t median = box->min, weight = histogram[median];
+    while (median + 1 < box->max && weight < box->weight / 2) weight += histogram[++median];
+
+    // Colors up to the median move to the front
+    uint32_t left = box->start, right = end;
+    while (left < right) {
+        if (texture_channel(colors[left], box->channel) <= median) {
+            left++;
+            continue;
+        }
+        right--;
+        uint32_t color = colors[left], count = counts[left];
+        colors[left] = colors[right], counts[left] = counts[right];
+        colors[right] = color, counts[right] = count;
+    }
+    return left - box->start;
+}
+
+static uint8_t texture_nearest_color(uint32_t color, const uint8_t *palette, uint32_t palette_size) {
+    uint32_t nearest = 0, nearest_distance = UINT32_MAX;
+    for (uint32_t i = 0; i < palette_size; i++) {
+        uint32_t distance = 0;
+        for (int32_t c = 0; c < 4; c++) {
+            int32_t delta = texture_channel(color, c) - palette[i * 4 + c];
+            distance += delta * delta;
+        }
+        if (distance < nearest_distance) {
+            nearest = i;
+            nearest_distance = distance;
+        }
+    }
+    return nearest;
+}
+
+static void texture_palette_means(const uint32_t *colors, const uint32_t *counts, uint32_t colors_size,
+                                  const uint8_t *members, uint8_t *palette, uint32_t palette_size) {
+    // Channel sums and weight of the colors of every palette color, a palette color without any keeps its place
+    uint32_t sums[TEXTURE_PALETTE_MAX_COLORS][5] = {{0}};
+    for (uint32_t i = 0; i < colors_size; i++) {
+        for (int32_t c = 0; c < 4; c++) sums[members[i]][c] += texture_channel(colors[i], c) * counts[i];
+        sums[members[i]][4] += counts[i];
+    }
+    for (uint32_t i = 0; i < palette_size; i++) {
+        if (sums[i][4] == 0) continue;
+        for (int32_t c = 0; c < 4; c++) palette[i * 4 + c] = (sums[i][c] + sums[i][4] / 2) / sums[i][4];
+    }
+}
+
+uint32_t texture_quantize_palette(const uint8_t *src, int32_t width, int32_t height, uint32_t colors_max,
+                                  uint8_t *palette, uint8_t *indices) {
+    // Distinct colors with their pixel counts, a sorted copy lets pixels find their color by binary search
+    int32_t pixels_size = width * height;
+    uint32_t *sorted = malloc(pixels_size * sizeof(uint32_t));
+    uint32_t *colors = malloc(pixels_size * sizeof(uint32_t));
+    uint32_t *counts = malloc(pixels_size * sizeof(uint32_t));
+    uint8_t *members = malloc(pixels_size);
+    for (int32_t i = 0; i < pixels_size; i++) sorted[i] = texture_pack(&src[i * 4]);
+    qsort(sorted, pixels_size, sizeof(uint32_t), texture_compare_colors);
+    uint32_t colors_size = 0;
+    for (int32_t i = 0; i < pixels_size; i++) {
+        if (colors_size > 0 && colors[colors_size - 1] == sorted[i]) {
+            counts[colors_size - 1]++;
+        } else {
+            colors[colors_size] = sorted[i];
+            counts[colors_size++] = 1;
+        }
+    }
+    memcpy(sorted, colors, colors_size * sizeof(uint32_t));
+
+    // Median cut, the box whose widest channel range times pixel count is largest is split next
+    TextureQuantizeBox boxes[TEXTURE_PALETTE_MAX_COLORS];
+    boxes[0] = (TextureQuantizeBox){.start = 0, .size = colors_size};
+    texture_box_measure(colors, counts, &boxes[0]);
+    uint32_t palette_size = 1;
+    while (palette_size < colors_max) {
+        TextureQuantizeBox *widest = NULL;
+        uint32_t widest_score = 0;
+        for (uint32_t i = 0; i < palette_size; i++) {
+            uint32_t score = (boxes[i].max - boxes[i].min) * boxes[i].weight;
+            if (score > widest_score) {
+                widest = &boxes[i];
+                widest_score = score;
+            }
+        }
+        if (widest == NULL) break;
+        uint32_t left_size = texture_box_split(colors, counts, widest);
+        TextureQuantizeBox *right = &boxes[palette_size++];
+        *right = (TextureQuantizeBox){.start = widest->start + left_size, .size = widest->size - left_size};
+        widest->size = left_size;
+        texture_box_measure(colors, counts, widest);
+        texture_box_measure(colors, counts, right);
+    }
+
+    // Boxes start at their mean, then Lloyd passes move every color to the mean of the colors nearest to it
+    for (uint32_t i = 0; i < palette_size; i++) memset(&members[boxes[i].start], i, boxes[i].size);
+    texture_palette_means(colors, counts, colors_size, members, palette, palette_size);
+    for (int32_t pass = 0; pass < TEXTURE_QUANTIZE_PASSES; pass++) {
+        for (uint32_t i = 0; i < colors_size; i++) members[i] = texture_nearest_color(colors[i], palette, palette_size);
+        texture_palette_means(colors, counts, colors_size, members, palette, palette_size);
+    }
+
+    // Every pixel takes the palette color nearest to its own
+    for (uint32_t i = 0; i < colors_size; i++) members[i] = texture_nearest_color(sorted[i], palette, palette_size);
+    for (int32_t i = 0; i < pixels_size; i++) {
+        uint32_t color = texture_pack(&src[i * 4]);
+        uint32_t *found = bsearch(&color, sorted, colors_size, sizeof(uint32_t), texture_compare_colors);
+        indices[i] = members[found - sorted];
+    }
+    free(sorted);
+    free(colors);
+    free(counts);
+    free(members);
+    return palette_size;
+}
+
+uint8_t texture_palette_format(const uint8_t *colors, uint32_t colors_size) {
+    bool gray = true, opaque = true;
+    for (uint32_t i = 0; i < colors_size; i++) {
+        const uint8_t *color = &colors[i * 4];
+        if (color[0] != color[1] || color[1] != color[2]) gray = false;
+        if (color[3] != 0xff) opaque = false;
+    }
+    if (gray) return GX_TL_IA8;
+    return opaque ? GX_TL_RGB565 : GX_TL_RGB5A3;
+}
+
+void texture_palette_init(TexturePalette *palette, uint32_t name, uint8_t format, uint32_t colors_size) {
+    uint32_t entries_size = (colors_size + 15) & ~15;
+    palette->name = name;
+    palette->format = format;
+    palette->colors_size = colors_size;
+    palette->entries = memalign(32, entries_size * 2);
+    memset(palette->entries, 0, entries_size * 2);
+    GX_InitTlutObj(&palette->tlut, palette->entries, format, entries_size);
+}
+
+void texture_palette_set(TexturePalette *palette, const uint8_t *colors) {
+    if (palette->entries == NULL) return;
+    uint8_t format = texture_palette_texel_format(palette->format);
+    for (uint32_t i = 0; i < palette->colors_size; i++) {
+        uint32_t value = texture_encode_texel(format, &colors[i * 4]);
+        palette->entries[i * 2] = value >> 8;
+        palette->entries[i * 2 + 1] = value & 0xff;
+    }
+    DCFlushRange(palette->entries, ((palette->colors_size + 15) & ~15) * 2);
+    GX_LoadTlut(&palette->tlut, palette->name);
+}
+
+// Picks the format of an image loaded with TEXTURE_FORMAT_AUTO and reports why
+static uint8_t texture_pick_auto(const uint8_t *src, int32_t width, int32_t height, bool palette) {
+    TextureAnalysis analysis;
+    texture_analyze(src, width, height, &analysis);
+    uint8_t format = texture_pick_format(src, width, height, &analysis, TEXTURE_AUTO_MAX_ERROR, TEXTURE_AUTO_MIN_PSNR,
+                                         palette);
+    uint32_t rgba8_size = GX_GetTexBufferSize(width, height, GX_TF_RGBA8, GX_FALSE, 0);
+    uint32_t picked_size = GX_GetTexBufferSize(width, height, format, GX_FALSE, 0);
+    SYS_Report("texture: %dx%d %s, %s alpha, %u%s colors, %s saves %u of %u bytes\n", (int)width, (int)height,
+               analysis.gray ? "gray" : "color", texture_alpha_names[analysis.alpha], (unsigned)analysis.colors_size,
+               analysis.colors_size > TEXTURE_ANALYSIS_MAX_COLORS ? "+" : "", texture_format_name(format),
+               (unsigned)(rgba8_size - picked_size), (unsigned)rgba8_size);
+    return format;
+}
+
+// Tiles pixels into format and frees them, the texels are flushed for the GPU
+static uint8_t *texture_convert_flush(uint8_t *src, int32_t width, int32_t height, uint8_t format) {
+    uint8_t *dst = texture_convert(src, width, height, format);
+    free(src);
+    if (dst != NULL) DCFlushRange(dst, GX_GetTexBufferSize(width, height, format, GX_FALSE, 0));
+    return dst;
+}
+
+bool texture_load_png_palette(GXTexObj *texture, TexturePalette *palette, uint32_t tlut_name, uint8_t *colors,
+                              const uint8_t *data, size_t size, uint8_t format) {
     int32_t width, height, channels;
     uint8_t *src = stbi_load_from_memory(data, size, &width, &height, &channels, 4);
-    uint8_t *dst = texture_convert_rgba8(src, width, height);
+    if (src == NULL) return false;
+    if (format == TEXTURE_FORMAT_AUTO) format = texture_pick_auto(src, width, height, true);
+    // Another format leaves no TLUT and no entries behind
+    memset(palette, 0, sizeof(TexturePalette));
+    if (format != GX_TF_CI4 && format != GX_TF_CI8) {
+        uint8_t *dst = texture_convert_flush(src, width, height, format);
+        if (dst == NULL) return false;
+        GX_InitTexObj(texture, dst, width, height, format, GX_CLAMP, GX_CLAMP, GX_FALSE);
+        return true;
+    }
+
+    // Only the indices are tiled, the colors go into the TLUT
+    uint8_t local_colors[TEXTURE_PALETTE_MAX_COLORS * 4];
+    if (colors == NULL) colors = local_colors;
+    uint8_t *indices = malloc(width * height);
+    uint32_t colors_max = format == GX_TF_CI4 ? TEXTURE_PALETTE_CI4_COLORS : TEXTURE_PALETTE_MAX_COLORS;
+    uint32_t colors_size = texture_quantize_palette(src, width, height, colors_max, colors, indices);
     free(src);
-    GX_InitTexObj(texture, dst, width, height, GX_TF_RGBA8, GX_CLAMP, GX_CLAMP, GX_FALSE);
+    texture_palette_init(palette, tlut_name, texture_palette_format(colors, colors_size), colors_size);
+    texture_palette_set(palette, colors);
+    uint8_t *dst = texture_convert_flush(indices, width, height, format);
+    GX_InitTexObjCI(texture, dst, width, height, format, GX_CLAMP, GX_CLAMP, GX_FALSE, tlut_name);
+    return true;
 }
@@ -0,0 +1,476 @@
+#include "truetype.h"
+
+#include <math.h>
+#include <string.h>
+
+#define TRUETYPE_MAX_POINTS 512
+#define TRUETYPE_MAX_DEPTH 4
+
+// Host tools that rasterize on several threads build with TRUETYPE_THREAD_LOCAL=_Thread_local
+#ifndef TRUETYPE_THREAD_LOCAL
+#define TRUETYPE_THREAD_LOCAL
+#endif
+
+// Signed area accumulation buffer with a spare column for the right edge of each row
+static TRUETYPE_THREAD_LOCAL float accumulation[TRUETYPE_MAX_RASTER * (TRUETYPE_MAX_RASTER + 2)];
+
+static uint16_t read_u16(const uint8_t *p) { return (p[0] << 8) | p[1]; }
+
+static int16_t read_i16(const uint8_t *p) { return (int16_t)read_u16(p); }
+
+static uint32_t read_u32(const uint8_t *p) { return ((uint32_t)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3]; }
+
+// True when size bytes at offset are inside the font, every offset read from the font is checked with it
+static bool truetype_fits(const TrueType *font, uint32_t offset, uint32_t size) {
+    return offset <= font->size && size <= font->size - offset;
+}
+
+// Offset of a table of at least min_length bytes that lies inside the font, 0 when there is none
+static uint32_t truetype_find_table(const TrueType *font, const char *tag, uint32_t min_length) {
+    uint16_t num_tables = read_u16(&font->data[4]);
+    for (uint32_t i = 0; i < num_tables && truetype_fits(font, 12 + i * 16, 16); i++) {
+        const uint8_t *record = &font->data[12 + i * 16];
+        if (memcmp(record, tag, 4) != 0) continue;
+        uint32_t offset = read_u32(&record[8]), length = read_u32(&record[12]);
+        return length >= min_length && truetype_fits(font, offset, length) ? offset : 0;
+    }
+    return 0;
+}
+
+static bool truetype_cmap_fits(const TrueType *font, uint32_t subtable, uint16_t format) {
+    // Format 4 has four arrays of segments, format 12 an array of groups
+    if (format == 4) {
+        return truetype_fits(font, subtable, 14) &&
+               truetype_fits(font, subtable + 14, read_u16(&font->data[subtable + 6]) / 2 * 8 + 2);
+    }
+    return truetype_fits(font, subtable, 16) &&
+           read_u32(&font->data[subtable + 12]) <= (font->size - subtable - 16) / 12;
+}
+
+bool truetype_init(TrueType *font, const uint8_t *data, uint32_t size) {
+    memset(font, 0, sizeof(TrueType));
+    if (size < 12) return false;
+    font->data = data;
+    font->size = size;
+    uint32_t head = truetype_find_table(font, "head", 54);
+    uint32_t hhea = truetype_find_table(font, "hhea", 36);
+    uint32_t maxp = truetype_find_table(font, "maxp", 6);
+    uint32_t cmap = truetype_find_table(font, "cmap", 4);
+    font->glyf = truetype_find_table(font, "glyf", 0);
+    font->loca = truetype_find_table(font, "loca", 0);
+    font->hmtx = truetype_find_table(font, "hmtx", 0);
+    font->kern = truetype_find_table(font, "kern", 0);
+    if (head == 0 || hhea == 0 || maxp == 0 || cmap == 0 || font->glyf == 0 || font->loca == 0 || font->hmtx == 0) {
+        return false;
+    }
+    font->units_per_em = read_u16(&data[head + 18]);
+    font->index_to_loc_format = read_i16(&data[head + 50]);
+    font->ascent = read_i16(&data[hhea + 4]);
+    font->descent = read_i16(&data[hhea + 6]);
+    font->line_gap = read_i16(&data[hhea + 8]);
+    font->num_hmetrics = read_u16(&data[hhea + 34]);
+    font->num_glyphs = read_u16(&data[maxp + 4]);
+
+    // Glyph lookups only check the glyph index, so the loca and hmtx entries of every glyph must be in the font
+    uint32_t loca_size = (font->num_glyphs + 1) * (font->index_to_loc_format == 0 ? 2 : 4);
+    if (font->num_hmetrics == 0 || !truetype_fits(font, font->hmtx, font->num_hmetrics * 4) ||
+        !truetype_fits(font, font->loca, loca_size)) {
+        return false;
+    }
+
+    // A kern table whose pairs don't fit is ignored
+    if (font->kern != 0 && (!truetype_fits(font, font->kern, 18) ||
+                            !truetype_fits(font, font->kern + 18, read_u16(&data[font->kern + 10]) * 6))) {
+        font->kern = 0;
+    }
+
+    // Prefer a full Unicode format 12 table over a BMP format 4 one
+    uint16_t num_subtables = read_u16(&data[cmap + 2]);
+    for (uint32_t i = 0; i < num_subtables && truetype_fits(font, cmap + 4 + i * 8, 8); i++) {
+        const uint8_t *record = &data[cmap + 4 + i * 8];
+        uint16_t platform = read_u16(&record[0]);
+        uint16_t encoding = read_u16(&record[2]);
+        if (platform != 0 && !(platform == 3 && (encoding == 1 || encoding == 10))) continue;
+        if (read_u32(&record[4]) > size - cmap) continue;
+        uint32_t subtable = cmap + read_u32(&record[4]);
+        if (!truetype_fits(font, subtable, 2)) continue;
+        uint16_t format = read_u16(&data[subtable]);
+        if ((format != 4 && format != 12) || !truetype_cmap_fits(font, subtable, format)) continue;
+        if (format == 12 || font->cmap_format != 12) {
+            font->cmap = subtable;
+            font->cmap_format = format;
+        }
+    }
+    return font->cmap != 0;
+}
+
+uint16_t truetype_find_glyph(TrueType *font, uint32_t code_point) {
+    const uint8_t *data = font->data;
+    uint32_t cmap = font->cmap;
+    if (font->cmap_format == 12) {
+        // Binary search the sequential map groups
+        uint32_t low = 0, high = read_u32(&data[cmap + 12]);
+        while (low < high) {
+            uint32_t middle = (low + high) / 2;
+            const uint8_t *group = &data[cmap + 16 + middle * 12];
+            if (code_point < read_u32(&group[0])) {
+                high = middle;
+            } else if (code_point > read_u32(&group[4])) {
+                low = middle + 1;
+            } else {
+                return read_u32(&group[8]) + code_point - read_u32(&group[0]);
+            }
+        }
+        return 0;
+    }
+
+    // Binary search the segments by their end code
+    if (code_point > 0xffff) return 0;
+    uint16_t seg_count = read_u16(&data[cmap + 6]) / 2;
+    uint32_t end_codes = cmap + 14;
+    uint32_t start_codes = end_codes + seg_count * 2 + 2;
+    uint32_t id_deltas = start_codes + seg_count * 2;
+    uint32_t id_range_offsets = id_deltas + seg_count * 2;
+    uint32_t low = 0, high = seg_count;
+    while (low < high) {
+        uint32_t middle = (low + high) / 2;
+        if (read_u16(&data[end_codes + middle * 2]) < code_point) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low == seg_count) return 0;
+    uint16_t start_code = read_u16(&data[start_codes + low * 2]);
+    if (code_point < start_code) return 0;
+    uint16_t id_delta = read_u16(&data[id_deltas + low * 2]);
+    uint16_t id_range_offset = read_u16(&data[id_range_offsets + low * 2]);
+    if (id_range_offset == 0) return (code_point + id_delta) & 0xffff;
+    uint32_t offset = id_range_offsets + low * 2 + id_range_offset + (code_point - start_code) * 2;
+    if (!truetype_fits(font, offset, 2)) return 0;
+    uint16_t glyph = read_u16(&data[offset]);
+    return glyph != 0 ? (glyph + id_delta) & 0xffff : 0;
+}
+
+int32_t truetype_get_advance(TrueType *font, uint16_t glyph) {
+    if (glyph >= font->num_hmetrics) glyph = font->num_hmetrics - 1;
+    return read_u16(&font->data[font->hmtx + glyph * 4]);
+}
+
+int32_t truetype_get_kerning(TrueType *font, uint16_t left, uint16_t right) {
+    // Only the first subtable of a version 0 kern table is read, when it is a horizontal format 0 pair list
+    const uint8_t *data = font->data;
+    uint32_t kern = font->kern;
+    if (kern == 0 || read_u16(&data[kern]) != 0 || read_u16(&data[kern + 2]) == 0) return 0;
+    uint16_t coverage = read_u16(&data[kern + 8]);
+    if ((coverage >> 8) != 0 || (coverage & 0x7) != 1) return 0;
+
+    // Binary search the pairs, they are sorted by left and right glyph together
+    uint32_t key = ((uint32_t)left << 16) | right;
+    uint32_t low = 0, high = read_u16(&data[kern + 10]);
+    while (low < high) {
+        uint32_t middle = (low + high) / 2;
+        const uint8_t *pair = &data[kern + 18 + middle * 6];
+        uint32_t pair_key = read_u32(pair);
+        if (pair_key < key) {
+            low = middle + 1;
+        } else if (pair_key > key) {
+            high = middle;
+        } else {
+            return read_i16(&pair[4]);
+        }
+    }
+    return 0;
+}
+
+static uint32_t truetype_glyph_offset(TrueType *font, uint16_t glyph, uint32_t *length) {
+    if (glyph >= font->num_glyphs) {
+        *length = 0;
+        return 0;
+    }
+    const uint8_t *loca = &font->data[font->loca];
+    uint32_t start, end;
+    if (font->index_to_loc_format == 0) {
+        start = read_u16(&loca[glyph * 2]) * 2;
+        end = read_u16(&loca[glyph * 2 + 2]) * 2;
+    } else {
+        start = read_u32(&loca[glyph * 4]);
+        end = read_u32(&loca[glyph * 4 + 4]);
+    }
+    // Glyphs that don't fit in the font or are too short for their header are empty
+    *length = start < end && end <= font->size - font->glyf && end - start >= 10 ? end - start : 0;
+    return font->glyf + start;
+}
+
+bool truetype_get_box(TrueType *font, uint16_t glyph, float scale, TrueTypeBox *box) {
+    uint32_t length;
+    uint32_t offset = truetype_glyph_offset(font, glyph, &length);
+    if (length == 0) return false;
+    const uint8_t *header = &font->data[offset];
+    box->x0 = (int32_t)floorf(read_i16(&header[2]) * scale);
+    box->y0 = (int32_t)floorf(-read_i16(&header[8]) * scale);
+    box->x1 = (int32_t)ceilf(read_i16(&header[6]) * scale);
+    box->y1 = (int32_t)ceilf(-read_i16(&header[4]) * scale);
+    return box->x1 > box->x0 && box->y1 > box->y0;
+}
+
+typedef struct TrueTypeRaster {
+    int32_t width;
+    int32_t height;
+} TrueTypeRaster;
+
+static void truetype_draw_line(TrueTypeRaster *raster, float x0, float y0, float x1, float y1) {
+    // Signed area coverage of one line segment, as in the font-rs accumulation rasterizer
+    if (y0 == y1) return;
+    float direction = 1;
+    if (y0 > y1) {
+        direction = -1;
+        float temp = x0;
+        x0 = x1;
+        x1 = temp;
+        temp = y0;
+        y0 = y1;
+        y1 = temp;
+    }
+    float dxdy = (x1 - x0) / (y1 - y0);
+    float x = x0;
+    if (y0 < 0) {
+        x -= y0 * dxdy;
+        y0 = 0;
+    }
+    if (y1 > raster->height) y1 = raster->height;
+    int32_t stride = raster->width + 2;
+    for (int32_t y = (int32_t)y0; y < y1; y++) {
+        float *row = &accumulation[y * stride];
+        float dy = (y + 1 < y1 ? y + 1 : y1) - (y > y0 ? y : y0);
+        float x_next = x + dxdy * dy;
+        float d = dy * direction;
+        float left = x < x_next ? x : x_next;
+        float right = x < x_next ? x_next : x;
+        // Points can lie outside the box the glyph header claims, clamp both ends to the raster
+        if (left < 0) left = 0;
+        if (left > raster->width) left = raster->width;
+        if (right < 0) right = 0;
+        if (right > raster->width) right = raster->width;
+        float left_floor = floorf(left);
+        int32_t left_index = (int32_t)left_floor;
+        float right_ceil = ceilf(right);
+        int32_t right_index = (int32_t)right_ceil;
+        if (right_index <= left_index + 1) {
+            float middle = 0.5f * (left + right) - left_floor;
+            row[left_index] += d - d * middle;
+            row[left_index + 1] += d * middle;
+        } else {
+            float s = 1.0f / (right - left);
+            float left_fraction = left - left_floor;
+            float a0 = 0.5f * s * (1 - left_fraction) * (1 - left_fraction);
+            float right_fraction = right - right_ceil + 1;
+            float am = 0.5f * s * right_fraction * right_fraction;
+            row[left_index] += d * a0;
+            if (right_index == left_index + 2) {
+                row[left_index + 1] += d * (1 - a0 - am);
+            } else {
+                float a1 = s * (1.5f - left_fraction);
+                row[left_index + 1] += d * (a1 - a0);
+                for (int32_t i = left_index + 2; i < right_index - 1; i++) row[i] += d * s;
+                float a2 = a1 + (right_index - left_index - 3) * s;
+                row[right_index - 1] += d * (1 - a2 - am);
+            }
+            row[right_index] += d * am;
+        }
+        x = x_next;
+    }
+}
+
+static void truetype_draw_curve(TrueTypeRaster *raster, float x0, float y0, float cx, float cy, float x1, float y1) {
+    // Flatten quadratic curves into lines that stay within a fortieth of a pixel of the curve
+    float dx = x0 - 2 * cx + x1, dy = y0 - 2 * cy + y1;
+    int32_t steps = 1 + (int32_t)sqrtf(sqrtf(dx * dx + dy * dy) * 10.0f);
+    if (steps > 16) steps = 16;
+    float previous_x = x0, previous_y = y0;
+    for (int32_t i = 1; i <= steps; i++) {
+        float t = (float)i / steps;
+        float u = 1 - t;
+        float x = u * u * x0 + 2 * u * t * cx + t * t * x1;
+        float y = u * u * y0 + 2 * u * t * cy + t * t * y1;
+        truetype_draw_line(raster, previous_x, previous_y, x, y);
+        previous_x = x;
+        previous_y = y;
+    }
+}
+
+static void truetype_draw_glyph(TrueType *font, TrueTypeRaster *raster, uint16_t glyph, float m[6], uint32_t depth) {
+    uint32_t length;
+    uint32_t offset = truetype_glyph_offset(font, glyph, &length);
+    if (length == 0 || depth > TRUETYPE_MAX_DEPTH) return;
+    const uint8_t *data = &font->data[offset];
+    int16_t num_contours = read_i16(data);
+
+    // Compound glyphs draw their components with an extra transform, reads stop at the end of the glyph
+    uint32_t at = 10;
+    if (num_contours < 0) {
+        uint16_t flags;
+        do {
+            if (at + 4 > length) return;
+            flags = read_u16(&data[at]);
+            uint16_t component = read_u16(&data[at + 2]);
+            at += 4;
+            uint32_t arguments_size = (flags & 1) ? 4 : 2;
+            uint32_t transform_size = (flags & 8) ? 2 : (flags & 0x40) ? 4 : (flags & 0x80) ? 8 : 0;
+            if (at + arguments_size + transform_size > length) return;
+            const uint8_t *p = &data[at];
+            at += arguments_size + transform_size;
+            float dx, dy;
+            if (flags & 1) {
+                dx = read_i16(p);
+                dy = read_i16(&p[2]);
+                p += 4;
+            } else {
+                dx = (int8_t)p[0];
+                dy = (int8_t)p[1];
+                p += 2;
+            }
+            float a = 1, b = 0, c = 0, d = 1;
+            if (flags & 8) {
+                a = d = read_i16(p) / 16384.0f;
+            } else if (flags & 0x40) {
+                a = read_i16(p) / 16384.0f;
+                d = read_i16(&p[2]) / 16384.0f;
+            } else if (flags & 0x80) {
+                a = read_i16(p) / 16384.0f;
+                b = read_i16(&p[2]) / 16384.0f;
+                c = read_i16(&p[4]) / 16384.0f;
+                d = read_i16(&p[6]) / 16384.0f;
+            }
+            // Point matching offsets are not supported, those components are placed at the origin
+            if ((flags & 2) == 0) dx = dy = 0;
+            float cm[6] = {m[0] * a + m[2] * b, m[1] * a + m[3] * b, m[0] * c + m[2] * d,
+                           m[1] * c + m[3] * d, m[0] * dx + m[2] * dy + m[4], m[1] * dx + m[3] * dy + m[5]};
+            truetype_draw_glyph(font, raster, component, cm, depth + 1);
+        } while (flags & 0x20);
+        return;
+    }
+
+    // Decode simple glyph points, the end points and the instruction length come first
+    const uint8_t *end_points = &data[10];
+    at += num_contours * 2 + 2;
+    if (at > length) return;
+    uint32_t num_points = num_contours > 0 ? read_u16(&end_points[(num_contours - 1) * 2]) + 1 : 0;
+    if (num_points > TRUETYPE_MAX_POINTS) return;
+    at += read_u16(&data[at - 2]);
+    uint8_t flags[TRUETYPE_MAX_POINTS];
+    for (uint32_t i = 0; i < num_points;) {
+        if (at >= length) return;
+        uint8_t flag = data[at++];
+        uint32_t repeat = 0;
+        if (flag & 8) {
+            if (at >= length) return;
+            repeat = data[at++];
+        }
+        for (uint32_t r = 0; r <= repeat && i < num_points; r++) flags[i++] = flag;
+    }
+    float xs[TRUETYPE_MAX_POINTS], ys[TRUETYPE_MAX_POINTS];
+    int32_t value = 0;
+    for (uint32_t i = 0; i < num_points; i++) {
+        if (flags[i] & 2) {
+            if (at + 1 > length) return;
+            value += (flags[i] & 16) ? data[at] : -data[at];
+            at++;
+        } else if ((flags[i] & 16) == 0) {
+            if (at + 2 > length) return;
+            value += read_i16(&data[at]);
+            at += 2;
+        }
+        xs[i] = value;
+    }
+    value = 0;
+    for (uint32_t i = 0; i < num_points; i++) {
+        if (flags[i] & 4) {
+            if (at + 1 > length) return;
+            value += (flags[i] & 32) ? data[at] : -data[at];
+            at++;
+        } else if ((flags[i] & 32) == 0) {
+            if (at + 2 > length) return;
+            value += read_i16(&data[at]);
+            at += 2;
+        }
+        ys[i] = value;
+    }
+    for (uint32_t i = 0; i < num_points; i++) {
+        float x = xs[i], y = ys[i];
+        xs[i] = m[0] * x + m[2] * y + m[4];
+        ys[i] = m[1] * x + m[3] * y + m[5];
+    }
+
+    // Walk each contour, two off curve points in a row have an implied on curve point between them
+    uint32_t start = 0;
+    for (int32_t contour = 0; contour < num_contours; contour++) {
+        uint32_t end = read_u16(&end_points[contour * 2]);
+        if (end < start || end >= num_points) return;
+        uint32_t count = end - start + 1;
+        uint32_t first = start;
+        float start_x, start_y;
+        if (flags[first] & 1) {
+            start_x = xs[first];
+            start_y = ys[first];
+        } else if (flags[end] & 1) {
+            start_x = xs[end];
+            start_y = ys[end];
+        } else {
+            start_x = (xs[first] + xs[end]) / 2;
+            start_y = (ys[first] + ys[end]) / 2;
+        }
+        float x = start_x, y = start_y;
+        bool has_control = false;
+        float control_x = 0, control_y = 0;
+        for (uint32_t j = 0; j <= count; j++) {
+            uint32_t i = start + (j % count);
+            float px = j == count ? start_x : xs[i], py = j == count ? start_y : ys[i];
+            bool on_curve = j == count || (flags[i] & 1);
+            if (j == 0 && (flags[i] & 1)) continue;
+            if (on_curve) {
+                if (has_control) {
+                    truetype_draw_curve(raster, x, y, control_x, control_y, px, py);
+                } else {
+                    truetype_draw_line(raster, x, y, px, py);
+                }
+                x = px;
+                y = py;
+                has_control = false;
+            } else {
+                if (has_control) {
+                    float mid_x = (control_x + px) / 2, mid_y = (control_y + py) / 2;
+                    truetype_draw_curve(raster, x, y, control_x, control_y, mid_x, mid_y);
+                    x = mid_x;
+                    y = mid_y;
+                }
+                control_x = px;
+                control_y = py;
+                has_control = true;
+            }
+        }
+        start = end + 1;
+    }
+}
+
+void truetype_rasterize(TrueType *font, uint16_t glyph, float scale, TrueTypeBox *box, uint8_t *dst, int32_t stride) {
+    TrueTypeRaster raster = {box->x1 - box->x0, box->y1 - box->y0};
+    if (raster.width > TRUETYPE_MAX_RASTER) raster.width = TRUETYPE_MAX_RASTER;
+    if (raster.height > TRUETYPE_MAX_RASTER) raster.height = TRUETYPE_MAX_RASTER;
+    memset(accumulation, 0, (raster.width + 2) * raster.height * sizeof(float));
+
+    // Font units to box pixels with y pointing down
+    float m[6] = {scale, 0, 0, -scale, -box->x0, -box->y0};
+    truetype_draw_glyph(font, &raster, glyph, m, 0);
+
+    // Sum the signed areas of each row into coverage
+    for (int32_t y = 0; y < raster.height; y++) {
+        float *row = &accumulation[y * (raster.width + 2)];
+        float sum = 0;
+        for (int32_t x = 0; x < raster.width; x++) {
+            sum += row[x];
+            float coverage = fabsf(sum);
+            dst[y * stride + x] = coverage >= 1 ? 255 : (uint8_t)(coverage * 255 + 0.5f);
+        }
+    }
+}
@@ -0,0 +1,87 @@
+#include "utf8.h"
+
+#include <string.h>
+
+#define UTF8_ACCEPT 0
+#define UTF8_REJECT 12
+
+// Bjoern Hoehrmann's UTF-8 decoder, the first 256 entries map bytes to character classes and
+// the rest are state transitions, rejects overlong forms, surrogates and code points above U+10FFFF
+static const uint8_t utf8_table[] = {
+    // clang-format off
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, 9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,
+    7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7, 7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+    8,8,2,2,2,2,2,2,2,2,2,2,2,2,2,2, 2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,
+    10,3,3,3,3,3,3,3,3,3,3,3,3,4,3,3, 11,6,6,6,5,8,8,8,8,8,8,8,8,8,8,8,
+
+    0,12,24,36,60,96,84,12,12,12,48,72, 12,12,12,12,12,12,12,12,12,12,12,12,
+    12,0,12,12,12,12,12,0,12,0,12,12, 12,24,12,12,12,12,12,24,12,24,12,12,
+    12,12,12,12,12,12,12,24,12,12,12,12, 12,24,12,12,12,12,12,12,12,24,12,12,
+    12,12,12,12,12,12,12,36,12,36,12,12, 12,36,12,12,12,12,12,36,12,36,12,12,
+    12,36,12,12,12,12,12,12,12,12,12,12,
+    // clang-format on
+};
+
+uint32_t utf8_decode_next(const char *buf, size_t len, size_t *index) {
+    const uint8_t *bytes = (const uint8_t *)buf;
+    size_t i = *index;
+    if (bytes[i] < 0x80) {
+        *index = i + 1;
+        return bytes[i];
+    }
+
+    uint32_t state = UTF8_ACCEPT;
+    uint32_t code_point = 0;
+    while (i < len) {
+        uint8_t byte = bytes[i];
+        uint8_t type = utf8_table[byte];
+        code_point = state != UTF8_ACCEPT ? (byte & 0x3f) | (code_point << 6) : (0xff >> type) & byte;
+        state = utf8_table[256 + state + type];
+        if (state == UTF8_ACCEPT) {
+            *index = i + 1;
+            return code_point;
+        }
+        if (state == UTF8_REJECT) {
+            // A bad lead byte is consumed, a bad continuation byte starts the next sequence
+            *index = i == *index ? i + 1 : i;
+            return UTF8_REPLACEMENT_CHARACTER;
+        }
+        i++;
+    }
+
+    // Truncated sequence at the end of the buffer
+    *index = len;
+    return UTF8_REPLACEMENT_CHARACTER;
+}
+
+size_t utf8_decode_to_codepoints(const char *buf, size_t len, uint32_t *out) {
+    const uint8_t *bytes = (const uint8_t *)buf;
+    size_t index = 0;
+    size_t size = 0;
+    while (index < len) {
+        // Copy runs of ASCII four bytes at a time
+        uint32_t word;
+        while (index + 4 <= len) {
+            memcpy(&word, &bytes[index], 4);
+            if ((word & 0x80808080) != 0) break;
+            out[size] = bytes[index];
+            out[size + 1] = bytes[index + 1];
+            out[size + 2] = bytes[index + 2];
+            out[size + 3] = bytes[index + 3];
+            index += 4;
+            size += 4;
+        }
+        if (index == len) break;
+
+        if (bytes[index] < 0x80) {
+            out[size++] = bytes[index++];
+        } else {
+            out[size++] = utf8_decode_next(buf, len, &index);
+        }
+    }
+    return size;
+}
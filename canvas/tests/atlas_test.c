@@ -0,0 +1,160 @@
+// Host tests of the atlas: the blank block and the four cursors share one CI8 page, each reads back through its
+// palette entries with its padding, no two overlap and setting the colors of one leaves the others alone. The
+// skyline packer then fills small pages with random rects, which must stay inside and apart and fill the pages.
+
+#define TEST_NAME "atlas_test"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "atlas.h"
+#include "stb_image.h"
+#include "test.h"
+
+static uint8_t page_index(Atlas *atlas, AtlasPage *page, int32_t x, int32_t y) {
+    return page->pixels[((y >> 2) * (atlas->width >> 3) + (x >> 3)) * 32 + (y & 3) * 8 + (x & 7)];
+}
+
+// PSNR of a region read back through its page colors, false when an index falls outside its palette entries
+static bool region_psnr(Atlas *atlas, const AtlasRegion *region, const uint8_t *src, double *result) {
+    int32_t x0 = lroundf(region->left * atlas->width), y0 = lroundf(region->top * atlas->height);
+    double error = 0;
+    for (int32_t y = -1; y <= region->height; y++) {
+        for (int32_t x = -1; x <= region->width; x++) {
+            uint8_t index = page_index(atlas, region->page, x0 + x, y0 + y);
+            if (index < region->colors_start || index >= region->colors_start + region->colors_size) return false;
+            int32_t sx = x < 0 ? 0 : x >= region->width ? region->width - 1 : x;
+            int32_t sy = y < 0 ? 0 : y >= region->height ? region->height - 1 : y;
+            const uint8_t *pixel = &src[(sy * region->width + sx) * 4];
+            const uint8_t *color = &region->page->colors[index * 4];
+            for (int32_t c = pixel[3] == 0 && color[3] == 0 ? 3 : 0; c < 4; c++) {
+                double delta = (double)pixel[c] - color[c];
+                error += delta * delta;
+            }
+        }
+    }
+    double count = (region->width + 2) * (region->height + 2) * 4;
+    *result = error == 0 ? INFINITY : 10 * log10(255.0 * 255.0 * count / error);
+    return true;
+}
+
+static bool overlap(Atlas *atlas, const AtlasRegion *a, const AtlasRegion *b) {
+    // Padded rects in texels
+    int32_t ax = lroundf(a->left * atlas->width) - 1, ay = lroundf(a->top * atlas->height) - 1;
+    int32_t bx = lroundf(b->left * atlas->width) - 1, by = lroundf(b->top * atlas->height) - 1;
+    return a->page == b->page && ax < bx + b->width + 2 && bx < ax + a->width + 2 && ay < by + b->height + 2 &&
+           by < ay + a->height + 2;
+}
+
+static void test_skyline(void) {
+    // Solid rects of one color each until every page is full, like icons of mixed sizes
+    Atlas atlas;
+    atlas_init(&atlas, 128, 128, GX_TLUT0);
+    static AtlasRegion regions[1024];
+    static uint8_t pixels[24 * 24 * 4];
+    uint32_t regions_size = 0, area[ATLAS_MAX_PAGES] = {0};
+    while (regions_size < 1024) {
+        int32_t width = 2 + random_below(23), height = 2 + random_below(23);
+        for (int32_t i = 0; i < width * height; i++) {
+            memcpy(&pixels[i * 4], (uint8_t[]){regions_size * 37, regions_size * 91, regions_size, 0xff}, 4);
+        }
+        AtlasRegion *region = &regions[regions_size];
+        if (!atlas_add_rgba8(&atlas, region, pixels, width, height, 1)) break;
+        area[region->page - atlas.pages] += (width + 2) * (height + 2);
+
+        // Inside the page and filled with its own color, padding included
+        int32_t x0 = lroundf(region->left * atlas.width), y0 = lroundf(region->top * atlas.height);
+        bool inside = x0 >= 1 && y0 >= 1 && x0 + width + 1 <= atlas.width && y0 + height + 1 <= atlas.height;
+        check(inside, "skyline", "places a rect outside its page");
+        if (!inside) return;
+        uint32_t wrong = 0;
+        for (int32_t y = -1; y <= height; y++) {
+            for (int32_t x = -1; x <= width; x++) wrong += page_index(&atlas, region->page, x0 + x, y0 + y) !=
+                                                           region->colors_start;
+        }
+        check(wrong == 0, "skyline", "rect texels were overwritten or not written");
+        regions_size++;
+    }
+    check(atlas.pages_size == ATLAS_MAX_PAGES, "skyline", "stops before every page is used");
+
+    // Texels of earlier rects survive the later ones
+    uint32_t overlapping = 0;
+    for (uint32_t i = 0; i < regions_size; i++) {
+        for (uint32_t j = 0; j < i; j++) overlapping += overlap(&atlas, &regions[i], &regions[j]);
+    }
+    check(overlapping == 0, "skyline", "rects overlap");
+    for (uint32_t i = 0; i + 1 < atlas.pages_size; i++) {
+        double filled = (double)area[i] / (atlas.width * atlas.height);
+        check(filled >= 0.7, "skyline", "fills less than 70% of a page before starting the next");
+        printf("atlas_test: skyline page %u %.0f%% filled\n", i, filled * 100);
+    }
+    for (uint32_t i = 0; i < atlas.pages_size; i++) {
+        free(atlas.pages[i].pixels);
+        free(atlas.pages[i].palette.entries);
+    }
+}
+
+int main(void) {
+    static const char *paths[] = {"data/cursor1.png", "data/cursor2.png", "data/cursor3.png", "data/cursor4.png"};
+    static uint8_t blank[4 * 4 * 4] = {[0 ... 63] = 0xff};
+    uint8_t *images[5] = {blank};
+    int32_t widths[5] = {4}, heights[5] = {4};
+    for (int32_t i = 0; i < 4; i++) {
+        int32_t channels;
+        images[i + 1] = stbi_load(paths[i], &widths[i + 1], &heights[i + 1], &channels, 4);
+        check(images[i + 1] != NULL, paths[i], "can't be loaded");
+        if (images[i + 1] == NULL) return 1;
+    }
+
+    // Same sizes and color budgets as canvas_init and cursor_init
+    Atlas atlas;
+    atlas_init(&atlas, 256, 256, GX_TLUT0);
+    AtlasRegion regions[5];
+    for (int32_t i = 0; i < 5; i++) {
+        check(atlas_add_rgba8(&atlas, &regions[i], images[i], widths[i], heights[i], i == 0 ? 1 : 63),
+              i == 0 ? "blank" : paths[i - 1], "doesn't fit");
+    }
+    check(atlas.pages_size == 1, "atlas", "doesn't keep the blank block and the cursors on one page");
+    check(atlas.pages[0].texture.format == GX_TF_CI8 && atlas.pages[0].texture.tlut_name == GX_TLUT0, "atlas",
+          "page isn't CI8 reading its TLUT");
+    check(atlas.pages[0].colors_size == 1 + 1 + 4 * 63, "atlas", "palette entries aren't handed out in order");
+
+    for (int32_t i = 0; i < 5; i++) {
+        const char *name = i == 0 ? "blank" : paths[i - 1];
+        double psnr = 0;
+        check(region_psnr(&atlas, &regions[i], images[i], &psnr), name, "reads palette entries of another image");
+        check(psnr >= 40, name, "quantizes below 40 dB");
+        for (int32_t j = 0; j < i; j++) check(!overlap(&atlas, &regions[i], &regions[j]), name, "overlaps");
+    }
+
+    // New colors for one cursor reach the TLUT entries of that cursor and no others
+    uint8_t before[TEXTURE_PALETTE_MAX_COLORS * 2];
+    memcpy(before, atlas.pages[0].palette.entries, sizeof(before));
+    uint8_t black[63 * 4];
+    for (int32_t i = 0; i < 63; i++) memcpy(&black[i * 4], (uint8_t[]){0, 0, 0, 0xff}, 4);
+    atlas_set_colors(&regions[2], black);
+    uint32_t changed_outside = 0, unchanged_inside = 0;
+    for (uint32_t i = 0; i < TEXTURE_PALETTE_MAX_COLORS; i++) {
+        bool inside = i >= regions[2].colors_start && i < regions[2].colors_start + regions[2].colors_size;
+        bool changed = memcmp(&before[i * 2], &atlas.pages[0].palette.entries[i * 2], 2) != 0;
+        changed_outside += !inside && changed;
+        unchanged_inside += inside && atlas.pages[0].palette.entries[i * 2] != 0x80;
+    }
+    check(changed_outside == 0, "atlas_set_colors", "changes entries of other images");
+    check(unchanged_inside == 0, "atlas_set_colors", "doesn't write opaque black RGB5A3 entries");
+
+    // An image whose colors no longer fit the palette starts a new page even though its rect would fit
+    AtlasRegion extra;
+    check(atlas_add_rgba8(&atlas, &extra, images[1], widths[1], heights[1], 63), "extra cursor", "doesn't fit");
+    check(extra.page == &atlas.pages[1] && atlas.pages_size == 2, "extra cursor", "shares a full palette");
+
+    for (int32_t i = 1; i < 5; i++) stbi_image_free(images[i]);
+    test_skyline();
+    for (uint32_t i = 0; i < atlas.pages_size; i++) {
+        free(atlas.pages[i].pixels);
+        free(atlas.pages[i].palette.entries);
+    }
+    return test_report();
+}
@@ -0,0 +1,226 @@
+// Host benchmark of the canvas draw paths through the counting libogc stand-in: one frame of images and fills drawn
+// per quad with a matrix load each and batched per texture run, compared by the GX_Begin calls and FIFO bytes the
+// stand-in received, after checks that both paths send the same vertices and that the stats counters agree. The text
+// layout cache is checked through its hit and miss counters, and display lists that overflow through the vertices
+// that still reach the FIFO
+
+#define TEST_NAME "canvas_test"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "canvas.h"
+#include "font.h"
+#include "glyph_cache.h"
+#include "test.h"
+
+#define SCENE_QUADS 256
+#define SCENE_TEXTURES 3
+
+static GXTexObj scene_textures[SCENE_TEXTURES];
+
+typedef struct DrawPath {
+    const char *name;
+    bool batching;
+    bool deferred;
+    bool indexed;
+    bool compact;
+} DrawPath;
+
+// The baseline per quad path first, then each option the canvas added
+static const DrawPath paths[] = {
+    {"per quad", false, false, false, false},
+    {"per quad indexed", false, false, true, false},
+    {"per quad indexed compact", false, false, true, true},
+    {"batched", true, false, false, true},
+    {"batched deferred", true, true, false, true},
+};
+
+static void scene_init(void) {
+    static uint8_t texels[SCENE_TEXTURES][64 * 64 * 4];
+    for (int32_t i = 0; i < SCENE_TEXTURES; i++) {
+        GX_InitTexObj(&scene_textures[i], texels[i], 64, 64, GX_TF_RGBA8, GX_CLAMP, GX_CLAMP, GX_FALSE);
+    }
+}
+
+// Tiles of the textures in turn with a solid fill every fourth quad, none overlapping, like a tile map with markers
+static void scene_draw(const DrawPath *path) {
+    canvas.batching = path->batching;
+    canvas.deferred = path->deferred;
+    canvas.indexed = path->indexed;
+    canvas.compact = path->compact;
+    canvas_begin(640, 480);
+    for (int32_t i = 0; i < SCENE_QUADS; i++) {
+        float x = (i % 32) * 20, y = (i / 32) * 20;
+        if (i % 4 == 3) {
+            canvas_fill_rect(x, y, 16, 16, 0xff0000ff);
+        } else {
+            canvas_draw_image(&scene_textures[i % SCENE_TEXTURES], x, y, 16, 16, 0xffffffff);
+        }
+    }
+    canvas_end();
+}
+
+static GXHost measure(const DrawPath *path) {
+    gx_host = (GXHost){0};
+    scene_draw(path);
+    return gx_host;
+}
+
+static void test_paths(void) {
+    for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        const DrawPath *path = &paths[i];
+        GXHost host = measure(path);
+        check(host.vertices == SCENE_QUADS * 4, path->name, "doesn't send four vertices per quad");
+        check(host.begins == canvas.stats.draw_calls, path->name, "draw_calls differs from the GX_Begin calls");
+        check(host.matrix_loads == canvas.stats.matrix_loads, path->name, "matrix_loads differs from the loads");
+        check(host.texture_loads == canvas.stats.texture_loads, path->name, "texture_loads differs from the loads");
+        if (path->batching) {
+            // One matrix for the frame, and with regrouping one draw per texture including the blank atlas page
+            check(host.matrix_loads == 1, path->name, "loads a matrix per quad");
+            uint32_t runs = path->deferred ? SCENE_TEXTURES + 1 : SCENE_QUADS;
+            check(host.begins == runs, path->name, "doesn't draw one run per texture change");
+        } else {
+            check(host.begins == SCENE_QUADS && host.matrix_loads == SCENE_QUADS, path->name,
+                  "doesn't draw each quad with its own matrix");
+        }
+    }
+
+    // Batching is what the per quad path is measured against
+    GXHost per_quad = measure(&paths[0]), batched = measure(&paths[4]);
+    check(batched.begins * 16 < per_quad.begins, "batched deferred", "doesn't cut the draw calls 16 times");
+    check(batched.fifo_bytes * 2 < per_quad.fifo_bytes, "batched deferred", "doesn't halve the FIFO bytes");
+}
+
+// Whether measuring the text found its layout in the cache
+static bool text_cache_hit(char *text) {
+    uint32_t hits = canvas.stats.text_cache_hits, misses = canvas.stats.text_cache_misses;
+    canvas_measure_text(text, FONT_RENDER_SIZE);
+    return canvas.stats.text_cache_hits == hits + 1 && canvas.stats.text_cache_misses == misses;
+}
+
+static uint32_t text_vertices(char *text) {
+    uint32_t vertices = gx_host.vertices;
+    canvas_fill_text(text, 0, 0, FONT_RENDER_SIZE, 0xffffffff);
+    return gx_host.vertices - vertices;
+}
+
+static void test_text_cache(void) {
+    canvas.batching = false;
+    canvas_begin(640, 480);
+    check(!text_cache_hit("cached"), "text cache", "hits text it never laid out");
+    check(text_cache_hit("cached"), "text cache", "misses text it just laid out");
+
+    // A full cache replaces the least recently used layout, which the first one no longer is once it is used again
+    char texts[CANVAS_TEXT_CACHE_SIZE + 1][16];
+    for (uint32_t i = 0; i <= CANVAS_TEXT_CACHE_SIZE; i++) snprintf(texts[i], sizeof(texts[i]), "text %u", i);
+    uint32_t missed = 0;
+    for (uint32_t i = 0; i < CANVAS_TEXT_CACHE_SIZE; i++) missed += !text_cache_hit(texts[i]);
+    check(missed == CANVAS_TEXT_CACHE_SIZE, "text cache", "hits text it never laid out");
+    check(text_cache_hit(texts[0]), "text cache", "drops a layout before the cache is full");
+    check(!text_cache_hit(texts[CANVAS_TEXT_CACHE_SIZE]), "text cache", "hits text it never laid out");
+    check(text_cache_hit(texts[0]), "text cache", "replaces a recently used layout");
+    check(!text_cache_hit(texts[1]), "text cache", "doesn't replace the least recently used layout");
+
+    // Text with a code point from the glyph cache is laid out again once the glyph is drawn into a page
+    uint32_t code_point = 0xa1;
+    while (code_point < 0x800 && (font_table_find(code_point) != FONT_GLYPH_NONE || !glyph_cache_find(code_point))) {
+        code_point++;
+    }
+    check(code_point < 0x800, "text cache", "no glyph cache glyph below U+0800 to test with");
+    char cached[] = {'a', 0xc0 | code_point >> 6, 0x80 | (code_point & 0x3f), '\0'};
+    check(text_vertices(cached) == 4, "text cache", "draws a glyph that is still queued");
+    check(text_cache_hit(cached), "text cache", "misses text with a queued glyph");
+    check(!text_cache_hit("plain"), "text cache", "hits text it never laid out");
+    uint32_t generation = glyph_cache.generation;
+    canvas_end();
+    canvas_begin(640, 480);
+    check(glyph_cache.generation != generation, "text cache", "glyph cache didn't draw the queued glyph");
+    check(text_cache_hit("plain"), "text cache", "drops layouts without glyph cache glyphs");
+    check(!text_cache_hit(cached), "text cache", "keeps a layout from before the glyph cache changed");
+    check(text_vertices(cached) == 8, "text cache", "doesn't draw the glyph once it is in a page");
+
+    // Text with more glyphs than a layout holds keeps the first ones and lays out the rest once per use
+    char digits[101];
+    for (uint32_t i = 0; i < 100; i++) digits[i] = '0' + i % 10;
+    digits[100] = '\0';
+    float width = canvas_measure_text(digits, FONT_RENDER_SIZE);
+    float kerning = canvas_measure_text("90", FONT_RENDER_SIZE) - canvas_measure_text("9", FONT_RENDER_SIZE) -
+                    canvas_measure_text("0", FONT_RENDER_SIZE);
+    check(width == 10 * canvas_measure_text("0123456789", FONT_RENDER_SIZE) + 9 * kerning, "long text",
+          "measures differently from its parts");
+    check(text_cache_hit(digits), "long text", "isn't cached");
+    check(text_vertices(digits) == 400, "long text", "doesn't draw every glyph once");
+    canvas_end();
+}
+
+// One frame that records count quads into the list at offset x unless it is kept, then calls it
+static uint32_t list_frame(CanvasList *list, uint32_t count, float x) {
+    canvas.batching = true;
+    canvas.deferred = false;
+    canvas_begin(640, 480);
+    gx_host = (GXHost){0};
+    Mtx offset_matrix;
+    guMtxTrans(offset_matrix, x, 0, 0);
+    if (canvas_record_begin(list, count, offset_matrix)) {
+        for (uint32_t i = 0; i < count; i++) canvas_fill_rect((i % 32) * 20, (i / 32) * 20, 16, 16, 0xff0000ff);
+        canvas_record_end(list);
+    }
+    canvas_call_list(list);
+    canvas_end();
+    return gx_host.vertices - gx_host.list_vertices;
+}
+
+static void test_lists(void) {
+    // A list that fits is drawn by its call at the offset of the frame, kept lists move with it
+    CanvasList list;
+    canvas_list_init(&list, 64 * 1024);
+    check(list_frame(&list, 16, 100) == 0 && gx_host.list_vertices == 64, "list", "isn't recorded");
+    check(gx_host.list_calls == 1 && gx_host.matrix[0][3] == 100, "list", "isn't called at its offset");
+    check(list_frame(&list, 16, 200) == 0 && gx_host.list_vertices == 0, "list", "is recorded again");
+    check(gx_host.list_calls == 1 && gx_host.matrix[0][3] == 200, "list", "isn't called at the new offset");
+    free(list.data);
+
+    // A list that overflows draws immediately at the offset of each frame, the first frame included
+    canvas_list_init(&list, 256);
+    check(list_frame(&list, 16, 100) == 64, "overflowed list", "loses the draws of the frame it overflowed in");
+    check(list.overflowed && gx_host.list_calls == 0, "overflowed list", "is called");
+    check(gx_host.matrix[0][3] == 100, "overflowed list", "isn't drawn at its offset");
+    check(list_frame(&list, 16, 200) == 64, "overflowed list", "isn't drawn immediately");
+    check(gx_host.matrix[0][3] == 200, "overflowed list", "is drawn at the offset of the previous frame");
+    free(list.data);
+
+    // Quads past one batch are drawn immediately with the batch, though the bytes would fit the list
+    canvas_list_init(&list, 64 * 1024);
+    uint32_t count = CANVAS_BATCH_MAX_QUADS + 76;
+    check(list_frame(&list, count, 100) == count * 4, "long list", "loses quads");
+    check(list.overflowed && gx_host.matrix[0][3] == 100, "long list", "isn't drawn immediately at its offset");
+    check(list_frame(&list, count, 200) == count * 4, "long list", "isn't drawn immediately");
+    free(list.data);
+}
+
+static void benchmark(void) {
+    for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        GXHost host = measure(&paths[i]);
+        int32_t rounds = 2000;
+        clock_t start = clock();
+        for (int32_t j = 0; j < rounds; j++) scene_draw(&paths[i]);
+        double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+        printf("canvas_test: %-24s %3u GX_Begin %4u matrix loads %4u texture loads %6u FIFO bytes %5.1f us\n",
+               paths[i].name, host.begins, host.matrix_loads, host.texture_loads, host.fifo_bytes,
+               seconds / rounds * 1e6);
+    }
+}
+
+int main(void) {
+    canvas_init();
+    scene_init();
+    test_paths();
+    test_text_cache();
+    test_lists();
+    if (test_report() != 0) return 1;
+    benchmark();
+    return 0;
+}
@@ -0,0 +1,239 @@
+// Host tests of the CMPR encoder on the repo images: both qualities are decoded by a reference decoder and their
+// PSNR is compared with a reference encoder that searches endpoint pairs far wider than either, then timed
+
+#define TEST_NAME "cmpr_test"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cmpr.h"
+#include "stb_image.h"
+#include "test.h"
+
+// High quality may trail the reference encoder by this many dB
+#define CMPR_TEST_HIGH_MARGIN 0.5
+
+static void unpack(uint32_t color, int32_t rgb[3]) {
+    rgb[0] = ((color >> 11) << 3) | (color >> 13);
+    rgb[1] = (((color >> 5) & 0x3f) << 2) | ((color >> 9) & 0x3);
+    rgb[2] = ((color & 0x1f) << 3) | ((color >> 2) & 0x7);
+}
+
+static void block_palette(uint32_t color0, uint32_t color1, int32_t palette[4][4]) {
+    // GX blends four color blocks 5/8 and 3/8, three color blocks average and make index 3 a transparent copy of
+    // the average rather than the transparent black of DXT1
+    unpack(color0, palette[0]);
+    unpack(color1, palette[1]);
+    for (int32_t c = 0; c < 3; c++) {
+        if (color0 > color1) {
+            palette[2][c] = (palette[0][c] * 5 + palette[1][c] * 3) >> 3;
+            palette[3][c] = (palette[0][c] * 3 + palette[1][c] * 5) >> 3;
+        } else {
+            palette[2][c] = palette[3][c] = (palette[0][c] + palette[1][c]) / 2;
+        }
+    }
+    palette[0][3] = palette[1][3] = palette[2][3] = 0xff;
+    palette[3][3] = color0 > color1 ? 0xff : 0;
+}
+
+static void reference_decode(const uint8_t *src, int32_t width, int32_t height, uint8_t *dst) {
+    for (int32_t tile_y = 0; tile_y < height; tile_y += 8) {
+        for (int32_t tile_x = 0; tile_x < width; tile_x += 8) {
+            for (int32_t i = 0; i < 4; i++, src += 8) {
+                int32_t palette[4][4];
+                block_palette((src[0] << 8) | src[1], (src[2] << 8) | src[3], palette);
+                for (int32_t j = 0; j < 16; j++) {
+                    int32_t x = tile_x + (i & 1) * 4 + (j & 3), y = tile_y + (i >> 1) * 4 + (j >> 2);
+                    if (x >= width || y >= height) continue;
+                    int32_t index = (src[4 + (j >> 2)] >> (6 - (j & 3) * 2)) & 3;
+                    for (int32_t c = 0; c < 4; c++) dst[(y * width + x) * 4 + c] = palette[index][c];
+                }
+            }
+        }
+    }
+}
+
+static uint32_t distance(const int32_t pixel[3], const int32_t color[4]) {
+    uint32_t sum = 0;
+    for (int32_t c = 0; c < 3; c++) sum += (pixel[c] - color[c]) * (pixel[c] - color[c]);
+    return sum;
+}
+
+typedef struct ReferenceBlock {
+    int32_t pixels[16][3];
+    bool opaque[16];
+    bool transparent;
+} ReferenceBlock;
+
+// Squared error of the opaque texels with the best index for each
+static uint32_t reference_error(const ReferenceBlock *block, uint32_t color0, uint32_t color1) {
+    int32_t palette[4][4];
+    block_palette(color0, color1, palette);
+    int32_t colors_size = color0 > color1 ? 4 : 3;
+    uint32_t error = 0;
+    for (int32_t i = 0; i < 16; i++) {
+        if (!block->opaque[i]) continue;
+        uint32_t best = UINT32_MAX;
+        for (int32_t j = 0; j < colors_size; j++) {
+            uint32_t error = distance(block->pixels[i], palette[j]);
+            if (error < best) best = error;
+        }
+        error += best;
+    }
+    return error;
+}
+
+static uint32_t reference_pack(const int32_t rgb[3]) {
+    return ((rgb[0] * 31 + 127) / 255 << 11) | ((rgb[1] * 63 + 127) / 255 << 5) | ((rgb[2] * 31 + 127) / 255);
+}
+
+// Best of both orders of a pair, three colors when the block has transparent texels
+static uint32_t reference_try(const ReferenceBlock *block, uint32_t a, uint32_t b, uint32_t *color0,
+                              uint32_t *color1) {
+    uint32_t low = a < b ? a : b, high = a < b ? b : a;
+    uint32_t error = reference_error(block, low, high);
+    *color0 = low, *color1 = high;
+    if (!block->transparent && low != high) {
+        uint32_t four_error = reference_error(block, high, low);
+        if (four_error < error) error = four_error, *color0 = high, *color1 = low;
+    }
+    return error;
+}
+
+// Every pair of the block colors as endpoints, then single channel steps of either endpoint while they help
+static void reference_encode_block(const ReferenceBlock *block, uint8_t *dst) {
+    uint32_t candidates[16], candidates_size = 0;
+    for (int32_t i = 0; i < 16; i++) {
+        if (block->opaque[i]) candidates[candidates_size++] = reference_pack(block->pixels[i]);
+    }
+    uint32_t color0 = 0, color1 = 0, best = UINT32_MAX;
+    for (uint32_t i = 0; i < candidates_size; i++) {
+        for (uint32_t j = i; j < candidates_size; j++) {
+            uint32_t first, second;
+            uint32_t error = reference_try(block, candidates[i], candidates[j], &first, &second);
+            if (error < best) best = error, color0 = first, color1 = second;
+        }
+    }
+    static const uint32_t fields[3][2] = {{11, 31}, {5, 63}, {0, 31}};
+    for (bool improved = candidates_size > 0 && best > 0; improved;) {
+        improved = false;
+        for (int32_t endpoint = 0; endpoint < 2; endpoint++) {
+            for (int32_t c = 0; c < 3; c++) {
+                for (int32_t step = -1; step <= 1; step += 2) {
+                    uint32_t colors[2] = {color0, color1};
+                    int32_t level = (colors[endpoint] >> fields[c][0]) & fields[c][1];
+                    if (level + step < 0 || level + step > (int32_t)fields[c][1]) continue;
+                    colors[endpoint] += step * (1 << fields[c][0]);
+                    uint32_t first, second;
+                    uint32_t error = reference_try(block, colors[0], colors[1], &first, &second);
+                    if (error < best) best = error, color0 = first, color1 = second, improved = true;
+                }
+            }
+        }
+    }
+
+    int32_t palette[4][4];
+    block_palette(color0, color1, palette);
+    int32_t colors_size = color0 > color1 ? 4 : 3;
+    dst[0] = color0 >> 8, dst[1] = color0 & 0xff, dst[2] = color1 >> 8, dst[3] = color1 & 0xff;
+    memset(&dst[4], 0, 4);
+    for (int32_t i = 0; i < 16; i++) {
+        int32_t index = 3;
+        uint32_t nearest = UINT32_MAX;
+        for (int32_t j = 0; j < colors_size && block->opaque[i]; j++) {
+            uint32_t error = distance(block->pixels[i], palette[j]);
+            if (error < nearest) nearest = error, index = j;
+        }
+        dst[4 + (i >> 2)] |= index << (6 - (i & 3) * 2);
+    }
+}
+
+static void reference_encode(const uint8_t *src, int32_t width, int32_t height, uint8_t *dst) {
+    for (int32_t tile_y = 0; tile_y < height; tile_y += 8) {
+        for (int32_t tile_x = 0; tile_x < width; tile_x += 8) {
+            for (int32_t i = 0; i < 4; i++, dst += 8) {
+                ReferenceBlock block = {.transparent = false};
+                for (int32_t j = 0; j < 16; j++) {
+                    int32_t x = tile_x + (i & 1) * 4 + (j & 3), y = tile_y + (i >> 1) * 4 + (j >> 2);
+                    if (x >= width) x = width - 1;
+                    if (y >= height) y = height - 1;
+                    const uint8_t *pixel = &src[(y * width + x) * 4];
+                    for (int32_t c = 0; c < 3; c++) block.pixels[j][c] = pixel[c];
+                    block.opaque[j] = pixel[3] >= CMPR_ALPHA_THRESHOLD;
+                    if (!block.opaque[j]) block.transparent = true;
+                }
+                reference_encode_block(&block, dst);
+            }
+        }
+    }
+}
+
+// PSNR of the color of opaque texels like tools/png_cmpr prints, false when a texel lands on the wrong side of
+// the alpha threshold
+static bool psnr(const uint8_t *src, const uint8_t *decoded, int32_t width, int32_t height, double *result) {
+    double error = 0;
+    int64_t count = 0;
+    for (int32_t i = 0; i < width * height; i++) {
+        bool opaque = src[i * 4 + 3] >= CMPR_ALPHA_THRESHOLD;
+        if (opaque != (decoded[i * 4 + 3] == 0xff)) return false;
+        if (!opaque) continue;
+        for (int32_t c = 0; c < 3; c++) {
+            double delta = src[i * 4 + c] - decoded[i * 4 + c];
+            error += delta * delta;
+        }
+        count += 3;
+    }
+    *result = count == 0 || error == 0 ? INFINITY : 10 * log10(255.0 * 255.0 * count / error);
+    return true;
+}
+
+// Encodes with quality, or the reference encoder when quality is -1, and returns the milliseconds it took
+static double encode(const uint8_t *src, int32_t width, int32_t height, int32_t quality, uint8_t *dst) {
+    clock_t start = clock();
+    if (quality < 0) {
+        reference_encode(src, width, height, dst);
+    } else {
+        cmpr_encode(src, width, height, quality, dst);
+    }
+    return (double)(clock() - start) / CLOCKS_PER_SEC * 1000;
+}
+
+static void test_image(const char *path) {
+    int32_t width, height, channels;
+    uint8_t *src = stbi_load(path, &width, &height, &channels, 4);
+    check(src != NULL, path, "can't be loaded");
+    if (src == NULL) return;
+
+    static const char *names[] = {"reference", "fast", "high"};
+    uint8_t *texels = malloc(cmpr_size(width, height));
+    uint8_t *decoded = malloc(width * height * 4), *expected = malloc(width * height * 4);
+    double psnrs[3], times[3];
+    for (int32_t i = 0; i < 3; i++) {
+        times[i] = encode(src, width, height, i - 1, texels);
+        reference_decode(texels, width, height, decoded);
+        cmpr_decode(texels, width, height, expected);
+        char name[128];
+        snprintf(name, sizeof(name), "%s %s", path, names[i]);
+        check(memcmp(decoded, expected, width * height * 4) == 0, name, "cmpr_decode differs from GX");
+        check(psnr(src, decoded, width, height, &psnrs[i]), name, "alpha doesn't follow CMPR_ALPHA_THRESHOLD");
+    }
+    check(psnrs[2] >= psnrs[1], path, "high quality is worse than fast");
+    check(psnrs[2] >= psnrs[0] - CMPR_TEST_HIGH_MARGIN, path, "high quality trails the reference encoder");
+    printf("cmpr_test: %s %dx%d, reference %.2f dB %.1f ms, fast %.2f dB %.2f ms, high %.2f dB %.2f ms\n", path,
+           (int)width, (int)height, psnrs[0], times[0], psnrs[1], times[1], psnrs[2], times[2]);
+    stbi_image_free(src);
+    free(texels);
+    free(decoded);
+    free(expected);
+}
+
+int main(void) {
+    static const char *paths[] = {"textures/stone_coal.png", "data/dirt_grass.png", "data/cursor1.png",
+                                  "data/cursor2.png", "data/cursor3.png", "data/cursor4.png"};
+    for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) test_image(paths[i]);
+    return test_report();
+}
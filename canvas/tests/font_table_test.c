@@ -0,0 +1,123 @@
+// Host tests of the font table: the page table lookup of every code point in planes 0 and 1 and the kerning binary
+// search of every glyph pair must match the linear scans of font[] and font_kernings[] they replaced, followed by a
+// benchmark of both on a line of text
+
+#define TEST_NAME "font_table_test"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "font.h"
+#include "test.h"
+
+// The scan canvas_fill_text did for every code point, kept out of line like the lookup it is timed against
+__attribute__((noinline)) static uint8_t reference_find(uint32_t code_point) {
+    for (uint32_t i = 0; i < sizeof(font) / sizeof(FontChar) && i < FONT_GLYPHS_MAX; i++) {
+        if (font[i].n == code_point) return i;
+    }
+    return FONT_GLYPH_NONE;
+}
+
+__attribute__((noinline)) static int8_t reference_find_kerning(uint8_t left, uint8_t right) {
+    if (left >= sizeof(font) / sizeof(FontChar) || right >= sizeof(font) / sizeof(FontChar)) return 0;
+    for (uint32_t i = 0; i < sizeof(font_kernings) / sizeof(FontKerning); i++) {
+        if (font_kernings[i].l == font[left].n && font_kernings[i].r == font[right].n) return font_kernings[i].k;
+    }
+    return 0;
+}
+
+static void test_find(void) {
+    // Every code point the pages cover, then the first past them and the largest ones
+    static const uint32_t beyond[] = {0x20000, 0x20020, 0x10ffff, 0x110000, 0xffffffff};
+    uint32_t mismatches = 0, found = 0;
+    for (uint32_t code_point = 0; code_point < 0x20000; code_point++) {
+        uint8_t glyph = font_table_find(code_point);
+        mismatches += glyph != reference_find(code_point);
+        found += glyph != FONT_GLYPH_NONE;
+    }
+    for (size_t i = 0; i < sizeof(beyond) / sizeof(beyond[0]); i++) {
+        mismatches += font_table_find(beyond[i]) != FONT_GLYPH_NONE;
+    }
+    char what[64];
+    snprintf(what, sizeof(what), "%u code points differ from the linear scan", mismatches);
+    check(mismatches == 0, "font_table_find", what);
+    check(found == font_table.glyphs_size, "font_table_find", "doesn't reach every glyph");
+
+    // Packed metrics are the ones of the character the scan finds
+    for (uint32_t i = 0; i < font_table.glyphs_size; i++) {
+        const FontGlyph *glyph = &font_table.glyphs[i];
+        const FontChar *font_char = &font[i];
+        check(glyph->x == font_char->x && glyph->y == font_char->y && glyph->width == font_char->w &&
+                  glyph->height == font_char->h && glyph->ascent == font_char->a &&
+                  glyph->bearing == font_char->b && glyph->advance == font_char->d &&
+                  (glyph->flags & FONT_GLYPH_COLORED) == (font_char->c ? FONT_GLYPH_COLORED : 0),
+              "font_table.glyphs", "metrics differ from font[]");
+    }
+}
+
+static void test_find_kerning(void) {
+    // Every pair of glyph indices including the ones past the table, so absent pairs are covered too
+    uint32_t mismatches = 0, kerned = 0;
+    for (uint32_t left = 0; left < 256; left++) {
+        for (uint32_t right = 0; right < 256; right++) {
+            int8_t kerning = font_table_find_kerning(left, right);
+            mismatches += kerning != reference_find_kerning(left, right);
+            kerned += kerning != 0;
+        }
+    }
+    char what[64];
+    snprintf(what, sizeof(what), "%u pairs differ from the linear scan", mismatches);
+    check(mismatches == 0, "font_table_find_kerning", what);
+    check(kerned > 0, "font_table_find_kerning", "finds no kerning");
+
+    // Keys stay sorted so the binary search holds
+    uint32_t unsorted = 0;
+    for (uint32_t i = 1; i < font_table.kernings_size; i++) {
+        unsorted += font_table.kerning_keys[i - 1] > font_table.kerning_keys[i];
+    }
+    check(unsorted == 0, "font_table.kerning_keys", "aren't in ascending order");
+}
+
+static void benchmark(void) {
+    // A line like the demo draws, looked up and kerned glyph by glyph
+    const char text[] = "The quick brown fox jumps over the lazy dog, AVATAR Wavy 1234567890 ~!@#$%";
+    size_t length = strlen(text);
+    int32_t rounds = 100000;
+    clock_t start = clock();
+    for (int32_t i = 0; i < rounds; i++) {
+        uint32_t sum = 0;
+        uint8_t previous = font_table_find((uint8_t)text[i % length]);
+        for (size_t j = 0; j < length; j++) {
+            uint8_t glyph = font_table_find((uint8_t)text[j]);
+            sum += glyph + font_table_find_kerning(previous, glyph);
+            previous = glyph;
+        }
+        benchmark_sink = sum;
+    }
+    double table = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (int32_t i = 0; i < rounds; i++) {
+        uint32_t sum = 0;
+        uint8_t previous = reference_find((uint8_t)text[i % length]);
+        for (size_t j = 0; j < length; j++) {
+            uint8_t glyph = reference_find((uint8_t)text[j]);
+            sum += glyph + reference_find_kerning(previous, glyph);
+            previous = glyph;
+        }
+        benchmark_sink = sum;
+    }
+    double reference = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("font_table_test: glyph and kerning lookup %.1f ns, linear scans %.1f ns per glyph\n",
+           table / rounds / length * 1e9, reference / rounds / length * 1e9);
+}
+
+int main(void) {
+    font_table_init();
+    test_find();
+    test_find_kerning();
+    if (test_report() != 0) return 1;
+    benchmark();
+    return 0;
+}
@@ -0,0 +1,204 @@
+// Host tests of the canvas_fill_textf formatter against snprintf: integers, floats, strings and characters with
+// every flag, width and precision it supports must print the same, and each documented difference prints as
+// documented. Followed by a benchmark of both on the demo's status line.
+
+#define TEST_NAME "format_test"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "format.h"
+#include "test.h"
+
+// Code points encoded back to UTF-8, so the output compares with snprintf byte for byte
+typedef struct TestOutput {
+    size_t size;
+    char text[256];
+} TestOutput;
+
+static void test_emit(void *context, uint32_t code_point) {
+    TestOutput *output = context;
+    if (output->size + 4 >= sizeof(output->text)) return;
+    char *out = &output->text[output->size];
+    if (code_point < 0x80) {
+        out[0] = code_point;
+        output->size += 1;
+    } else if (code_point < 0x800) {
+        out[0] = 0xc0 | (code_point >> 6);
+        out[1] = 0x80 | (code_point & 0x3f);
+        output->size += 2;
+    } else if (code_point < 0x10000) {
+        out[0] = 0xe0 | (code_point >> 12);
+        out[1] = 0x80 | ((code_point >> 6) & 0x3f);
+        out[2] = 0x80 | (code_point & 0x3f);
+        output->size += 3;
+    } else {
+        out[0] = 0xf0 | (code_point >> 18);
+        out[1] = 0x80 | ((code_point >> 12) & 0x3f);
+        out[2] = 0x80 | ((code_point >> 6) & 0x3f);
+        out[3] = 0x80 | (code_point & 0x3f);
+        output->size += 4;
+    }
+    output->text[output->size] = '\0';
+}
+
+static void format(TestOutput *output, const char *format, va_list arguments) {
+    output->size = 0;
+    output->text[0] = '\0';
+    format_write(format, arguments, test_emit, output);
+}
+
+// Formats with both and compares, expected NULL takes the snprintf output
+__attribute__((format(printf, 2, 3))) static void expect_snprintf(const char *name, const char *format_string, ...) {
+    char expected[256];
+    TestOutput output;
+    va_list arguments, copy;
+    va_start(arguments, format_string);
+    va_copy(copy, arguments);
+    vsnprintf(expected, sizeof(expected), format_string, copy);
+    va_end(copy);
+    format(&output, format_string, arguments);
+    va_end(arguments);
+    char what[640];
+    snprintf(what, sizeof(what), "\"%s\" prints \"%s\" instead of \"%s\"", format_string, output.text, expected);
+    check(strcmp(output.text, expected) == 0, name, what);
+}
+
+// For the documented differences, where snprintf prints something else or the format is undefined
+static void expect_text(const char *name, const char *expected, const char *format_string, ...) {
+    TestOutput output;
+    va_list arguments;
+    va_start(arguments, format_string);
+    format(&output, format_string, arguments);
+    va_end(arguments);
+    char what[640];
+    snprintf(what, sizeof(what), "\"%s\" prints \"%s\" instead of \"%s\"", format_string, output.text, expected);
+    check(strcmp(output.text, expected) == 0, name, what);
+}
+
+static void test_integers(void) {
+    static const int values[] = {0, 1, -1, 9, 10, -10, 255, 4096, -32768, 2147483647, -2147483647 - 1};
+    static const char *formats[] = {"%d", "%5d", "%05d", "%012d", "%1d", "[%3d]", "%u", "%8u", "%08u",
+                                    "%x", "%4x", "%08x", "%02x"};
+    char name[64];
+    for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); i++) {
+        snprintf(name, sizeof(name), "integer %s", formats[i]);
+        for (size_t j = 0; j < sizeof(values) / sizeof(values[0]); j++) expect_snprintf(name, formats[i], values[j]);
+        for (int32_t j = 0; j < 200; j++) {
+            int value = (int)(random_below(1 << 24) << 8 | random_below(256));
+            expect_snprintf(name, formats[i], value);
+        }
+    }
+}
+
+static void test_floats(void) {
+    // Values a quarter of the last digit away from a tie, small enough that float keeps the digit exact, printf
+    // rounds the exact binary value and the formatter rounds half away from zero in float
+    static const char *formats[] = {"%.0f", "%.1f", "%.2f", "%.3f", "%.4f", "%8.2f", "%08.2f", "%010.4f", "%3.1f"};
+    static const float powers[] = {1, 10, 100, 1000, 10000};
+    char name[64];
+    for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); i++) {
+        snprintf(name, sizeof(name), "float %s", formats[i]);
+        const char *dot = strchr(formats[i], '.');
+        int32_t precision = dot[1] - '0';
+        for (int32_t j = 0; j < 500; j++) {
+            int32_t units = (int32_t)random_below(100000) - 50000;
+            float value = (units + (random_below(2) ? 0.25f : -0.25f)) / powers[precision];
+            expect_snprintf(name, formats[i], value);
+        }
+        expect_snprintf(name, formats[i], 0.0);
+        expect_snprintf(name, formats[i], -0.01);
+    }
+}
+
+static void test_strings(void) {
+    static const char *formats[] = {"%s", "%8s", "%.3s", "%6.2s", "%.0s", "%1s", "<%s|%s>", "%c", "%4c"};
+    static const char *strings[] = {"", "a", "abc", "canvas", "a longer string than any width"};
+    char name[64];
+    for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); i++) {
+        snprintf(name, sizeof(name), "string %s", formats[i]);
+        for (size_t j = 0; j < sizeof(strings) / sizeof(strings[0]); j++) {
+            if (strchr(formats[i], 'c') != NULL) {
+                expect_snprintf(name, formats[i], 'a' + (int)j);
+            } else {
+                expect_snprintf(name, formats[i], strings[j], strings[0]);
+            }
+        }
+    }
+    expect_snprintf("literal", "100%% of %d", 3);
+    expect_snprintf("literal", u8"Ça fait %d€", 12);
+    expect_snprintf("mixed", "x=%d y=%.2f %s %c %04x", -12, 3.25f + 0.001f, "ok", '!', 0xbeef);
+}
+
+static void test_differences(void) {
+    // Widths and precisions count code points, snprintf counts bytes
+    expect_text("code point width", u8"    é", "%5s", u8"é");
+    expect_text("code point width", u8"  żółw", "%6s", u8"żółw");
+    expect_text("code point precision", u8"żó", "%.2s", u8"żółw");
+    expect_text("code point character", u8"  é", "%3c", 0xe9);
+    expect_text("code point character", u8"😀", "%c", 0x1f600);
+
+    // %f defaults to and stops at FORMAT_MAX_PRECISION decimals, out of range values clamp
+    expect_text("default precision", "3.1416", "%f", 3.14159265);
+    expect_text("largest precision", "0.3333", "%.9f", 1.0 / 3);
+    expect_text("half away from zero", "0.13 -0.13", "%.2f %.2f", 0.125, -0.125);
+    expect_text("not a number", "0.0000", "%f", NAN);
+    expect_text("too large", "400000.0000", "%f", 1e30);
+
+    // Incomplete and unknown specs print as written and take no argument, NULL strings print like glibc
+    expect_text("trailing percent", "100%", "100%");
+    expect_text("trailing width", "a %05", "a %05");
+    expect_text("trailing precision", "a %3.", "a %3.");
+    expect_text("unknown conversion", "%y 7", "%y %d", 7);
+    expect_text("unknown conversion", "%08.3q!", "%08.3q!");
+    expect_text("length modifier", "%ld", "%ld");
+    expect_text("multibyte conversion", u8"%é 5", u8"%é %d", 5);
+    expect_text("integer precision", "7", "%.3d", 7);
+    expect_text("null string", "  (null)", "%8s", (const char *)NULL);
+}
+
+// Formats the demo status line into glyph-sized pieces, returns a checksum so neither call is dropped
+static void benchmark_emit(void *context, uint32_t code_point) {
+    *(uint32_t *)context += code_point;
+}
+
+static uint32_t benchmark_format(const char *format_string, ...) {
+    uint32_t sum = 0;
+    va_list arguments;
+    va_start(arguments, format_string);
+    format_write(format_string, arguments, benchmark_emit, &sum);
+    va_end(arguments);
+    return sum;
+}
+
+static void benchmark(void) {
+    const char *status = "framebuffer=%dx%d viewport=%dx%d font_memory=%dKB fps=%.1f %s";
+    int32_t rounds = 500000;
+    clock_t start = clock();
+    for (int32_t i = 0; i < rounds; i++) benchmark_sink = benchmark_format(status, 640, 528, i, 480, 93, 59.94f, "ok");
+    double formatter = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (int32_t i = 0; i < rounds; i++) {
+        char text[128];
+        int size = snprintf(text, sizeof(text), status, 640, 528, i, 480, 93, 59.94f, "ok");
+        uint32_t sum = 0;
+        for (int j = 0; j < size; j++) sum += (uint8_t)text[j];
+        benchmark_sink = sum;
+    }
+    double reference = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("format_test: status line format_write %.0f ns, snprintf and a pass over its bytes %.0f ns\n",
+           formatter / rounds * 1e9, reference / rounds * 1e9);
+}
+
+int main(void) {
+    test_integers();
+    test_floats();
+    test_strings();
+    test_differences();
+    if (test_report() != 0) return 1;
+    benchmark();
+    return 0;
+}
@@ -0,0 +1,135 @@
+// Host tests of the glyph cache with data/lato.ttf at a size where a few dozen glyphs fill its pages: glyphs land in
+// the page tiles as the rasterizer draws them, an update never clears a page it filled itself, and full caches clear
+// the page least recently drawn or filled first
+
+#define TEST_NAME "glyph_cache_test"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "glyph_cache.h"
+#include "test.h"
+
+// Budget large enough to empty the queue in one update
+#define GLYPH_CACHE_TEST_BUDGET_US 10000000
+
+static uint8_t glyph_pixels[TRUETYPE_MAX_RASTER * TRUETYPE_MAX_RASTER];
+
+// Printable ASCII and Latin-1 over and over, more glyphs than the pages hold, so cleared glyphs are queued again
+static uint32_t next_code_point = 0x21;
+
+static GlyphCacheEntry *request_next(void) {
+    for (;;) {
+        uint32_t code_point = next_code_point++;
+        if (code_point == 0x7f) next_code_point = code_point = 0xc0;
+        if (code_point == 0xff) next_code_point = 0x21;
+        GlyphCacheEntry *entry = glyph_cache_find(code_point);
+        if (entry != NULL && entry->state == GLYPH_CACHE_QUEUED) return entry;
+    }
+}
+
+// Whether the texels of a ready entry are the glyph the rasterizer draws
+static bool entry_intact(GlyphCacheEntry *entry) {
+    TrueTypeBox box = {entry->box_x, entry->box_y, entry->box_x + entry->width, entry->box_y + entry->height};
+    truetype_rasterize(&glyph_cache.font, entry->glyph, glyph_cache.scale, &box, glyph_pixels, entry->width);
+    const uint8_t *texels = glyph_cache.pages[entry->page].texels;
+    for (uint32_t y = 0; y < entry->height; y++) {
+        for (uint32_t x = 0; x < entry->width; x++) {
+            uint32_t page_x = entry->x + x, page_y = entry->y + y;
+            uint8_t texel = texels[((page_y / 4) * (GLYPH_CACHE_PAGE_SIZE / 8) + page_x / 8) * 32 + (page_y % 4) * 8 +
+                                   page_x % 8];
+            if (texel != glyph_pixels[y * entry->width + x]) return false;
+        }
+    }
+    return true;
+}
+
+static void test_place(void) {
+    // One glyph per frame until the last page is started
+    uint32_t wrong = 0;
+    while (glyph_cache.pages_size < GLYPH_CACHE_PAGES_MAX) {
+        GlyphCacheEntry *entry = request_next();
+        glyph_cache_update(GLYPH_CACHE_TEST_BUDGET_US);
+        wrong += entry->state != GLYPH_CACHE_READY || !entry_intact(entry);
+    }
+    check(wrong == 0, "glyph_cache_update", "doesn't draw queued glyphs into the page tiles");
+    check(glyph_cache.evicted == 0, "glyph_cache_update", "clears a page before all pages are used");
+}
+
+static void test_refill(void) {
+    // The first three pages are drawn in the frame after the last page was started, so the last page is the oldest
+    glyph_cache_update(GLYPH_CACHE_TEST_BUDGET_US);
+    for (uint8_t page = 0; page < GLYPH_CACHE_PAGES_MAX - 1; page++) glyph_cache_touch(page);
+
+    // One update fills the rest of the last page and has to clear another for the remaining glyphs
+    GlyphCacheEntry *entries[GLYPH_CACHE_QUEUE_SIZE];
+    for (uint32_t i = 0; i < GLYPH_CACHE_QUEUE_SIZE; i++) entries[i] = request_next();
+    uint32_t evicted = glyph_cache.evicted;
+    glyph_cache_update(GLYPH_CACHE_TEST_BUDGET_US);
+    check(glyph_cache.evicted > evicted, "refill", "doesn't clear a page");
+    uint32_t last_page = 0, lost = 0, cleared_first = 0;
+    for (uint32_t i = 0; i < GLYPH_CACHE_QUEUE_SIZE; i++) {
+        if (entries[i]->state == GLYPH_CACHE_QUEUED) continue;
+        last_page += entries[i]->page == GLYPH_CACHE_PAGES_MAX - 1;
+        lost += entries[i]->state != GLYPH_CACHE_READY || !entry_intact(entries[i]);
+        cleared_first += entries[i]->page == 0 && entries[i]->x == 0 && entries[i]->y == 0;
+    }
+    check(last_page > 0, "refill", "doesn't fill the last page first");
+    check(lost == 0, "refill", "clears glyphs it drew in the same update");
+    check(cleared_first == 1, "refill", "doesn't clear the least recently drawn page");
+}
+
+static void test_order(void) {
+    // Draw the pages one per frame in a shuffled order, then add one glyph per frame, placing a glyph uses its page
+    static const uint8_t order[GLYPH_CACHE_PAGES_MAX] = {2, 1, 3, 0};
+    while (glyph_cache.queue_size > 0) glyph_cache_update(GLYPH_CACHE_TEST_BUDGET_US);
+    for (uint32_t i = 0; i < GLYPH_CACHE_PAGES_MAX; i++) {
+        glyph_cache_update(GLYPH_CACHE_TEST_BUDGET_US);
+        glyph_cache_touch(order[i]);
+    }
+    uint32_t cleared = 0, frames = 0, lost = 0, not_oldest = 0;
+    bool pages_cleared[GLYPH_CACHE_PAGES_MAX] = {false};
+    while (cleared < 2 * GLYPH_CACHE_PAGES_MAX && frames++ < 1000) {
+        uint32_t last_used[GLYPH_CACHE_PAGES_MAX], oldest = UINT32_MAX;
+        for (uint32_t i = 0; i < GLYPH_CACHE_PAGES_MAX; i++) {
+            last_used[i] = glyph_cache.pages[i].last_used;
+            if (last_used[i] < oldest) oldest = last_used[i];
+        }
+        GlyphCacheEntry *entry = request_next();
+        uint32_t evicted = glyph_cache.evicted;
+        glyph_cache_update(GLYPH_CACHE_TEST_BUDGET_US);
+        lost += entry->state != GLYPH_CACHE_READY || !entry_intact(entry);
+        if (glyph_cache.evicted == evicted) continue;
+
+        // The new glyph is the first on the page that was cleared for it
+        cleared++;
+        not_oldest += last_used[entry->page] != oldest || entry->x != 0 || entry->y != 0;
+        pages_cleared[entry->page] = true;
+    }
+    check(cleared == 2 * GLYPH_CACHE_PAGES_MAX, "order", "stops clearing pages");
+    check(lost == 0, "order", "loses a glyph it just drew");
+    check(not_oldest == 0, "order", "clears a page that was used more recently than another");
+    for (uint32_t i = 0; i < GLYPH_CACHE_PAGES_MAX; i++) check(pages_cleared[i], "order", "never clears a page");
+}
+
+int main(void) {
+    FILE *file = fopen("data/lato.ttf", "rb");
+    check(file != NULL, "data/lato.ttf", "can't be opened");
+    if (file == NULL) return 1;
+    fseek(file, 0, SEEK_END);
+    uint32_t size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    uint8_t *data = malloc(size);
+    check(fread(data, 1, size, file) == size, "data/lato.ttf", "can't be read");
+    fclose(file);
+
+    // About 70 pixels to the cap height, so each page holds a handful of glyphs
+    check(glyph_cache_init(data, size, 100.0f / 2000), "glyph_cache_init", "doesn't load data/lato.ttf");
+    test_place();
+    test_refill();
+    test_order();
+    for (uint32_t i = 0; i < glyph_cache.pages_size; i++) free(glyph_cache.pages[i].texels);
+    free(data);
+    return test_report();
+}
@@ -0,0 +1,200 @@
+// Host definitions of the libogc calls in tests/include/gccore.h, texture objects only remember what they were given
+// and drawing calls only count the bytes libogc would write for them
+
+#include <gccore.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+// Register writes as the FIFO packets libogc sends, a BP or CP register and XF memory of n words
+#define HOST_BP_BYTES 5
+#define HOST_CP_BYTES 6
+#define HOST_XF_BYTES(n) (5 + 4 * (n))
+
+GXHost gx_host;
+
+static void host_write(u32 bytes) {
+    if (gx_host.recording) {
+        gx_host.list_bytes += bytes;
+    } else {
+        gx_host.fifo_bytes += bytes;
+    }
+}
+
+void GX_InitTexObj(GXTexObj *obj, void *img_ptr, u16 wd, u16 ht, u8 fmt, u8 wrap_s, u8 wrap_t, u8 mipmap) {
+    *obj = (GXTexObj){.image = img_ptr, .width = wd, .height = ht, .format = fmt};
+}
+
+void GX_InitTexObjCI(GXTexObj *obj, void *img_ptr, u16 wd, u16 ht, u8 fmt, u8 wrap_s, u8 wrap_t, u8 mipmap,
+                     u32 tlut_name) {
+    *obj = (GXTexObj){.image = img_ptr, .width = wd, .height = ht, .format = fmt, .tlut_name = tlut_name};
+}
+
+void GX_InitTlutObj(GXTlutObj *obj, void *lut, u8 fmt, u16 entries) {
+    *obj = (GXTlutObj){.lut = lut, .format = fmt, .entries = entries};
+}
+
+void GX_LoadTlut(GXTlutObj *obj, u32 tlut_name) {}
+
+u32 GX_GetTexBufferSize(u16 wd, u16 ht, u32 fmt, u8 mipmap, u8 maxlod) {
+    // Tiles are 32 bytes, RGBA8 tiles take two cache lines for 4x4 texels
+    u32 tile_width = 4, tile_height = 4, tile_size = 32;
+    switch (fmt) {
+        case GX_TF_I4:
+        case GX_TF_CI4:
+        case GX_TF_CMPR:
+            tile_width = 8, tile_height = 8;
+            break;
+        case GX_TF_I8:
+        case GX_TF_IA4:
+        case GX_TF_CI8:
+            tile_width = 8;
+            break;
+        case GX_TF_RGBA8:
+            tile_size = 64;
+            break;
+    }
+    return ((wd + tile_width - 1) / tile_width) * ((ht + tile_height - 1) / tile_height) * tile_size;
+}
+
+void DCFlushRange(void *startaddress, u32 len) {}
+
+void SYS_Report(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+void DCInvalidateRange(void *startaddress, u32 len) {}
+
+void GX_Begin(u8 primitive, u8 vtxfmt, u16 vtxcnt) {
+    gx_host.begins++;
+    gx_host.vertices += vtxcnt;
+    if (gx_host.recording) gx_host.list_vertices += vtxcnt;
+    host_write(3);
+}
+
+void GX_End(void) {}
+
+void GX_Position2f32(f32 x, f32 y) { host_write(8); }
+
+void GX_Position2s16(s16 x, s16 y) { host_write(4); }
+
+void GX_Position1x8(u8 index) { host_write(1); }
+
+void GX_Color1u32(u32 color) { host_write(4); }
+
+void GX_TexCoord2f32(f32 s, f32 t) { host_write(8); }
+
+void GX_TexCoord2u16(u16 s, u16 t) { host_write(4); }
+
+void GX_TexCoord2u8(u8 s, u8 t) { host_write(2); }
+
+void GX_TexCoord1x8(u8 index) { host_write(1); }
+
+void GX_LoadPosMtxImm(Mtx mt, u32 pnidx) {
+    gx_host.matrix_loads++;
+    if (!gx_host.recording) memcpy(gx_host.matrix, mt, sizeof(Mtx));
+    host_write(HOST_XF_BYTES(12));
+}
+
+void GX_LoadProjectionMtx(Mtx44 mt, u8 type) { host_write(HOST_XF_BYTES(7)); }
+
+void GX_LoadTexObj(GXTexObj *obj, u8 mapid) {
+    // Mode, size and address registers, and the TLUT register of color indexed textures
+    gx_host.texture_loads++;
+    bool indexed = obj->format == GX_TF_CI4 || obj->format == GX_TF_CI8;
+    host_write((indexed ? 5 : 4) * HOST_BP_BYTES);
+}
+
+u8 GX_GetTexObjFmt(GXTexObj *obj) { return obj->format; }
+
+u16 GX_GetTexObjWidth(GXTexObj *obj) { return obj->width; }
+
+u16 GX_GetTexObjHeight(GXTexObj *obj) { return obj->height; }
+
+void GX_InvalidateTexAll(void) { host_write(2 * HOST_BP_BYTES); }
+
+void GX_SetArray(u32 attr, void *ptr, u8 stride) { host_write(2 * HOST_CP_BYTES); }
+
+void GX_ClearVtxDesc(void) { host_write(2 * HOST_CP_BYTES); }
+
+void GX_SetVtxDesc(u8 attr, u8 type) { host_write(HOST_CP_BYTES); }
+
+void GX_SetVtxAttrFmt(u8 vtxfmt, u32 vtxattr, u32 comptype, u32 compsize, u32 frac) { host_write(HOST_CP_BYTES); }
+
+void GX_SetZMode(u8 enable, u8 func, u8 update_enable) { host_write(HOST_BP_BYTES); }
+
+void GX_SetCullMode(u8 mode) { host_write(HOST_BP_BYTES); }
+
+void GX_SetBlendMode(u8 type, u8 src_fact, u8 dst_fact, u8 op) { host_write(HOST_BP_BYTES); }
+
+void GX_SetNumChans(u8 num) { host_write(HOST_XF_BYTES(1)); }
+
+void GX_SetNumTexGens(u32 nr) { host_write(HOST_XF_BYTES(1) + HOST_BP_BYTES); }
+
+void GX_SetTexCoordGen(u16 texcoord, u32 tgen_typ, u32 tgen_src, u32 mtxsrc) { host_write(2 * HOST_XF_BYTES(1)); }
+
+void GX_SetNumTevStages(u8 num) { host_write(HOST_BP_BYTES); }
+
+void GX_SetAlphaCompare(u8 comp0, u8 ref0, u8 aop, u8 comp1, u8 ref1) { host_write(HOST_BP_BYTES); }
+
+void GX_SetTevOrder(u8 tevstage, u8 texcoord, u32 texmap, u8 color) { host_write(HOST_BP_BYTES); }
+
+void GX_SetTevOp(u8 tevstage, u8 mode) { host_write(4 * HOST_BP_BYTES); }
+
+void GX_SetTevColorIn(u8 tevstage, u8 a, u8 b, u8 c, u8 d) { host_write(HOST_BP_BYTES); }
+
+void GX_SetTevAlphaIn(u8 tevstage, u8 a, u8 b, u8 c, u8 d) { host_write(HOST_BP_BYTES); }
+
+void GX_SetTevAlphaOp(u8 tevstage, u8 tevop, u8 tevbias, u8 tevscale, u8 clamp, u8 tevregid) {
+    host_write(HOST_BP_BYTES);
+}
+
+void GX_SetTevKAlphaSel(u8 tevstage, u8 sel) { host_write(HOST_BP_BYTES); }
+
+void GX_BeginDispList(void *list, u32 size) {
+    gx_host.recording = true;
+    gx_host.list_bytes = 0;
+    gx_host.list_capacity = size;
+}
+
+u32 GX_EndDispList(void) {
+    // Lists are padded to 32 bytes, and like libogc an overflowed list has size 0
+    gx_host.recording = false;
+    u32 size = (gx_host.list_bytes + 31) & ~31;
+    return size > gx_host.list_capacity ? 0 : size;
+}
+
+void GX_CallDispList(void *list, u32 nbytes) {
+    gx_host.list_calls++;
+    host_write(9);
+}
+
+void GX_Flush(void) { host_write(32); }
+
+void guMtxIdentity(Mtx mt) {
+    memset(mt, 0, sizeof(Mtx));
+    mt[0][0] = mt[1][1] = mt[2][2] = 1;
+}
+
+void guMtxCopy(Mtx src, Mtx dst) { memmove(dst, src, sizeof(Mtx)); }
+
+void guMtxTrans(Mtx mt, f32 xT, f32 yT, f32 zT) {
+    guMtxIdentity(mt);
+    mt[0][3] = xT;
+    mt[1][3] = yT;
+    mt[2][3] = zT;
+}
+
+void guOrtho(Mtx44 mt, f32 t, f32 b, f32 l, f32 r, f32 n, f32 f) {
+    memset(mt, 0, sizeof(Mtx44));
+    mt[0][0] = 2 / (r - l);
+    mt[0][3] = -(r + l) / (r - l);
+    mt[1][1] = 2 / (t - b);
+    mt[1][3] = -(t + b) / (t - b);
+    mt[2][2] = -1 / (f - n);
+    mt[2][3] = -f / (f - n);
+    mt[3][3] = 1;
+}
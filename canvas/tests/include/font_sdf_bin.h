@@ -0,0 +1,9 @@
+#pragma once
+
+// Host stand-in for the bin2o header, the data comes from tests/assets.S
+
+#include <gccore.h>
+
+extern const u8 font_sdf_bin_end[];
+extern const u8 font_sdf_bin[];
+extern const u32 font_sdf_bin_size;
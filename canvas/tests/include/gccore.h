@@ -0,0 +1,196 @@
+#pragma once
+
+// Host stand-in for the parts of libogc the canvas uses, so the host tests can build it without devkitPPC and count
+// what it sends to the GPU
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef int16_t s16;
+typedef int32_t s32;
+typedef float f32;
+
+typedef f32 Mtx[3][4];
+typedef f32 (*MtxP)[4];
+typedef f32 Mtx44[4][4];
+
+typedef struct guVector {
+    f32 x, y, z;
+} guVector;
+
+typedef struct GXTexObj {
+    void *image;
+    u16 width;
+    u16 height;
+    u8 format;
+    u32 tlut_name;
+} GXTexObj;
+
+typedef struct GXTlutObj {
+    void *lut;
+    u8 format;
+    u16 entries;
+} GXTlutObj;
+
+#define GX_FALSE 0
+#define GX_TRUE 1
+#define GX_DISABLE 0
+#define GX_CLAMP 0
+
+#define GX_TF_I4 0x0
+#define GX_TF_I8 0x1
+#define GX_TF_IA4 0x2
+#define GX_TF_IA8 0x3
+#define GX_TF_RGB565 0x4
+#define GX_TF_RGB5A3 0x5
+#define GX_TF_RGBA8 0x6
+#define GX_TF_CI4 0x8
+#define GX_TF_CI8 0x9
+#define GX_TF_CMPR 0xe
+
+#define GX_TL_IA8 0x0
+#define GX_TL_RGB565 0x1
+#define GX_TL_RGB5A3 0x2
+
+#define GX_TLUT0 0
+
+#define GX_QUADS 0x80
+#define GX_VTXFMT0 0
+#define GX_VTXFMT1 1
+#define GX_PNMTX0 0
+#define GX_ORTHOGRAPHIC 1
+
+#define GX_NONE 0
+#define GX_DIRECT 1
+#define GX_INDEX8 2
+#define GX_VA_POS 9
+#define GX_VA_CLR0 11
+#define GX_VA_TEX0 13
+#define GX_POS_XY 0
+#define GX_CLR_RGBA 1
+#define GX_TEX_ST 1
+#define GX_U8 0
+#define GX_S16 3
+#define GX_U16 2
+#define GX_F32 4
+#define GX_RGBA8 5
+
+#define GX_NEVER 0
+#define GX_GREATER 4
+#define GX_LEQUAL 3
+#define GX_ALWAYS 7
+#define GX_AOP_AND 0
+#define GX_CULL_NONE 0
+#define GX_BM_NONE 0
+#define GX_BM_BLEND 1
+#define GX_BL_SRCALPHA 4
+#define GX_BL_INVSRCALPHA 5
+#define GX_LO_CLEAR 0
+
+#define GX_TEXCOORD0 0
+#define GX_TEXCOORDNULL 0xff
+#define GX_TEXMAP0 0
+#define GX_TEXMAP_NULL 0xff
+#define GX_COLOR0A0 4
+#define GX_TG_MTX2x4 1
+#define GX_TG_TEX0 4
+#define GX_IDENTITY 60
+#define GX_TEVSTAGE0 0
+#define GX_TEVSTAGE1 1
+#define GX_MODULATE 0
+#define GX_TEV_ADD 0
+#define GX_TEV_SUB 1
+#define GX_TB_ZERO 0
+#define GX_CS_SCALE_1 0
+#define GX_CS_SCALE_4 2
+#define GX_TEVPREV 0
+#define GX_CC_CPREV 0
+#define GX_CC_RASC 10
+#define GX_CC_ZERO 15
+#define GX_CA_APREV 0
+#define GX_CA_TEXA 4
+#define GX_CA_RASA 5
+#define GX_CA_KONST 6
+#define GX_CA_ZERO 7
+#define GX_TEV_KASEL_3_8 5
+#define GX_TEV_KASEL_1 0
+
+void GX_InitTexObj(GXTexObj *obj, void *img_ptr, u16 wd, u16 ht, u8 fmt, u8 wrap_s, u8 wrap_t, u8 mipmap);
+void GX_InitTexObjCI(GXTexObj *obj, void *img_ptr, u16 wd, u16 ht, u8 fmt, u8 wrap_s, u8 wrap_t, u8 mipmap,
+                     u32 tlut_name);
+void GX_InitTlutObj(GXTlutObj *obj, void *lut, u8 fmt, u16 entries);
+void GX_LoadTlut(GXTlutObj *obj, u32 tlut_name);
+u32 GX_GetTexBufferSize(u16 wd, u16 ht, u32 fmt, u8 mipmap, u8 maxlod);
+void DCFlushRange(void *startaddress, u32 len);
+void DCInvalidateRange(void *startaddress, u32 len);
+void SYS_Report(const char *format, ...);
+
+// Drawing calls, counted instead of drawn
+typedef struct GXHost {
+    u32 begins;
+    u32 vertices;
+    u32 matrix_loads;
+    u32 texture_loads;
+    u32 list_calls;
+
+    // Vertices that went into a display list, and the position matrix the FIFO last received
+    u32 list_vertices;
+    Mtx matrix;
+
+    // Bytes the calls wrote to the FIFO, and to the display list that was open instead
+    u32 fifo_bytes;
+    u32 list_bytes;
+    u32 list_capacity;
+    bool recording;
+} GXHost;
+
+extern GXHost gx_host;
+
+void GX_Begin(u8 primitive, u8 vtxfmt, u16 vtxcnt);
+void GX_End(void);
+void GX_Position2f32(f32 x, f32 y);
+void GX_Position2s16(s16 x, s16 y);
+void GX_Position1x8(u8 index);
+void GX_Color1u32(u32 color);
+void GX_TexCoord2f32(f32 s, f32 t);
+void GX_TexCoord2u16(u16 s, u16 t);
+void GX_TexCoord2u8(u8 s, u8 t);
+void GX_TexCoord1x8(u8 index);
+void GX_LoadPosMtxImm(Mtx mt, u32 pnidx);
+void GX_LoadProjectionMtx(Mtx44 mt, u8 type);
+void GX_LoadTexObj(GXTexObj *obj, u8 mapid);
+u8 GX_GetTexObjFmt(GXTexObj *obj);
+u16 GX_GetTexObjWidth(GXTexObj *obj);
+u16 GX_GetTexObjHeight(GXTexObj *obj);
+void GX_InvalidateTexAll(void);
+void GX_SetArray(u32 attr, void *ptr, u8 stride);
+void GX_ClearVtxDesc(void);
+void GX_SetVtxDesc(u8 attr, u8 type);
+void GX_SetVtxAttrFmt(u8 vtxfmt, u32 vtxattr, u32 comptype, u32 compsize, u32 frac);
+void GX_SetZMode(u8 enable, u8 func, u8 update_enable);
+void GX_SetCullMode(u8 mode);
+void GX_SetBlendMode(u8 type, u8 src_fact, u8 dst_fact, u8 op);
+void GX_SetNumChans(u8 num);
+void GX_SetNumTexGens(u32 nr);
+void GX_SetTexCoordGen(u16 texcoord, u32 tgen_typ, u32 tgen_src, u32 mtxsrc);
+void GX_SetNumTevStages(u8 num);
+void GX_SetAlphaCompare(u8 comp0, u8 ref0, u8 aop, u8 comp1, u8 ref1);
+void GX_SetTevOrder(u8 tevstage, u8 texcoord, u32 texmap, u8 color);
+void GX_SetTevOp(u8 tevstage, u8 mode);
+void GX_SetTevColorIn(u8 tevstage, u8 a, u8 b, u8 c, u8 d);
+void GX_SetTevAlphaIn(u8 tevstage, u8 a, u8 b, u8 c, u8 d);
+void GX_SetTevAlphaOp(u8 tevstage, u8 tevop, u8 tevbias, u8 tevscale, u8 clamp, u8 tevregid);
+void GX_SetTevKAlphaSel(u8 tevstage, u8 sel);
+void GX_BeginDispList(void *list, u32 size);
+u32 GX_EndDispList(void);
+void GX_CallDispList(void *list, u32 nbytes);
+void GX_Flush(void);
+
+void guMtxIdentity(Mtx mt);
+void guMtxCopy(Mtx src, Mtx dst);
+void guMtxTrans(Mtx mt, f32 xT, f32 yT, f32 zT);
+void guOrtho(Mtx44 mt, f32 t, f32 b, f32 l, f32 r, f32 n, f32 f);
@@ -0,0 +1,9 @@
+#pragma once
+
+// Host stand-in for the bin2o header, the data comes from tests/assets.S
+
+#include <gccore.h>
+
+extern const u8 lato_ttf_end[];
+extern const u8 lato_ttf[];
+extern const u32 lato_ttf_size;
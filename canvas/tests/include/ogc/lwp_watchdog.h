@@ -0,0 +1,14 @@
+#pragma once
+
+// Host stand-in for the libogc timer, ticks are microseconds
+
+#include <stdint.h>
+#include <time.h>
+
+static inline uint64_t gettime(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static inline uint32_t diff_usec(uint64_t start, uint64_t end) { return end - start; }
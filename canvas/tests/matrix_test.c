@@ -0,0 +1,200 @@
+// Host tests of the matrix kernels against the C versions of guMtxConcat, guMtxRotRad and guVecMultiply in libogc,
+// followed by a benchmark of both. Fused multiply adds round differently from libogc's C, so results may be a few
+// ulps of the largest product apart.
+
+#define TEST_NAME "matrix_test"
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "matrix.h"
+#include "test.h"
+
+static float random_float(float range) { return ((random_next() >> 8) / (float)(1 << 24) * 2 - 1) * range; }
+
+// c_guMtxConcat, out of line like matrix_concat
+__attribute__((noinline)) static void reference_concat(Mtx a, Mtx b, Mtx ab) {
+    Mtx temp;
+    for (int32_t row = 0; row < 3; row++) {
+        for (int32_t column = 0; column < 4; column++) {
+            temp[row][column] = a[row][0] * b[0][column] + a[row][1] * b[1][column] + a[row][2] * b[2][column];
+        }
+        temp[row][3] += a[row][3];
+    }
+    for (int32_t row = 0; row < 3; row++) {
+        for (int32_t column = 0; column < 4; column++) ab[row][column] = temp[row][column];
+    }
+}
+
+// c_guMtxRotRad for the x and y axes
+static void reference_rotation(Mtx m, char axis, float sin, float cos) {
+    for (int32_t row = 0; row < 3; row++) {
+        for (int32_t column = 0; column < 4; column++) m[row][column] = row == column;
+    }
+    if (axis == 'x') {
+        m[1][1] = cos, m[1][2] = -sin;
+        m[2][1] = sin, m[2][2] = cos;
+    } else {
+        m[0][0] = cos, m[0][2] = sin;
+        m[2][0] = -sin, m[2][2] = cos;
+    }
+}
+
+// c_guVecMultiply
+static void reference_vec_multiply(Mtx m, guVector *src, guVector *dst) {
+    guVector temp;
+    temp.x = m[0][0] * src->x + m[0][1] * src->y + m[0][2] * src->z + m[0][3];
+    temp.y = m[1][0] * src->x + m[1][1] * src->y + m[1][2] * src->z + m[1][3];
+    temp.z = m[2][0] * src->x + m[2][1] * src->y + m[2][2] * src->z + m[2][3];
+    *dst = temp;
+}
+
+// The loop canvas.c would need without matrix_transform_points_2d, kept out of line like the kernel it is timed against
+__attribute__((noinline)) static void reference_transform_points(Mtx m, const float *src, float *dst, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        guVector point = {src[i * 2], src[i * 2 + 1], 0}, out;
+        reference_vec_multiply(m, &point, &out);
+        dst[i * 2] = out.x, dst[i * 2 + 1] = out.y;
+    }
+}
+
+static void random_matrix(Mtx m, float range) {
+    for (int32_t row = 0; row < 3; row++) {
+        for (int32_t column = 0; column < 4; column++) m[row][column] = random_float(range);
+    }
+}
+
+// Both results are sums of the same terms, each rounding moves them by at most half an ulp of the largest term
+static int within(float value, float expected, float magnitude, int32_t ulps) {
+    return fabsf(value - expected) <= magnitude * FLT_EPSILON * ulps;
+}
+
+static void test_concat(void) {
+    for (int32_t i = 0; i < 10000; i++) {
+        Mtx a, b, ab, expected;
+        random_matrix(a, 4);
+        random_matrix(b, i & 1 ? 4 : 300);
+        matrix_concat(a, b, ab);
+        reference_concat(a, b, expected);
+        int32_t passed = 1;
+        for (int32_t row = 0; row < 3; row++) {
+            for (int32_t column = 0; column < 4; column++) {
+                float magnitude = fabsf(a[row][0] * b[0][column]) + fabsf(a[row][1] * b[1][column]) +
+                                  fabsf(a[row][2] * b[2][column]) + (column == 3 ? fabsf(a[row][3]) : 0);
+                passed &= within(ab[row][column], expected[row][column], magnitude, 2);
+            }
+        }
+        check(passed, "matrix_concat", "differs from guMtxConcat");
+
+        // Concatenating into one of the inputs works like guMtxConcat does
+        matrix_concat(a, b, a);
+        int32_t aliased = 1;
+        for (int32_t row = 0; row < 3; row++) {
+            for (int32_t column = 0; column < 4; column++) aliased &= a[row][column] == ab[row][column];
+        }
+        check(aliased, "matrix_concat", "output aliasing the input changes the result");
+    }
+}
+
+static void test_rotation(void) {
+    for (int32_t i = 0; i < 1000; i++) {
+        float angle_x = random_float(M_PI), angle_y = random_float(M_PI);
+        float x = random_float(100), y = random_float(100), z = random_float(100);
+        Mtx m, rotation_x, rotation_y, expected;
+        matrix_rotation_xy(m, sinf(angle_x), cosf(angle_x), sinf(angle_y), cosf(angle_y), x, y, z);
+        reference_rotation(rotation_x, 'x', sinf(angle_x), cosf(angle_x));
+        reference_rotation(rotation_y, 'y', sinf(angle_y), cosf(angle_y));
+        reference_concat(rotation_x, rotation_y, expected);
+        expected[0][3] = x, expected[1][3] = y, expected[2][3] = z;
+        int32_t passed = 1;
+        for (int32_t row = 0; row < 3; row++) {
+            for (int32_t column = 0; column < 4; column++) {
+                passed &= within(m[row][column], expected[row][column], 1, 1);
+            }
+        }
+        check(passed, "matrix_rotation_xy", "differs from guMtxRotRad x then y");
+    }
+}
+
+static void test_transform_points(void) {
+    // Every count up to an odd one, so no batch size is special, and a sentinel past the last point
+    float src[2 * 37], dst[2 * 38];
+    for (int32_t i = 0; i < 1000; i++) {
+        Mtx m;
+        random_matrix(m, i & 1 ? 2 : 640);
+        for (int32_t j = 0; j < 2 * 37; j++) src[j] = random_float(640);
+        uint32_t count = i % 38;
+        dst[count * 2] = 12345;
+        matrix_transform_points_2d(m, src, dst, count);
+        int32_t passed = 1;
+        for (uint32_t j = 0; j < count; j++) {
+            guVector point = {src[j * 2], src[j * 2 + 1], 0}, expected;
+            reference_vec_multiply(m, &point, &expected);
+            float magnitude_x = fabsf(m[0][0] * point.x) + fabsf(m[0][1] * point.y) + fabsf(m[0][3]);
+            float magnitude_y = fabsf(m[1][0] * point.x) + fabsf(m[1][1] * point.y) + fabsf(m[1][3]);
+            passed &= within(dst[j * 2], expected.x, magnitude_x, 2);
+            passed &= within(dst[j * 2 + 1], expected.y, magnitude_y, 2);
+        }
+        check(passed, "matrix_transform_points_2d", "differs from guVecMultiply");
+        check(dst[count * 2] == 12345, "matrix_transform_points_2d", "wrote past count points");
+    }
+}
+
+static void benchmark(void) {
+    Mtx a, b, ab;
+    random_matrix(a, 1);
+    random_matrix(b, 1);
+    int32_t rounds = 2000000;
+    clock_t start = clock();
+    for (int32_t i = 0; i < rounds; i++) {
+        a[0][3] = i;
+        matrix_concat(a, b, ab);
+        benchmark_sink = ab[0][3] != 0;
+    }
+    double concat = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (int32_t i = 0; i < rounds; i++) {
+        a[0][3] = i;
+        reference_concat(a, b, ab);
+        benchmark_sink = ab[0][3] != 0;
+    }
+    double reference = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("matrix_test: matrix_concat %.1f ns, guMtxConcat %.1f ns\n", concat / rounds * 1e9,
+           reference / rounds * 1e9);
+
+    // A frame worth of quad corners
+    int32_t points_size = 4096;
+    float *src = malloc(points_size * 2 * sizeof(float)), *dst = malloc(points_size * 2 * sizeof(float));
+    for (int32_t i = 0; i < points_size * 2; i++) src[i] = random_float(640);
+    rounds = 2000;
+    start = clock();
+    for (int32_t i = 0; i < rounds; i++) {
+        a[0][3] = i;
+        matrix_transform_points_2d(a, src, dst, points_size);
+        benchmark_sink = dst[0] != 0;
+    }
+    double points = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (int32_t i = 0; i < rounds; i++) {
+        a[0][3] = i;
+        reference_transform_points(a, src, dst, points_size);
+        benchmark_sink = dst[0] != 0;
+    }
+    reference = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("matrix_test: matrix_transform_points_2d %.2f ns, guVecMultiply %.2f ns per point\n",
+           points / rounds / points_size * 1e9, reference / rounds / points_size * 1e9);
+    free(src);
+    free(dst);
+}
+
+int main(void) {
+    test_concat();
+    test_rotation();
+    test_transform_points();
+    if (test_report() != 0) return 1;
+    benchmark();
+    return 0;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+// Check counting shared by the host tests, each test defines TEST_NAME to the prefix of its output before including
+// this header
+
+#include <stdint.h>
+#include <stdio.h>
+
+static uint32_t checks, failures;
+
+// Keeps the benchmark loops from being optimized away
+static volatile uint32_t benchmark_sink __attribute__((unused));
+
+static uint32_t random_state = 1;
+
+static void check(int passed, const char *name, const char *what) {
+    checks++;
+    if (passed) return;
+    failures++;
+    printf(TEST_NAME ": %s: %s\n", name, what);
+}
+
+// Linear congruential generator, so every host sees the same sequence
+__attribute__((unused)) static uint32_t random_next(void) {
+    random_state = random_state * 1103515245 + 12345;
+    return random_state;
+}
+
+__attribute__((unused)) static uint32_t random_below(uint32_t limit) {
+    return ((random_next() >> 8) & 0xffffff) % limit;
+}
+
+// Prints the summary line, nonzero when a check failed
+static int test_report(void) {
+    if (failures > 0) {
+        printf(TEST_NAME ": %u of %u checks failed\n", failures, checks);
+        return 1;
+    }
+    printf(TEST_NAME ": %u checks passed\n", checks);
+    return 0;
+}
@@ -0,0 +1,425 @@
+// Host tests of the texture converters: every format is encoded, untiled and decoded by a reference decoder written
+// from the GX texel layouts and its largest channel error is checked, dithering must keep the average color. The
+// RGBA8 swizzle is checked byte for byte and timed against the byte-wise swizzle it replaced. The cursors must pick
+// a palette format once they may, and a load in another format must zero the palette.
+
+#define TEST_NAME "texture_test"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "stb_image.h"
+#include "texture.h"
+#include "test.h"
+
+// Odd sizes so every format has partial tiles on the right and bottom edges
+#define TEST_WIDTH 37
+#define TEST_HEIGHT 29
+
+static uint8_t random_byte(void) { return random_next() >> 16; }
+
+static int32_t expand(int32_t value, int32_t bits) {
+    int32_t expanded = value << (8 - bits);
+    for (int32_t shift = bits; shift < 8; shift += bits) expanded |= expanded >> shift;
+    return expanded;
+}
+
+static void decode_rgb565(uint32_t value, uint8_t *pixel) {
+    pixel[0] = expand(value >> 11, 5);
+    pixel[1] = expand((value >> 5) & 0x3f, 6);
+    pixel[2] = expand(value & 0x1f, 5);
+    pixel[3] = 0xff;
+}
+
+static void decode_cmpr_block(const uint8_t *block, int32_t x, int32_t y, int32_t width, int32_t height,
+                              uint8_t *dst) {
+    // GX blends four color blocks 5/8 and 3/8, three color blocks average and make index 3 a transparent copy of
+    // the average
+    uint32_t color0 = (block[0] << 8) | block[1], color1 = (block[2] << 8) | block[3];
+    uint8_t colors[4][4];
+    decode_rgb565(color0, colors[0]);
+    decode_rgb565(color1, colors[1]);
+    for (int32_t c = 0; c < 3; c++) {
+        if (color0 > color1) {
+            colors[2][c] = (colors[0][c] * 5 + colors[1][c] * 3) >> 3;
+            colors[3][c] = (colors[0][c] * 3 + colors[1][c] * 5) >> 3;
+        } else {
+            colors[2][c] = colors[3][c] = (colors[0][c] + colors[1][c]) / 2;
+        }
+    }
+    colors[2][3] = 0xff;
+    colors[3][3] = color0 > color1 ? 0xff : 0;
+    for (int32_t ry = 0; ry < 4; ry++) {
+        for (int32_t rx = 0; rx < 4; rx++) {
+            if (x + rx >= width || y + ry >= height) continue;
+            uint32_t index = (block[4 + ry] >> (6 - rx * 2)) & 3;
+            memcpy(&dst[((y + ry) * width + x + rx) * 4], colors[index], 4);
+        }
+    }
+}
+
+// Untiles and decodes texels to RGBA, intensities as opaque gray since the tests feed intensity formats opaque gray
+static void decode(const uint8_t *texels, int32_t width, int32_t height, uint8_t format, uint8_t *dst) {
+    if (format == GX_TF_CMPR) {
+        // 8x8 tiles of four 4x4 blocks in reading order
+        for (int32_t y = 0; y < height; y += 8) {
+            for (int32_t x = 0; x < width; x += 8) {
+                for (int32_t i = 0; i < 4; i++, texels += 8) {
+                    decode_cmpr_block(texels, x + (i & 1) * 4, y + (i >> 1) * 4, width, height, dst);
+                }
+            }
+        }
+        return;
+    }
+
+    int32_t tile_width = 4, tile_height = 4, bits = 16;
+    if (format == GX_TF_I4) tile_width = 8, tile_height = 8, bits = 4;
+    if (format == GX_TF_I8 || format == GX_TF_IA4) tile_width = 8, bits = 8;
+    int32_t tiles_width = (width + tile_width - 1) / tile_width;
+    for (int32_t y = 0; y < height; y++) {
+        for (int32_t x = 0; x < width; x++) {
+            int32_t tile = (y / tile_height) * tiles_width + x / tile_width;
+            int32_t texel = (y % tile_height) * tile_width + x % tile_width;
+            uint8_t *pixel = &dst[(y * width + x) * 4];
+            if (format == GX_TF_RGBA8) {
+                // 32 bytes of AR pairs, then 32 bytes of GB pairs
+                const uint8_t *ar = &texels[tile * 64 + texel * 2], *gb = ar + 32;
+                pixel[0] = ar[1], pixel[1] = gb[0], pixel[2] = gb[1], pixel[3] = ar[0];
+                continue;
+            }
+
+            const uint8_t *bytes = &texels[tile * 32 + texel * bits / 8];
+            uint32_t value = bits == 4 ? (bytes[0] >> (texel & 1 ? 0 : 4)) & 0xf
+                             : bits == 8 ? bytes[0]
+                                         : (uint32_t)(bytes[0] << 8) | bytes[1];
+            switch (format) {
+                case GX_TF_I4:
+                    pixel[0] = pixel[1] = pixel[2] = expand(value, 4), pixel[3] = 0xff;
+                    break;
+                case GX_TF_I8:
+                    pixel[0] = pixel[1] = pixel[2] = value, pixel[3] = 0xff;
+                    break;
+                case GX_TF_IA4:
+                    pixel[0] = pixel[1] = pixel[2] = expand(value & 0xf, 4), pixel[3] = expand(value >> 4, 4);
+                    break;
+                case GX_TF_IA8:
+                    pixel[0] = pixel[1] = pixel[2] = value & 0xff, pixel[3] = value >> 8;
+                    break;
+                case GX_TF_RGB565:
+                    decode_rgb565(value, pixel);
+                    break;
+                case GX_TF_RGB5A3:
+                    if (value & 0x8000) {
+                        pixel[0] = expand((value >> 10) & 0x1f, 5);
+                        pixel[1] = expand((value >> 5) & 0x1f, 5);
+                        pixel[2] = expand(value & 0x1f, 5);
+                        pixel[3] = 0xff;
+                    } else {
+                        pixel[0] = expand((value >> 8) & 0xf, 4);
+                        pixel[1] = expand((value >> 4) & 0xf, 4);
+                        pixel[2] = expand(value & 0xf, 4);
+                        pixel[3] = expand(value >> 12, 3);
+                    }
+                    break;
+            }
+        }
+    }
+}
+
+// Encodes and decodes a copy of src, returns the largest error of channel or of any channel when channel is -1
+static int32_t round_trip_error(const uint8_t *src, int32_t width, int32_t height, uint8_t format, int32_t channel) {
+    uint8_t *pixels = malloc(width * height * 4);
+    uint8_t *decoded = malloc(width * height * 4);
+    memcpy(pixels, src, width * height * 4);
+    uint8_t *texels = texture_convert(pixels, width, height, format);
+    decode(texels, width, height, format, decoded);
+    int32_t error = 0;
+    for (int32_t i = 0; i < width * height * 4; i++) {
+        if (channel >= 0 && (i & 3) != channel) continue;
+        int32_t delta = abs(decoded[i] - src[i]);
+        if (delta > error) error = delta;
+    }
+    free(pixels);
+    free(decoded);
+    free(texels);
+    return error;
+}
+
+typedef enum TestImage {
+    TEST_IMAGE_GRAY,
+    TEST_IMAGE_GRAY_ALPHA,
+    TEST_IMAGE_COLOR,
+    TEST_IMAGE_COLOR_ALPHA,
+    TEST_IMAGE_GRADIENT,
+} TestImage;
+
+static uint8_t *make_image(TestImage image, int32_t width, int32_t height) {
+    uint8_t *pixels = malloc(width * height * 4);
+    for (int32_t y = 0; y < height; y++) {
+        for (int32_t x = 0; x < width; x++) {
+            uint8_t *pixel = &pixels[(y * width + x) * 4];
+            for (int32_t c = 0; c < 4; c++) pixel[c] = random_byte();
+            if (image == TEST_IMAGE_GRAY || image == TEST_IMAGE_GRAY_ALPHA) pixel[1] = pixel[2] = pixel[0];
+            if (image == TEST_IMAGE_GRAY || image == TEST_IMAGE_COLOR) pixel[3] = 0xff;
+            if (image == TEST_IMAGE_GRADIENT) {
+                // Colors along one line through RGB, which the two endpoints of every CMPR block can follow
+                int32_t t = (x + y) * 255 / (width + height - 2);
+                pixel[0] = t;
+                pixel[1] = 40 + t * 3 / 4;
+                pixel[2] = 200 - t * 3 / 5;
+                pixel[3] = 0xff;
+            }
+        }
+    }
+    return pixels;
+}
+
+typedef struct RoundTripCase {
+    const char *name;
+    uint8_t format;
+    TestImage image;
+    // Half a step of the fewest bits a channel keeps, rounded up
+    int32_t max_error;
+} RoundTripCase;
+
+static const RoundTripCase round_trip_cases[] = {
+    {"I4", GX_TF_I4, TEST_IMAGE_GRAY, 8},
+    {"I8", GX_TF_I8, TEST_IMAGE_GRAY, 0},
+    {"IA4", GX_TF_IA4, TEST_IMAGE_GRAY_ALPHA, 8},
+    {"IA8", GX_TF_IA8, TEST_IMAGE_GRAY_ALPHA, 0},
+    {"RGB565", GX_TF_RGB565, TEST_IMAGE_COLOR, 4},
+    {"RGB5A3 opaque", GX_TF_RGB5A3, TEST_IMAGE_COLOR, 4},
+    {"RGBA8", GX_TF_RGBA8, TEST_IMAGE_COLOR_ALPHA, 0},
+    {"CMPR", GX_TF_CMPR, TEST_IMAGE_GRADIENT, 8},
+};
+
+static void test_round_trips(void) {
+    for (size_t i = 0; i < sizeof(round_trip_cases) / sizeof(RoundTripCase); i++) {
+        const RoundTripCase *c = &round_trip_cases[i];
+        uint8_t *src = make_image(c->image, TEST_WIDTH, TEST_HEIGHT);
+        int32_t error = round_trip_error(src, TEST_WIDTH, TEST_HEIGHT, c->format, -1);
+        char what[64];
+        snprintf(what, sizeof(what), "largest channel error %d, expected at most %d", (int)error, (int)c->max_error);
+        check(error <= c->max_error, c->name, what);
+        free(src);
+    }
+}
+
+static void test_rgb5a3_alpha(void) {
+    // Every alpha next to every color channel value, translucent texels keep 4 bits of color and 3 of alpha and
+    // the opaque cut sits halfway between 219 and 255
+    uint8_t *src = make_image(TEST_IMAGE_COLOR_ALPHA, 256, 16);
+    for (int32_t i = 0; i < 256 * 16; i++) src[i * 4 + 3] = i & 0xff;
+    int32_t alpha_error = round_trip_error(src, 256, 16, GX_TF_RGB5A3, 3);
+    int32_t color_error = 0;
+    for (int32_t c = 0; c < 3; c++) {
+        int32_t error = round_trip_error(src, 256, 16, GX_TF_RGB5A3, c);
+        if (error > color_error) color_error = error;
+    }
+    check(alpha_error <= 18, "RGB5A3 alpha", "alpha error above 18");
+    check(color_error <= 8, "RGB5A3 alpha", "translucent color error above 8");
+
+    TextureAnalysis analysis;
+    texture_analyze(src, 256, 16, &analysis);
+    check(analysis.errors[GX_TF_RGB5A3] <= 18, "RGB5A3 alpha", "texture_analyze error above 18");
+    free(src);
+}
+
+static void test_padding(void) {
+    // Texels past the image edge are zero, whatever format they are in
+    static const uint8_t formats[] = {GX_TF_I4, GX_TF_I8, GX_TF_IA4, GX_TF_IA8, GX_TF_RGB565, GX_TF_RGB5A3};
+    uint8_t src[4] = {0xff, 0xff, 0xff, 0xff};
+    for (size_t i = 0; i < sizeof(formats); i++) {
+        uint8_t *texels = texture_convert(src, 1, 1, formats[i]);
+        int32_t size = GX_GetTexBufferSize(1, 1, formats[i], GX_FALSE, 0), padding_size = 0;
+        int32_t texel_size = formats[i] >= GX_TF_IA8 ? 2 : 1;
+        for (int32_t j = texel_size; j < size; j++) padding_size += texels[j] != 0;
+
+        // I4 keeps the texel in the high nibble of the first byte
+        if (formats[i] == GX_TF_I4) padding_size += texels[0] & 0xf;
+        char name[32];
+        snprintf(name, sizeof(name), "padding of format %d", (int)formats[i]);
+        check(padding_size == 0, name, "texels past the edge are not zero");
+        free(texels);
+    }
+}
+
+// The byte-wise swizzle texture_convert_rgba8 replaced, with texels past the edge as transparent black
+static uint8_t *reference_convert_rgba8(const uint8_t *src, int32_t width, int32_t height) {
+    uint8_t *dst = malloc(GX_GetTexBufferSize(width, height, GX_TF_RGBA8, GX_FALSE, 0));
+    int32_t position = 0;
+    for (int32_t y = 0; y < height; y += 4) {
+        for (int32_t x = 0; x < width; x += 4) {
+            for (int32_t ry = 0; ry < 4; ry++) {
+                for (int32_t rx = 0; rx < 4; rx++) {
+                    int32_t offset = ((y + ry) * width + (x + rx)) * 4;
+                    bool inside = x + rx < width && y + ry < height;
+                    dst[position++] = inside ? src[offset + 3] : 0;  // alpha
+                    dst[position++] = inside ? src[offset] : 0;      // red
+                }
+            }
+            for (int32_t ry = 0; ry < 4; ry++) {
+                for (int32_t rx = 0; rx < 4; rx++) {
+                    int32_t offset = ((y + ry) * width + (x + rx)) * 4;
+                    bool inside = x + rx < width && y + ry < height;
+                    dst[position++] = inside ? src[offset + 1] : 0;  // green
+                    dst[position++] = inside ? src[offset + 2] : 0;  // blue
+                }
+            }
+        }
+    }
+    return dst;
+}
+
+static void test_rgba8_swizzle(void) {
+    // Whole tiles and partial ones on either edge, every size is allocated exactly so overreads show up under
+    // sanitizers
+    static const int32_t sizes[][2] = {{480, 480}, {96, 96}, {1, 1}, {5, 3}, {7, 9}, {13, 4}, {4, 13}, {33, 17}};
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        int32_t width = sizes[i][0], height = sizes[i][1];
+        uint8_t *src = make_image(TEST_IMAGE_COLOR_ALPHA, width, height);
+        uint8_t *texels = texture_convert_rgba8(src, width, height);
+        uint8_t *expected = reference_convert_rgba8(src, width, height);
+        char name[32];
+        snprintf(name, sizeof(name), "RGBA8 %dx%d", (int)width, (int)height);
+        check(memcmp(texels, expected, GX_GetTexBufferSize(width, height, GX_TF_RGBA8, GX_FALSE, 0)) == 0, name,
+              "differs from the byte-wise swizzle");
+        free(src);
+        free(texels);
+        free(expected);
+    }
+}
+
+typedef struct DitherCase {
+    const char *name;
+    uint8_t format;
+    uint8_t color[4];
+    // Channels the format keeps, intensity formats compare the red channel
+    int32_t channels;
+} DitherCase;
+
+// Colors between the levels of every format, so rounding alone would move the average
+static const DitherCase dither_cases[] = {
+    {"I4", GX_TF_I4, {108, 108, 108, 0xff}, 1},
+    {"IA4", GX_TF_IA4, {108, 108, 108, 60}, 4},
+    {"RGB565", GX_TF_RGB565, {103, 152, 60, 0xff}, 3},
+    {"RGB5A3 opaque", GX_TF_RGB5A3, {103, 152, 60, 0xff}, 3},
+    {"RGB5A3 translucent", GX_TF_RGB5A3, {108, 152, 60, 80}, 4},
+};
+
+static void test_dither_average(void) {
+    static const char *dither_names[] = {"none", "ordered", "diffusion"};
+    int32_t size = 64;
+    uint8_t *src = malloc(size * size * 4);
+    uint8_t *decoded = malloc(size * size * 4);
+    for (size_t i = 0; i < sizeof(dither_cases) / sizeof(DitherCase); i++) {
+        const DitherCase *c = &dither_cases[i];
+        for (TextureDither dither = TEXTURE_DITHER_ORDERED; dither <= TEXTURE_DITHER_DIFFUSION; dither++) {
+            for (int32_t j = 0; j < size * size; j++) memcpy(&src[j * 4], c->color, 4);
+            texture_dither(src, size, size, c->format, dither);
+            uint8_t *texels = texture_convert(src, size, size, c->format);
+            decode(texels, size, size, c->format, decoded);
+            for (int32_t channel = 0; channel < c->channels; channel++) {
+                double sum = 0;
+                for (int32_t j = 0; j < size * size; j++) sum += decoded[j * 4 + channel];
+                double mean = sum / (size * size);
+                char name[64], what[64];
+                snprintf(name, sizeof(name), "%s dithered %s", c->name, dither_names[dither]);
+                snprintf(what, sizeof(what), "channel %d averages %.2f instead of %d", (int)channel, mean,
+                         (int)c->color[channel]);
+                check(fabs(mean - c->color[channel]) <= 1.0, name, what);
+            }
+            free(texels);
+        }
+    }
+    free(src);
+    free(decoded);
+}
+
+static void test_pick_cursors(void) {
+    // More colors than CI8 holds, which quantize well above TEXTURE_AUTO_MIN_PSNR
+    static const char *paths[] = {"data/cursor1.png", "data/cursor2.png", "data/cursor3.png", "data/cursor4.png"};
+    for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        int32_t width, height, channels;
+        uint8_t *src = stbi_load(paths[i], &width, &height, &channels, 4);
+        check(src != NULL, paths[i], "can't be loaded");
+        if (src == NULL) continue;
+        TextureAnalysis analysis;
+        texture_analyze(src, width, height, &analysis);
+        uint8_t format = texture_pick_format(src, width, height, &analysis, TEXTURE_AUTO_MAX_ERROR,
+                                             TEXTURE_AUTO_MIN_PSNR, true);
+        check(format == GX_TF_CI8, paths[i], "doesn't pick CI8 with a palette");
+        format = texture_pick_format(src, width, height, &analysis, TEXTURE_AUTO_MAX_ERROR, TEXTURE_AUTO_MIN_PSNR,
+                                     false);
+        check(format != GX_TF_CI4 && format != GX_TF_CI8, paths[i], "picks a palette format without one");
+        stbi_image_free(src);
+    }
+}
+
+static void test_palette_lost(void) {
+    // A palette left from a CI load must not survive a load that picks another format
+    FILE *file = fopen("data/cursor1.png", "rb");
+    check(file != NULL, "data/cursor1.png", "can't be opened");
+    if (file == NULL) return;
+    fseek(file, 0, SEEK_END);
+    size_t size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    uint8_t *data = malloc(size);
+    check(fread(data, 1, size, file) == size, "data/cursor1.png", "can't be read");
+    fclose(file);
+
+    GXTexObj texture;
+    TexturePalette palette, zero;
+    memset(&zero, 0, sizeof(TexturePalette));
+    check(texture_load_png_palette(&texture, &palette, GX_TLUT0, NULL, data, size, GX_TF_CI8), "palette CI8",
+          "doesn't load");
+    check(palette.entries != NULL && palette.colors_size > 0, "palette CI8", "has no entries");
+    free(palette.entries);
+    free(texture.image);
+    check(texture_load_png_palette(&texture, &palette, GX_TLUT0, NULL, data, size, GX_TF_RGBA8), "palette RGBA8",
+          "doesn't load");
+    check(memcmp(&palette, &zero, sizeof(TexturePalette)) == 0, "palette RGBA8", "isn't zeroed");
+    uint8_t colors[TEXTURE_PALETTE_MAX_COLORS * 4] = {0};
+    texture_palette_set(&palette, colors);
+    free(texture.image);
+    free(data);
+}
+
+static void benchmark_rgba8(int32_t width, int32_t height, int32_t rounds) {
+    uint8_t *src = make_image(TEST_IMAGE_COLOR_ALPHA, width, height);
+    clock_t start = clock();
+    for (int32_t round = 0; round < rounds; round++) {
+        uint8_t *texels = texture_convert_rgba8(src, width, height);
+        benchmark_sink = texels[round & 63];
+        free(texels);
+    }
+    double swizzle = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (int32_t round = 0; round < rounds; round++) {
+        uint8_t *texels = reference_convert_rgba8(src, width, height);
+        benchmark_sink = texels[round & 63];
+        free(texels);
+    }
+    double reference = (double)(clock() - start) / CLOCKS_PER_SEC;
+    double bytes = (double)width * height * 4 * rounds;
+    printf("texture_test: RGBA8 %dx%d swizzle %.0f MB/s, byte-wise %.0f MB/s\n", (int)width, (int)height,
+           bytes / swizzle / 1e6, bytes / reference / 1e6);
+    free(src);
+}
+
+int main(void) {
+    test_round_trips();
+    test_rgb5a3_alpha();
+    test_padding();
+    test_rgba8_swizzle();
+    test_dither_average();
+    test_pick_cursors();
+    test_palette_lost();
+    if (test_report() != 0) return 1;
+    benchmark_rgba8(480, 480, 200);
+    benchmark_rgba8(96, 96, 5000);
+    return 0;
+}
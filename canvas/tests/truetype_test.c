@@ -0,0 +1,230 @@
+// Host tests of the TrueType reader: glyph indices, advances, kerning, boxes and outlines of known Lato glyphs, then
+// truncated and corrupted copies of data/lato.ttf. Every table offset, loca entry, contour and point count comes from
+// the file, so no damage may make a lookup or the rasterizer read or write outside the font and its buffers. The
+// Makefile builds this test with TEST_SANITIZE to catch reads that don't crash.
+
+#define TEST_NAME "truetype_test"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "truetype.h"
+#include "test.h"
+
+#define TRUETYPE_TEST_CORRUPTIONS 4000
+
+static uint8_t raster[TRUETYPE_MAX_RASTER * TRUETYPE_MAX_RASTER];
+
+// Glyphs of data/lato.ttf as its cmap, hmtx and glyf tables store them, in font units of a 2000 unit em, with the
+// outline area integrated exactly over the quadratic segments. 0 area marks a composite glyph.
+typedef struct KnownGlyph {
+    uint32_t code_point;
+    uint16_t glyph;
+    int32_t advance;
+    int16_t x_min;
+    int16_t y_min;
+    int16_t x_max;
+    int16_t y_max;
+    double area;
+} KnownGlyph;
+
+static const KnownGlyph known_glyphs[] = {
+    {'.', 17, 424, 88, -15, 337, 236, 49384.0},
+    {'%', 8, 1572, 72, -17, 1499, 1447, 688305.1},
+    {'@', 35, 1644, 86, -239, 1564, 1359, 809766.8},
+    {'A', 36, 1360, 10, 0, 1353, 1433, 605084.2},
+    {'I', 44, 614, 210, 0, 404, 1433, 278002.0},
+    {'V', 57, 1360, 8, 0, 1351, 1433, 536619.2},
+    {'W', 58, 2038, 14, 0, 2023, 1433, 981269.0},
+    {'a', 68, 1014, 92, -16, 890, 1031, 415133.2},
+    {'e', 72, 1048, 74, -14, 967, 1029, 422316.1},
+    {'g', 74, 1022, 50, -365, 990, 1030, 592203.8},
+    {'l', 79, 512, 166, 0, 344, 1473, 262194.0},
+    {'o', 82, 1112, 72, -14, 1038, 1029, 439315.3},
+    {0xe9, 171, 1048, 74, -14, 967, 1449, 0},
+    {0x20ac, 245, 1160, 34, -15, 1138, 1447, 568010.2},
+};
+
+// Total coverage of a rasterized glyph in pixels
+static double rasterize_area(TrueType *font, uint16_t glyph, float scale, TrueTypeBox *box) {
+    memset(raster, 0, sizeof(raster));
+    truetype_rasterize(font, glyph, scale, box, raster, TRUETYPE_MAX_RASTER);
+    double area = 0;
+    for (int32_t y = 0; y < box->y1 - box->y0; y++) {
+        for (int32_t x = 0; x < box->x1 - box->x0; x++) area += raster[y * TRUETYPE_MAX_RASTER + x] / 255.0;
+    }
+    return area;
+}
+
+// Looks up, measures and rasterizes a mix of code points and raw glyph indices, returns the coverage drawn
+static uint32_t exercise(TrueType *font) {
+    static const uint32_t code_points[] = {'A', 'V', 'a', 'g', 'W', '%', '&', '@', 0xe9, 0x20ac, 0xfffd, 0x1f600,
+                                           0x10ffff};
+    uint32_t coverage = 0;
+    uint16_t previous = 0;
+    for (uint32_t i = 0; i < sizeof(code_points) / sizeof(code_points[0]) + 8; i++) {
+        uint16_t glyph = i < sizeof(code_points) / sizeof(code_points[0])
+                             ? truetype_find_glyph(font, code_points[i])
+                             : font->num_glyphs - 4 + i % 8;
+        truetype_get_advance(font, glyph);
+        truetype_get_kerning(font, previous, glyph);
+        previous = glyph;
+        TrueTypeBox box;
+        if (!truetype_get_box(font, glyph, 48.0f / 2048, &box)) continue;
+        truetype_rasterize(font, glyph, 48.0f / 2048, &box, raster, TRUETYPE_MAX_RASTER);
+        int32_t width = box.x1 - box.x0 < TRUETYPE_MAX_RASTER ? box.x1 - box.x0 : TRUETYPE_MAX_RASTER;
+        int32_t height = box.y1 - box.y0 < TRUETYPE_MAX_RASTER ? box.y1 - box.y0 : TRUETYPE_MAX_RASTER;
+        for (int32_t y = 0; y < height; y++) {
+            for (int32_t x = 0; x < width; x++) coverage += raster[y * TRUETYPE_MAX_RASTER + x];
+        }
+    }
+    return coverage;
+}
+
+// Copies the font into an allocation of exactly size bytes, so reads past the end show up under sanitizers
+static uint32_t exercise_copy(const uint8_t *data, uint32_t size, bool *loaded) {
+    uint8_t *copy = malloc(size > 0 ? size : 1);
+    memcpy(copy, data, size);
+    TrueType font;
+    uint32_t coverage = 0;
+    *loaded = truetype_init(&font, copy, size);
+    if (*loaded) coverage = exercise(&font);
+    free(copy);
+    return coverage;
+}
+
+static void test_intact(const uint8_t *data, uint32_t size) {
+    TrueType font;
+    check(truetype_init(&font, data, size), "intact", "doesn't load");
+    check(font.cmap_format == 4 || font.cmap_format == 12, "intact", "has no usable cmap");
+    check(truetype_find_glyph(&font, 'A') != 0, "intact", "has no glyph for A");
+    check(truetype_get_kerning(&font, truetype_find_glyph(&font, 'A'), truetype_find_glyph(&font, 'V')) < 0,
+          "intact", "doesn't kern AV");
+    check(exercise(&font) > 0, "intact", "draws nothing");
+}
+
+static void test_known(const uint8_t *data, uint32_t size) {
+    TrueType font;
+    truetype_init(&font, data, size);
+    check(font.units_per_em == 2000 && font.num_glyphs == 277, "lato", "header differs from data/lato.ttf");
+
+    // Lookups and metrics match the tables, the box is the glyf box scaled and rounded outwards with y down
+    float scale = 100.0f / 2000;
+    double e_area = 0;
+    for (size_t i = 0; i < sizeof(known_glyphs) / sizeof(known_glyphs[0]); i++) {
+        const KnownGlyph *known = &known_glyphs[i];
+        char name[32];
+        snprintf(name, sizeof(name), "U+%04X", known->code_point);
+        uint16_t glyph = truetype_find_glyph(&font, known->code_point);
+        check(glyph == known->glyph, name, "maps to another glyph");
+        check(truetype_get_advance(&font, glyph) == known->advance, name, "advance differs from hmtx");
+        TrueTypeBox box;
+        check(truetype_get_box(&font, glyph, scale, &box), name, "has no box");
+        check(box.x0 == (int32_t)floorf(known->x_min * scale) && box.y0 == (int32_t)floorf(-known->y_max * scale) &&
+                  box.x1 == (int32_t)ceilf(known->x_max * scale) && box.y1 == (int32_t)ceilf(-known->y_min * scale),
+              name, "box differs from glyf");
+
+        // Coverage adds up to the outline area within a percent, composite glyphs cover more than their base
+        double area = rasterize_area(&font, glyph, scale, &box);
+        if (known->code_point == 'e') e_area = area;
+        if (known->area > 0) {
+            double expected = known->area * scale * scale;
+            char what[96];
+            snprintf(what, sizeof(what), "covers %.1f pixels instead of %.1f", area, expected);
+            check(fabs(area - expected) <= expected * 0.01, name, what);
+        } else {
+            check(area > e_area * 1.05, name, "covers no more than its base glyph");
+        }
+    }
+
+    // Kerning pairs from the kern table, and a pair that has none
+    static const struct {
+        char left;
+        char right;
+        int32_t kerning;
+    } pairs[] = {{'A', 'V', -136}, {'V', 'A', -136}, {'T', 'o', -210}, {'W', 'a', -88}, {'A', 'A', 0}};
+    for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++) {
+        int32_t kerning = truetype_get_kerning(&font, truetype_find_glyph(&font, pairs[i].left),
+                                               truetype_find_glyph(&font, pairs[i].right));
+        check(kerning == pairs[i].kerning, "kerning", "differs from the kern table");
+    }
+
+    // I is a rectangle from x 10.5 to 20.2 and y -71.65 to 0, o has a hole in the middle
+    TrueTypeBox box;
+    uint16_t glyph = truetype_find_glyph(&font, 'I');
+    truetype_get_box(&font, glyph, scale, &box);
+    rasterize_area(&font, glyph, scale, &box);
+    const uint8_t *row = &raster[(box.y1 - box.y0) / 2 * TRUETYPE_MAX_RASTER];
+    uint32_t wrong = 0;
+    for (int32_t x = 0; x < box.x1 - box.x0; x++) {
+        int32_t pixel_x = box.x0 + x;
+        uint8_t expected = pixel_x >= 11 && pixel_x < 20 ? 255 : pixel_x < 10 || pixel_x > 20 ? 0 : row[x];
+        wrong += abs(row[x] - expected) > 1;
+    }
+    check(wrong == 0, "U+0049", "middle row isn't solid between the stems edges");
+    check(abs(row[10 - box.x0] - 128) <= 2 && abs(row[20 - box.x0] - 51) <= 2, "U+0049",
+          "edge pixels aren't covered by the part of the stem inside them");
+    glyph = truetype_find_glyph(&font, 'o');
+    truetype_get_box(&font, glyph, scale, &box);
+    rasterize_area(&font, glyph, scale, &box);
+    int32_t center_x = (int32_t)(555 * scale) - box.x0, center_y = (int32_t)(-507 * scale) - box.y0;
+    check(raster[center_y * TRUETYPE_MAX_RASTER + center_x] == 0, "U+006F", "fills its counter");
+    check(raster[center_y * TRUETYPE_MAX_RASTER + 1] == 255, "U+006F", "doesn't fill its left bowl");
+}
+
+static void test_truncated(const uint8_t *data, uint32_t size) {
+    // Every length through the table directory and the start of the tables, then a spread through the rest
+    uint32_t loaded_size = 0;
+    for (uint32_t length = 0; length < size; length += length < 1024 ? 1 : 1 + random_below(size / 256)) {
+        bool loaded;
+        exercise_copy(data, length, &loaded);
+        loaded_size += loaded;
+    }
+    printf("truetype_test: %u truncated fonts still loaded\n", loaded_size);
+}
+
+static void test_corrupted(const uint8_t *data, uint32_t size) {
+    // Random bytes overwritten in the table directory and inside random tables, where offsets and counts live
+    uint8_t *copy = malloc(size);
+    uint16_t num_tables = (data[4] << 8) | data[5];
+    uint32_t loaded_size = 0;
+    for (uint32_t i = 0; i < TRUETYPE_TEST_CORRUPTIONS; i++) {
+        memcpy(copy, data, size);
+        uint32_t changes = 1 + random_below(8);
+        for (uint32_t j = 0; j < changes; j++) {
+            const uint8_t *record = &data[12 + random_below(num_tables) * 16];
+            uint32_t table = ((uint32_t)record[8] << 24) | (record[9] << 16) | (record[10] << 8) | record[11];
+            uint32_t length = ((uint32_t)record[12] << 24) | (record[13] << 16) | (record[14] << 8) | record[15];
+            // Table headers take most of the damage, glyph outlines are anywhere in their table
+            uint32_t span = random_below(2) == 0 && length > 256 ? 256 : length > 0 ? length : 1;
+            uint32_t position = random_below(3) == 0 ? random_below(12 + num_tables * 16) : table + random_below(span);
+            copy[position < size ? position : size - 1] = random_below(256);
+        }
+        bool loaded;
+        exercise_copy(copy, size, &loaded);
+        loaded_size += loaded;
+    }
+    printf("truetype_test: %u of %u corrupted fonts still loaded\n", loaded_size, TRUETYPE_TEST_CORRUPTIONS);
+    free(copy);
+}
+
+int main(void) {
+    FILE *file = fopen("data/lato.ttf", "rb");
+    check(file != NULL, "data/lato.ttf", "can't be opened");
+    if (file == NULL) return 1;
+    fseek(file, 0, SEEK_END);
+    uint32_t size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    uint8_t *data = malloc(size);
+    check(fread(data, 1, size, file) == size, "data/lato.ttf", "can't be read");
+    fclose(file);
+
+    test_intact(data, size);
+    test_known(data, size);
+    test_truncated(data, size);
+    test_corrupted(data, size);
+    free(data);
+    return test_report();
+}
@@ -0,0 +1,233 @@
+// Host tests of the UTF-8 decoder: valid sequences of every length, overlong forms, surrogates, code points above
+// U+10FFFF, truncated sequences and the ASCII fast path at every alignment, followed by a throughput benchmark against
+// the decoder the canvas used before
+
+#define TEST_NAME "utf8_test"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "utf8.h"
+#include "test.h"
+
+#define R UTF8_REPLACEMENT_CHARACTER
+
+typedef struct Utf8Case {
+    const char *name;
+    const char *bytes;
+    size_t size;
+    uint32_t code_points[8];
+    size_t code_points_size;
+} Utf8Case;
+
+// Bad lead bytes are consumed alone and a bad continuation byte starts the next sequence, so every byte of a
+// malformed sequence that can't start one becomes its own U+FFFD
+static const Utf8Case cases[] = {
+    {"ascii", "abc", 3, {'a', 'b', 'c'}, 3},
+    {"two bytes", "\xc3\xa9", 2, {0xe9}, 1},
+    {"three bytes", "\xe2\x82\xac", 3, {0x20ac}, 1},
+    {"four bytes", "\xf0\x9f\x8f\xa0", 4, {0x1f3e0}, 1},
+    {"smallest of each length", "\x00\xc2\x80\xe0\xa0\x80\xf0\x90\x80\x80", 10, {0, 0x80, 0x800, 0x10000}, 4},
+    {"largest of each length", "\x7f\xdf\xbf\xef\xbf\xbf\xf4\x8f\xbf\xbf", 10, {0x7f, 0x7ff, 0xffff, 0x10ffff}, 4},
+    {"overlong two bytes", "\xc0\x80", 2, {R, R}, 2},
+    {"overlong two bytes c1", "\xc1\xbf", 2, {R, R}, 2},
+    {"overlong three bytes", "\xe0\x80\x80", 3, {R, R, R}, 3},
+    {"overlong three bytes high", "\xe0\x9f\xbf", 3, {R, R, R}, 3},
+    {"overlong four bytes", "\xf0\x80\x80\x80", 4, {R, R, R, R}, 4},
+    {"overlong four bytes high", "\xf0\x8f\xbf\xbf", 4, {R, R, R, R}, 4},
+    {"first surrogate", "\xed\xa0\x80", 3, {R, R, R}, 3},
+    {"last surrogate", "\xed\xbf\xbf", 3, {R, R, R}, 3},
+    {"before surrogates", "\xed\x9f\xbf", 3, {0xd7ff}, 1},
+    {"after surrogates", "\xee\x80\x80", 3, {0xe000}, 1},
+    {"above U+10FFFF", "\xf4\x90\x80\x80", 4, {R, R, R, R}, 4},
+    {"lead f5", "\xf5\x80\x80\x80", 4, {R, R, R, R}, 4},
+    {"lead f8", "\xf8\x88\x80\x80\x80", 5, {R, R, R, R, R}, 5},
+    {"lead ff", "\xff", 1, {R}, 1},
+    {"lone continuation", "a\x80z", 3, {'a', R, 'z'}, 3},
+    {"truncated two bytes", "\xc3", 1, {R}, 1},
+    {"truncated three bytes", "\xe2\x82", 2, {R}, 1},
+    {"truncated four bytes", "\xf0\x9f\x8f", 3, {R}, 1},
+    {"interrupted by ascii", "\xe2\x82" "A", 3, {R, 'A'}, 2},
+    {"interrupted by a lead", "\xf0\x9f\xc3\xa9", 4, {R, 0xe9}, 2},
+    {"nul inside", "a\0b", 3, {'a', 0, 'b'}, 3},
+};
+
+static void check_decode(const char *name, const char *bytes, size_t size, const uint32_t *expected,
+                         size_t expected_size) {
+    // Copy into an allocation of exactly size bytes, so reads past the end show up under sanitizers
+    char *buffer = malloc(size > 0 ? size : 1);
+    memcpy(buffer, bytes, size);
+    uint32_t *code_points = malloc((size + 1) * sizeof(uint32_t));
+
+    size_t code_points_size = utf8_decode_to_codepoints(buffer, size, code_points);
+    check(code_points_size == expected_size &&
+              memcmp(code_points, expected, expected_size * sizeof(uint32_t)) == 0,
+          name, "utf8_decode_to_codepoints");
+
+    size_t index = 0;
+    code_points_size = 0;
+    while (index < size && code_points_size <= size) {
+        size_t before = index;
+        code_points[code_points_size++] = utf8_decode_next(buffer, size, &index);
+        if (index <= before || index > size) break;
+    }
+    check(index == size && code_points_size == expected_size &&
+              memcmp(code_points, expected, expected_size * sizeof(uint32_t)) == 0,
+          name, "utf8_decode_next");
+    free(buffer);
+    free(code_points);
+}
+
+static void test_cases(void) {
+    for (size_t i = 0; i < sizeof(cases) / sizeof(Utf8Case); i++) {
+        const Utf8Case *c = &cases[i];
+        check_decode(c->name, c->bytes, c->size, c->code_points, c->code_points_size);
+    }
+}
+
+static void test_ascii_alignment(void) {
+    // A two byte sequence at every position of ASCII runs that start at every alignment, so the four byte fast
+    // path sees it in every lane and the tail handling sees every remainder
+    char storage[64];
+    char bytes[32];
+    uint32_t expected[32];
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t length = 0; length <= 20; length++) {
+            for (size_t position = 0; position <= length; position++) {
+                size_t size = 0, expected_size = 0;
+                for (size_t i = 0; i < length; i++) {
+                    if (i == position) {
+                        bytes[size++] = '\xc3';
+                        bytes[size++] = '\xa9';
+                        expected[expected_size++] = 0xe9;
+                    }
+                    bytes[size++] = 'a' + i;
+                    expected[expected_size++] = 'a' + i;
+                }
+                memset(storage, 0xff, sizeof(storage));
+                memcpy(storage + offset, bytes, size);
+
+                uint32_t code_points[32];
+                size_t code_points_size = utf8_decode_to_codepoints(storage + offset, size, code_points);
+                char name[64];
+                snprintf(name, sizeof(name), "alignment %zu length %zu position %zu", offset, length, position);
+                check(code_points_size == expected_size &&
+                          memcmp(code_points, expected, expected_size * sizeof(uint32_t)) == 0,
+                      name, "utf8_decode_to_codepoints");
+            }
+        }
+    }
+}
+
+// The decoder canvas_fill_text used before utf8.c, kept as the benchmark baseline. It stops at the first NUL or
+// malformed sequence and reads past the end of truncated ones.
+__attribute__((noinline)) static uint32_t reference_get_next_code_point(const char *str, int *index) {
+    uint32_t code_point = 0;
+    unsigned char current_byte;
+
+    // Read the first byte
+    current_byte = str[(*index)++];
+
+    // Determine the number of bytes in the UTF-8 sequence based on the first byte
+    int num_bytes = 0;
+    if (current_byte < 0x80) {
+        num_bytes = 1;
+        code_point = current_byte;
+    } else if ((current_byte & 0xE0) == 0xC0) {
+        num_bytes = 2;
+        code_point = current_byte & 0x1F;
+    } else if ((current_byte & 0xF0) == 0xE0) {
+        num_bytes = 3;
+        code_point = current_byte & 0x0F;
+    } else if ((current_byte & 0xF8) == 0xF0) {
+        num_bytes = 4;
+        code_point = current_byte & 0x07;
+    } else {
+        // Invalid UTF-8 sequence
+        return 0;
+    }
+
+    // Read the remaining bytes
+    for (int i = 1; i < num_bytes; ++i) {
+        current_byte = str[(*index)++];
+        if ((current_byte & 0xC0) != 0x80) {
+            // Invalid UTF-8 sequence
+            return 0;
+        }
+        code_point = (code_point << 6) | (current_byte & 0x3F);
+    }
+
+    return code_point;
+}
+
+// Mostly ASCII text with some two, three and four byte sequences, like the canvas strings, NUL terminated
+static char *benchmark_text(size_t size, size_t *used) {
+    static const char *words[] = {"framebuffer=640x480 ", "grüße ", "½ æøå ", "🏠 ", "The quick brown fox "};
+    char *buffer = malloc(size + 1);
+    *used = 0;
+    for (uint32_t i = 0;; i++) {
+        const char *word = words[i % 5];
+        size_t length = strlen(word);
+        if (*used + length > size) break;
+        memcpy(buffer + *used, word, length);
+        *used += length;
+    }
+    buffer[*used] = '\0';
+    return buffer;
+}
+
+static void test_reference(void) {
+    // Both decoders agree on valid text, so the benchmark compares the same work
+    size_t used;
+    char *buffer = benchmark_text(4096, &used);
+    uint32_t *code_points = malloc(used * sizeof(uint32_t));
+    size_t code_points_size = utf8_decode_to_codepoints(buffer, used, code_points);
+    int index = 0;
+    size_t mismatches = 0, i = 0;
+    for (uint32_t code_point; (code_point = reference_get_next_code_point(buffer, &index)) != 0; i++) {
+        mismatches += i >= code_points_size || code_points[i] != code_point;
+    }
+    check(mismatches == 0 && i == code_points_size, "reference", "decodes the benchmark text differently");
+    free(buffer);
+    free(code_points);
+}
+
+static void benchmark(void) {
+    size_t used;
+    char *buffer = benchmark_text(1 << 20, &used);
+    uint32_t *code_points = malloc(used * sizeof(uint32_t));
+
+    int32_t rounds = 50;
+    clock_t start = clock();
+    size_t total = 0;
+    for (int32_t round = 0; round < rounds; round++) total += utf8_decode_to_codepoints(buffer, used, code_points);
+    double bulk = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (int32_t round = 0; round < rounds; round++) {
+        size_t index = 0;
+        while (index < used) total += utf8_decode_next(buffer, used, &index) != 0;
+    }
+    double next = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (int32_t round = 0; round < rounds; round++) {
+        int index = 0;
+        while (reference_get_next_code_point(buffer, &index) != 0) total++;
+    }
+    double reference = (double)(clock() - start) / CLOCKS_PER_SEC;
+    benchmark_sink = total;
+    printf("utf8_test: bulk %.0f MB/s, one code point at a time %.0f MB/s, get_next_code_point %.0f MB/s\n",
+           used * rounds / bulk / 1e6, used * rounds / next / 1e6, used * rounds / reference / 1e6);
+    free(buffer);
+    free(code_points);
+}
+
+int main(void) {
+    test_cases();
+    test_ascii_alignment();
+    test_reference();
+    if (test_report() != 0) return 1;
+    benchmark();
+    return 0;
+}
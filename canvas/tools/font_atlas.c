@@ -0,0 +1,694 @@
+// Host tool that bakes the characters of a charset and a string table into font.png, src/font.c,
+// include/font_atlas.h and the glyph index encoded strings in src/font_strings.c and include/font_strings.h
+//
+// cc -O2 -pthread -Iinclude -DTRUETYPE_THREAD_LOCAL=_Thread_local tools/font_atlas.c src/truetype.c src/utf8.c
+//     src/stb_image.c -o font_atlas -lm
+// ./font_atlas data/lato.ttf fonts/charset.txt fonts/strings.txt src/font.c include/font_atlas.h data/font.png
+//     src/font_strings.c include/font_strings.h
+//
+// Charset lines are either text, every character of it is rasterized from the TrueType font, or
+// "U+XXXX image.png ascent" for a colored glyph from an image relative to the charset, or "U+XXXX" for a
+// glyph without pixels. U+XXXX lines only declare a glyph, it is baked when a string uses it.
+// String lines are "ID text", every character of a string is baked. Lines starting with # are comments.
+// The line is FONT_RENDER_SIZE pixels from the font ascent to its descent, glyphs are packed with maxrects
+// into the smallest power of two atlas. Outputs are only written when they changed, so make rebuilds
+// nothing after a no-op run.
+
+#include <math.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "font.h"
+#include "stb_image.h"
+#include "truetype.h"
+#include "utf8.h"
+
+#define CHARS_MAX 255
+#define STRINGS_MAX 256
+#define STRING_ID_MAX 64
+#define THREADS_MAX 16
+#define ATLAS_SIZE_MIN 64
+#define ATLAS_SIZE_MAX 1024
+
+typedef struct Char {
+    uint32_t code_point;
+    uint16_t glyph;
+    char *image_path;
+    int32_t ascent;
+    int32_t bearing;
+    int32_t advance;
+    int32_t x;
+    int32_t y;
+    int32_t width;
+    int32_t height;
+    uint8_t *pixels;
+} Char;
+
+typedef struct String {
+    char id[STRING_ID_MAX];
+    uint32_t *code_points;
+    uint32_t code_points_size;
+} String;
+
+typedef struct Rect {
+    int32_t x;
+    int32_t y;
+    int32_t width;
+    int32_t height;
+} Rect;
+
+typedef struct Buffer {
+    uint8_t *data;
+    size_t size;
+    size_t capacity;
+} Buffer;
+
+static TrueType font_file;
+static float scale;
+static int32_t baseline;
+static Char chars[CHARS_MAX];
+static uint32_t chars_size;
+static Char declared[CHARS_MAX];
+static uint32_t declared_size;
+static String strings[STRINGS_MAX];
+static uint32_t strings_size;
+static atomic_uint next_char;
+
+// Buffers
+
+static void buffer_append(Buffer *buffer, const void *data, size_t size) {
+    if (buffer->size + size > buffer->capacity) {
+        buffer->capacity = (buffer->size + size) * 2;
+        buffer->data = realloc(buffer->data, buffer->capacity);
+    }
+    memcpy(&buffer->data[buffer->size], data, size);
+    buffer->size += size;
+}
+
+static void buffer_printf(Buffer *buffer, const char *format, ...) {
+    char line[512];
+    va_list args;
+    va_start(args, format);
+    int32_t size = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    buffer_append(buffer, line, size);
+}
+
+static void buffer_u32(Buffer *buffer, uint32_t value) {
+    uint8_t bytes[4] = {value >> 24, value >> 16, value >> 8, value};
+    buffer_append(buffer, bytes, 4);
+}
+
+static bool write_if_changed(const char *path, Buffer *buffer) {
+    FILE *file = fopen(path, "rb");
+    if (file != NULL) {
+        uint8_t *old = malloc(buffer->size + 1);
+        size_t old_size = fread(old, 1, buffer->size + 1, file);
+        fclose(file);
+        bool same = old_size == buffer->size && memcmp(old, buffer->data, buffer->size) == 0;
+        free(old);
+        if (same) return true;
+    }
+    file = fopen(path, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Can't write %s\n", path);
+        return false;
+    }
+    fwrite(buffer->data, 1, buffer->size, file);
+    fclose(file);
+    printf("%s\n", path);
+    return true;
+}
+
+// PNG writer with a fixed Huffman deflate, the atlas is mostly empty so plain LZ77 is enough
+
+typedef struct BitWriter {
+    Buffer *buffer;
+    uint32_t bits;
+    uint32_t bits_size;
+} BitWriter;
+
+static void write_bits(BitWriter *writer, uint32_t value, uint32_t size) {
+    writer->bits |= value << writer->bits_size;
+    writer->bits_size += size;
+    while (writer->bits_size >= 8) {
+        uint8_t byte = writer->bits;
+        buffer_append(writer->buffer, &byte, 1);
+        writer->bits >>= 8;
+        writer->bits_size -= 8;
+    }
+}
+
+static void write_code(BitWriter *writer, uint32_t code, uint32_t size) {
+    // Huffman codes are stored most significant bit first
+    uint32_t reversed = 0;
+    for (uint32_t i = 0; i < size; i++) reversed |= ((code >> i) & 1) << (size - 1 - i);
+    write_bits(writer, reversed, size);
+}
+
+static void write_symbol(BitWriter *writer, uint32_t symbol) {
+    if (symbol < 144) {
+        write_code(writer, 0x30 + symbol, 8);
+    } else if (symbol < 256) {
+        write_code(writer, 0x190 + symbol - 144, 9);
+    } else if (symbol < 280) {
+        write_code(writer, symbol - 256, 7);
+    } else {
+        write_code(writer, 0xc0 + symbol - 280, 8);
+    }
+}
+
+static const uint16_t length_base[29] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                         31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t length_extra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                         2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t distance_base[30] = {1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,   97,   129,
+                                           193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+static const uint8_t distance_extra[30] = {0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+                                           6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+static void deflate(Buffer *buffer, const uint8_t *data, size_t size) {
+    // Greedy matches from hash chains over the last 32KB
+    enum { WINDOW = 32768, HASH_SIZE = 1 << 15, CHAIN_MAX = 64 };
+    int32_t *head = malloc(HASH_SIZE * sizeof(int32_t));
+    int32_t *previous = malloc(size * sizeof(int32_t));
+    memset(head, 0xff, HASH_SIZE * sizeof(int32_t));
+    BitWriter writer = {buffer, 0, 0};
+    write_bits(&writer, 1, 1);
+    write_bits(&writer, 1, 2);
+    size_t i = 0;
+    while (i < size) {
+        uint32_t best_length = 0, best_distance = 0;
+        if (i + 3 <= size) {
+            uint32_t hash = ((data[i] << 16 | data[i + 1] << 8 | data[i + 2]) * 2654435761u) >> 17;
+            int32_t candidate = head[hash];
+            for (uint32_t chain = 0; chain < CHAIN_MAX && candidate >= 0 && i - candidate <= WINDOW; chain++) {
+                uint32_t length = 0;
+                while (length < 258 && i + length < size && data[candidate + length] == data[i + length]) length++;
+                if (length > best_length) {
+                    best_length = length;
+                    best_distance = i - candidate;
+                    if (length == 258) break;
+                }
+                candidate = previous[candidate];
+            }
+        }
+        if (best_length < 3) best_length = 1;
+
+        // Insert every covered position into the hash chains
+        for (uint32_t j = 0; j < best_length; j++, i++) {
+            if (i + 3 > size) continue;
+            uint32_t hash = ((data[i] << 16 | data[i + 1] << 8 | data[i + 2]) * 2654435761u) >> 17;
+            previous[i] = head[hash];
+            head[hash] = i;
+        }
+        if (best_length == 1) {
+            write_symbol(&writer, data[i - 1]);
+            continue;
+        }
+        uint32_t code = 28;
+        while (length_base[code] > best_length) code--;
+        write_symbol(&writer, 257 + code);
+        write_bits(&writer, best_length - length_base[code], length_extra[code]);
+        code = 29;
+        while (distance_base[code] > best_distance) code--;
+        write_code(&writer, code, 5);
+        write_bits(&writer, best_distance - distance_base[code], distance_extra[code]);
+    }
+    write_symbol(&writer, 256);
+    write_bits(&writer, 0, 7);
+    free(head);
+    free(previous);
+}
+
+static uint32_t crc32(const uint8_t *data, size_t size, uint32_t crc) {
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc ^= data[i];
+        for (uint32_t k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xedb88320 & -(crc & 1));
+    }
+    return ~crc;
+}
+
+static void png_chunk(Buffer *png, const char *type, Buffer *data) {
+    buffer_u32(png, data->size);
+    size_t start = png->size;
+    buffer_append(png, type, 4);
+    buffer_append(png, data->data, data->size);
+    buffer_u32(png, crc32(&png->data[start], png->size - start, 0));
+}
+
+static void png_encode(Buffer *png, const uint8_t *rgba, uint32_t width, uint32_t height) {
+    buffer_append(png, "\x89PNG\r\n\x1a\n", 8);
+    Buffer header = {0};
+    buffer_u32(&header, width);
+    buffer_u32(&header, height);
+    buffer_append(&header, "\x08\x06\x00\x00\x00", 5);
+    png_chunk(png, "IHDR", &header);
+
+    // Rows without filtering, wrapped in a zlib stream
+    Buffer raw = {0};
+    for (uint32_t y = 0; y < height; y++) {
+        buffer_append(&raw, "\x00", 1);
+        buffer_append(&raw, &rgba[y * width * 4], width * 4);
+    }
+    uint32_t a = 1, b = 0;
+    for (size_t i = 0; i < raw.size; i++) {
+        a = (a + raw.data[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    Buffer compressed = {0};
+    buffer_append(&compressed, "\x78\x01", 2);
+    deflate(&compressed, raw.data, raw.size);
+    buffer_u32(&compressed, (b << 16) | a);
+    png_chunk(png, "IDAT", &compressed);
+    Buffer end = {0};
+    png_chunk(png, "IEND", &end);
+    free(header.data);
+    free(raw.data);
+    free(compressed.data);
+}
+
+// Charset
+
+static int32_t find_char(uint32_t code_point) {
+    for (uint32_t i = 0; i < chars_size; i++) {
+        if (chars[i].code_point == code_point) return i;
+    }
+    return -1;
+}
+
+static void add_char(uint32_t code_point) {
+    if (find_char(code_point) != -1) return;
+    if (chars_size == CHARS_MAX) {
+        fprintf(stderr, "More than %d characters\n", CHARS_MAX);
+        exit(1);
+    }
+
+    // Declared characters bring their image, all others come from the TrueType font
+    Char *font_char = &chars[chars_size++];
+    memset(font_char, 0, sizeof(Char));
+    font_char->code_point = code_point;
+    for (uint32_t i = 0; i < declared_size; i++) {
+        if (declared[i].code_point == code_point) *font_char = declared[i];
+    }
+}
+
+static FILE *open_lines(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "Can't read %s\n", path);
+        exit(1);
+    }
+    return file;
+}
+
+static bool read_line(FILE *file, char *line, size_t size, size_t *length) {
+    while (fgets(line, size, file) != NULL) {
+        *length = strcspn(line, "\r\n");
+        line[*length] = '\0';
+        if (*length != 0 && line[0] != '#') return true;
+    }
+    return false;
+}
+
+static void read_charset(const char *path) {
+    FILE *file = open_lines(path);
+    const char *slash = strrchr(path, '/');
+    int32_t directory_size = slash != NULL ? slash - path + 1 : 0;
+
+    // Space is always needed for its advance
+    add_char(' ');
+    char line[1024];
+    size_t length;
+    while (read_line(file, line, sizeof(line), &length)) {
+        uint32_t code_point;
+        char image[512];
+        int32_t ascent;
+        int32_t fields = sscanf(line, "U+%x %511s %d", &code_point, image, &ascent);
+        if (fields >= 1) {
+            if (declared_size == CHARS_MAX) continue;
+            Char *font_char = &declared[declared_size++];
+            memset(font_char, 0, sizeof(Char));
+            font_char->code_point = code_point;
+            if (fields == 1) continue;
+            font_char->image_path = malloc(directory_size + strlen(image) + 1);
+            sprintf(font_char->image_path, "%.*s%s", directory_size, path, image);
+            font_char->ascent = fields == 3 ? ascent : 0;
+            continue;
+        }
+        size_t index = 0;
+        while (index < length) add_char(utf8_decode_next(line, length, &index));
+    }
+    fclose(file);
+}
+
+static void read_strings(const char *path) {
+    FILE *file = open_lines(path);
+    char line[1024];
+    size_t length;
+    while (read_line(file, line, sizeof(line), &length)) {
+        if (strings_size == STRINGS_MAX) {
+            fprintf(stderr, "More than %d strings\n", STRINGS_MAX);
+            exit(1);
+        }
+        String *string = &strings[strings_size++];
+        size_t id_size = strcspn(line, " ");
+        if (id_size == 0 || id_size >= STRING_ID_MAX) {
+            fprintf(stderr, "Bad string id in %s: %s\n", path, line);
+            exit(1);
+        }
+        memcpy(string->id, line, id_size);
+        string->id[id_size] = '\0';
+
+        // Decode the text once here, so the game never has to
+        size_t index = id_size < length ? id_size + 1 : length;
+        string->code_points = malloc(length * sizeof(uint32_t));
+        string->code_points_size = 0;
+        while (index < length) {
+            uint32_t code_point = utf8_decode_next(line, length, &index);
+            string->code_points[string->code_points_size++] = code_point;
+            add_char(code_point);
+        }
+    }
+    fclose(file);
+}
+
+// Rasterizing runs on all cores, every character is independent
+
+static void load_char(Char *font_char) {
+    if (font_char->image_path != NULL) {
+        int32_t channels;
+        font_char->pixels = stbi_load(font_char->image_path, &font_char->width, &font_char->height, &channels, 4);
+        if (font_char->pixels == NULL) {
+            fprintf(stderr, "Can't load %s\n", font_char->image_path);
+            exit(1);
+        }
+        font_char->advance = font_char->width + 2;
+        return;
+    }
+    font_char->glyph = truetype_find_glyph(&font_file, font_char->code_point);
+    if (font_char->glyph == 0) {
+        // Code points without a glyph keep their entry with no pixels, like U+FE0F
+        if (font_char->code_point != 0xfe0f) {
+            fprintf(stderr, "warning: no glyph for U+%04X\n", font_char->code_point);
+        }
+        return;
+    }
+    font_char->advance = (int32_t)lroundf(truetype_get_advance(&font_file, font_char->glyph) * scale);
+    TrueTypeBox box;
+    if (!truetype_get_box(&font_file, font_char->glyph, scale, &box)) return;
+    font_char->width = box.x1 - box.x0;
+    font_char->height = box.y1 - box.y0;
+    font_char->bearing = box.x0;
+    font_char->ascent = baseline + box.y0;
+
+    // Coverage becomes the alpha of white pixels
+    uint8_t *coverage = malloc(font_char->width * font_char->height);
+    truetype_rasterize(&font_file, font_char->glyph, scale, &box, coverage, font_char->width);
+    font_char->pixels = malloc(font_char->width * font_char->height * 4);
+    for (int32_t i = 0; i < font_char->width * font_char->height; i++) {
+        memset(&font_char->pixels[i * 4], 0xff, 3);
+        font_char->pixels[i * 4 + 3] = coverage[i];
+    }
+    free(coverage);
+}
+
+static void *load_chars(void *argument) {
+    for (;;) {
+        uint32_t i = atomic_fetch_add(&next_char, 1);
+        if (i >= chars_size) return NULL;
+        load_char(&chars[i]);
+    }
+}
+
+// Maxrects packing with best short side fit, each rect keeps a one pixel gap to the right and bottom
+
+static Rect *free_rects;
+static uint32_t free_rects_size;
+
+static void add_free_rect(Rect rect) {
+    if (rect.width <= 0 || rect.height <= 0) return;
+    free_rects = realloc(free_rects, (free_rects_size + 1) * sizeof(Rect));
+    free_rects[free_rects_size++] = rect;
+}
+
+static bool rect_contains(Rect *outer, Rect *inner) {
+    return inner->x >= outer->x && inner->y >= outer->y && inner->x + inner->width <= outer->x + outer->width &&
+           inner->y + inner->height <= outer->y + outer->height;
+}
+
+static bool maxrects_insert(int32_t width, int32_t height, int32_t *x, int32_t *y) {
+    int32_t best = -1, best_short = INT32_MAX, best_long = INT32_MAX;
+    for (uint32_t i = 0; i < free_rects_size; i++) {
+        Rect *rect = &free_rects[i];
+        if (rect->width < width || rect->height < height) continue;
+        int32_t left_x = rect->width - width, left_y = rect->height - height;
+        int32_t short_side = left_x < left_y ? left_x : left_y;
+        int32_t long_side = left_x < left_y ? left_y : left_x;
+        if (short_side < best_short || (short_side == best_short && long_side < best_long)) {
+            best = i;
+            best_short = short_side;
+            best_long = long_side;
+        }
+    }
+    if (best == -1) return false;
+    Rect used = {free_rects[best].x, free_rects[best].y, width, height};
+    *x = used.x;
+    *y = used.y;
+
+    // Split every free rect the new one overlaps into up to four maximal rects
+    Rect *rects = free_rects;
+    uint32_t rects_size = free_rects_size;
+    free_rects = NULL;
+    free_rects_size = 0;
+    for (uint32_t i = 0; i < rects_size; i++) {
+        Rect rect = rects[i];
+        if (used.x >= rect.x + rect.width || used.x + used.width <= rect.x || used.y >= rect.y + rect.height ||
+            used.y + used.height <= rect.y) {
+            add_free_rect(rect);
+            continue;
+        }
+        add_free_rect((Rect){rect.x, rect.y, used.x - rect.x, rect.height});
+        add_free_rect((Rect){used.x + used.width, rect.y, rect.x + rect.width - used.x - used.width, rect.height});
+        add_free_rect((Rect){rect.x, rect.y, rect.width, used.y - rect.y});
+        add_free_rect((Rect){rect.x, used.y + used.height, rect.width, rect.y + rect.height - used.y - used.height});
+    }
+    free(rects);
+
+    // Drop free rects inside other ones
+    for (uint32_t i = 0; i < free_rects_size; i++) {
+        for (uint32_t j = 0; j < free_rects_size; j++) {
+            if (i == j || !rect_contains(&free_rects[j], &free_rects[i])) continue;
+            free_rects[i--] = free_rects[--free_rects_size];
+            break;
+        }
+    }
+    return true;
+}
+
+static bool pack(int32_t width, int32_t height, uint32_t *order) {
+    free_rects_size = 0;
+    add_free_rect((Rect){0, 0, width, height});
+    for (uint32_t j = 0; j < chars_size; j++) {
+        Char *font_char = &chars[order[j]];
+        if (font_char->pixels == NULL) continue;
+        if (!maxrects_insert(font_char->width + 1, font_char->height + 1, &font_char->x, &font_char->y)) return false;
+    }
+    return true;
+}
+
+static int32_t kerning_pixels(Char *left, Char *right) {
+    if (left->glyph == 0 || right->glyph == 0) return 0;
+    return (int32_t)lroundf(truetype_get_kerning(&font_file, left->glyph, right->glyph) * scale);
+}
+
+int main(int argc, char **argv) {
+    if (argc != 9) {
+        fprintf(stderr,
+                "Usage: %s font.ttf charset.txt strings.txt font.c font_atlas.h font.png font_strings.c "
+                "font_strings.h\n",
+                argv[0]);
+        return 1;
+    }
+    FILE *file = fopen(argv[1], "rb");
+    if (file == NULL) {
+        fprintf(stderr, "Can't read %s\n", argv[1]);
+        return 1;
+    }
+    fseek(file, 0, SEEK_END);
+    long file_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    uint8_t *file_data = malloc(file_size);
+    if (fread(file_data, 1, file_size, file) != (size_t)file_size || !truetype_init(&font_file, file_data, file_size)) {
+        fprintf(stderr, "Can't load %s\n", argv[1]);
+        return 1;
+    }
+    fclose(file);
+    scale = (float)FONT_RENDER_SIZE / (font_file.ascent - font_file.descent);
+    baseline = (int32_t)lroundf(font_file.ascent * scale);
+    read_charset(argv[2]);
+    read_strings(argv[3]);
+
+    // Glyph indices in the strings are positions in font[], which font_table_init keeps as long as every
+    // character fits into its page table
+    uint8_t pages[0x20000 >> FONT_PAGE_BITS] = {0};
+    uint32_t pages_size = 0;
+    for (uint32_t i = 0; i < chars_size; i++) {
+        if (chars[i].code_point >= 0x20000) {
+            fprintf(stderr, "U+%04X is outside of planes 0 and 1\n", chars[i].code_point);
+            return 1;
+        }
+        if (pages[chars[i].code_point >> FONT_PAGE_BITS]++ == 0) pages_size++;
+    }
+    if (pages_size > FONT_PAGES_MAX) {
+        fprintf(stderr, "Characters span %u pages of 256 code points, the font table has %d\n", pages_size,
+                FONT_PAGES_MAX);
+        return 1;
+    }
+
+    long threads_size = sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads_size < 1) threads_size = 1;
+    if (threads_size > THREADS_MAX) threads_size = THREADS_MAX;
+    pthread_t threads[THREADS_MAX];
+    for (long i = 0; i < threads_size; i++) pthread_create(&threads[i], NULL, load_chars, NULL);
+    for (long i = 0; i < threads_size; i++) pthread_join(threads[i], NULL);
+
+    // Pack tallest first into the smallest power of two atlas, wide before tall at the same area
+    uint32_t order[CHARS_MAX];
+    int64_t area = 0;
+    for (uint32_t i = 0; i < chars_size; i++) {
+        uint32_t j = i;
+        while (j > 0 && chars[order[j - 1]].height < chars[i].height) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+        if (chars[i].pixels != NULL) area += (chars[i].width + 1) * (chars[i].height + 1);
+    }
+    int32_t width = 0, height = 0;
+    for (int32_t size = ATLAS_SIZE_MIN * ATLAS_SIZE_MIN; width == 0 && size <= ATLAS_SIZE_MAX * ATLAS_SIZE_MAX;
+         size *= 2) {
+        if (size < area) continue;
+        for (int32_t w = ATLAS_SIZE_MAX; w >= ATLAS_SIZE_MIN; w /= 2) {
+            int32_t h = size / w;
+            if (h < w / 2 || h > ATLAS_SIZE_MAX || h < ATLAS_SIZE_MIN || h > w) continue;
+            if (pack(w, h, order)) {
+                width = w;
+                height = h;
+                break;
+            }
+        }
+    }
+    if (width == 0) {
+        fprintf(stderr, "Glyphs don't fit into a %dx%d atlas\n", ATLAS_SIZE_MAX, ATLAS_SIZE_MAX);
+        return 1;
+    }
+
+    // Atlas image
+    uint8_t *atlas = calloc(width * height, 4);
+    for (uint32_t i = 0; i < chars_size; i++) {
+        Char *font_char = &chars[i];
+        for (int32_t y = 0; y < font_char->height && font_char->pixels != NULL; y++) {
+            memcpy(&atlas[((font_char->y + y) * width + font_char->x) * 4],
+                   &font_char->pixels[y * font_char->width * 4], font_char->width * 4);
+        }
+    }
+    Buffer png = {0};
+    png_encode(&png, atlas, width, height);
+
+    // Kerning pairs between all TrueType glyphs, rounded to whole pixels
+    Buffer kernings = {0};
+    uint32_t kernings_size = 0;
+    for (uint32_t i = 0; i < chars_size; i++) {
+        for (uint32_t j = 0; j < chars_size; j++) {
+            int32_t kerning = kerning_pixels(&chars[i], &chars[j]);
+            if (kerning == 0) continue;
+            buffer_printf(&kernings, "%s    { .l = 0x%x, .r = 0x%x, .k = %d }", kernings_size > 0 ? ",\n" : "",
+                          chars[i].code_point, chars[j].code_point, kerning);
+            kernings_size++;
+        }
+    }
+
+    // Metrics table, one character per line
+    Buffer source = {0};
+    buffer_printf(&source, "// Generated by tools/font_atlas.c from %s, %s and %s, do not edit\n\n", argv[1], argv[2],
+                  argv[3]);
+    buffer_printf(&source, "#include \"font.h\"\n\nFontChar font[FONT_CHARS_SIZE] = {\n");
+    for (uint32_t i = 0; i < chars_size; i++) {
+        Char *c = &chars[i];
+        buffer_printf(&source,
+                      "    { .n = 0x%x, .x = %d, .y = %d, .w = %d, .h = %d, .a = %d, .b = %d, .d = %d, .c = %s }%s\n",
+                      c->code_point, c->pixels ? c->x : 0, c->pixels ? c->y : 0, c->width, c->height, c->ascent,
+                      c->bearing, c->advance, c->image_path != NULL ? "true" : "false",
+                      i + 1 < chars_size ? "," : "");
+    }
+    buffer_printf(&source, "};\n\nFontKerning font_kernings[FONT_KERNINGS_SIZE] = {\n");
+    if (kernings.size > 0) buffer_append(&source, kernings.data, kernings.size);
+    buffer_printf(&source, "\n};\n");
+
+    Buffer header = {0};
+    buffer_printf(&header, "#pragma once\n\n// Generated by tools/font_atlas.c, do not edit\n\n");
+    buffer_printf(&header, "#define FONT_ATLAS_WIDTH %d\n#define FONT_ATLAS_HEIGHT %d\n", width, height);
+    buffer_printf(&header, "#define FONT_BASELINE %d\n", baseline);
+    buffer_printf(&header, "#define FONT_CHARS_SIZE %u\n#define FONT_KERNINGS_SIZE %u\n", chars_size, kernings_size);
+
+    // Strings as glyph indices at their final positions, including kerning and bearing, glyphs without pixels
+    // only move the pen and colored glyphs go last so each page is one run
+    Buffer strings_source = {0};
+    Buffer strings_header = {0};
+    buffer_printf(&strings_source, "// Generated by tools/font_atlas.c from %s, do not edit\n\n", argv[3]);
+    buffer_printf(&strings_source, "#include \"font_strings.h\"\n");
+    buffer_printf(&strings_header, "#pragma once\n\n// Generated by tools/font_atlas.c from %s, do not edit\n\n",
+                  argv[3]);
+    buffer_printf(&strings_header, "#include \"font.h\"\n\ntypedef enum FontStringId {\n");
+    uint32_t advances[STRINGS_MAX];
+    for (uint32_t s = 0; s < strings_size; s++) {
+        String *string = &strings[s];
+        buffer_printf(&strings_source, "\nstatic const FontStringGlyph font_string_%u[] = {\n", s);
+        int32_t pen = 0, previous = -1;
+        uint32_t glyphs_size = 0;
+        for (uint32_t colored = 0; colored < 2; colored++) {
+            pen = 0;
+            previous = -1;
+            for (uint32_t i = 0; i < string->code_points_size; i++) {
+                int32_t index = find_char(string->code_points[i]);
+                Char *font_char = &chars[index];
+                if (previous != -1) pen += kerning_pixels(&chars[previous], font_char);
+                previous = index;
+                if (font_char->pixels != NULL && (font_char->image_path != NULL) == colored) {
+                    buffer_printf(&strings_source, "    { .glyph = %d, .x = %d },\n", index, pen + font_char->bearing);
+                    glyphs_size++;
+                }
+                pen += font_char->advance;
+            }
+        }
+        if (glyphs_size == 0) buffer_printf(&strings_source, "    { 0 },\n");
+        buffer_printf(&strings_source, "};\n");
+        advances[s] = pen;
+        buffer_printf(&strings_header, "    FONT_STRING_%s,\n", string->id);
+        string->code_points_size = glyphs_size;
+    }
+    buffer_printf(&strings_header, "    FONT_STRINGS_SIZE\n} FontStringId;\n\n");
+    buffer_printf(&strings_header, "extern const FontString font_strings[FONT_STRINGS_SIZE];\n");
+    buffer_printf(&strings_source, "\nconst FontString font_strings[FONT_STRINGS_SIZE] = {\n");
+    for (uint32_t s = 0; s < strings_size; s++) {
+        buffer_printf(&strings_source, "    [FONT_STRING_%s] = { font_string_%u, %u, %u },\n", strings[s].id, s,
+                      strings[s].code_points_size, advances[s]);
+    }
+    buffer_printf(&strings_source, "};\n");
+
+    if (!write_if_changed(argv[4], &source) || !write_if_changed(argv[5], &header) ||
+        !write_if_changed(argv[6], &png) || !write_if_changed(argv[7], &strings_source) ||
+        !write_if_changed(argv[8], &strings_header)) {
+        return 1;
+    }
+    printf("%s: %dx%d atlas with %u characters, %u kerning pairs and %u strings\n", argv[6], width, height,
+           chars_size, kernings_size, strings_size);
+    return 0;
+}
@@ -0,0 +1,150 @@
+// Host tool that turns the monochrome glyphs of font.png into a single channel distance field atlas
+//
+// cc -O2 -Iinclude tools/font_sdf.c src/font.c src/stb_image.c -o font_sdf -lm
+// ./font_sdf data/font.png data/font_sdf.bin
+//
+// Output is big endian: "FSDF", u16 width, u16 height, u16 glyphs_size, u8 scale, u8 spread,
+// then per glyph u32 code point, u16 x, u16 y of its field box and the GX_TF_I8 tiled pixels
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "font.h"
+#include "stb_image.h"
+
+#define ATLAS_WIDTH 256
+
+static uint8_t *pixels;
+static int32_t pixels_width;
+static int32_t pixels_height;
+
+static bool inside(const FontChar *font_char, int32_t x, int32_t y) {
+    if (x < 0 || y < 0 || x >= font_char->w || y >= font_char->h) return false;
+    return pixels[((font_char->y + y) * pixels_width + font_char->x + x) * 4 + 3] >= 128;
+}
+
+static uint8_t distance_value(const FontChar *font_char, float x, float y) {
+    // Nearest source pixel of the other side, searched within the spread
+    int32_t radius = FONT_SDF_SPREAD * FONT_SDF_SCALE + 1;
+    int32_t cx = (int32_t)floorf(x), cy = (int32_t)floorf(y);
+    bool center_inside = inside(font_char, cx, cy);
+    float nearest = radius;
+    for (int32_t sy = cy - radius; sy <= cy + radius; sy++) {
+        for (int32_t sx = cx - radius; sx <= cx + radius; sx++) {
+            if (inside(font_char, sx, sy) == center_inside) continue;
+            float dx = sx + 0.5f - x, dy = sy + 0.5f - y;
+            float distance = sqrtf(dx * dx + dy * dy) - 0.5f;
+            if (distance < nearest) nearest = distance;
+        }
+    }
+    float signed_distance = center_inside ? nearest : -nearest;
+    float value = 0.5f + signed_distance / (2.0f * FONT_SDF_SPREAD * FONT_SDF_SCALE);
+    if (value < 0) value = 0;
+    if (value > 1) value = 1;
+    return (uint8_t)(value * 255 + 0.5f);
+}
+
+static void write_u16(FILE *file, uint16_t value) {
+    fputc(value >> 8, file);
+    fputc(value & 0xff, file);
+}
+
+static void write_u32(FILE *file, uint32_t value) {
+    write_u16(file, value >> 16);
+    write_u16(file, value & 0xffff);
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s font.png font_sdf.bin\n", argv[0]);
+        return 1;
+    }
+    int32_t channels;
+    pixels = stbi_load(argv[1], &pixels_width, &pixels_height, &channels, 4);
+    if (pixels == NULL) {
+        fprintf(stderr, "Can't load %s\n", argv[1]);
+        return 1;
+    }
+
+    // Shelf pack the field boxes of all monochrome glyphs, tallest first
+    uint32_t font_size = sizeof(font) / sizeof(FontChar);
+    uint16_t box_x[font_size], box_y[font_size], box_width[font_size], box_height[font_size];
+    uint32_t order[font_size];
+    uint32_t glyphs_size = 0;
+    for (uint32_t i = 0; i < font_size; i++) {
+        FontChar *font_char = &font[i];
+        if (font_char->c || font_char->w == 0 || font_char->h == 0) continue;
+        box_width[i] = (font_char->w + FONT_SDF_SCALE - 1) / FONT_SDF_SCALE + 2 * FONT_SDF_SPREAD;
+        box_height[i] = (font_char->h + FONT_SDF_SCALE - 1) / FONT_SDF_SCALE + 2 * FONT_SDF_SPREAD;
+        uint32_t j = glyphs_size++;
+        while (j > 0 && box_height[order[j - 1]] < box_height[i]) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+    uint32_t shelf_x = 0, shelf_y = 0, shelf_height = 0;
+    for (uint32_t j = 0; j < glyphs_size; j++) {
+        uint32_t i = order[j];
+        if (shelf_x + box_width[i] > ATLAS_WIDTH) {
+            shelf_x = 0;
+            shelf_y += shelf_height;
+            shelf_height = 0;
+        }
+        box_x[i] = shelf_x;
+        box_y[i] = shelf_y;
+        shelf_x += box_width[i];
+        if (box_height[i] > shelf_height) shelf_height = box_height[i];
+    }
+    uint32_t height = (shelf_y + shelf_height + 3) & ~3;
+
+    // Sample the field at the texel centers of every box, outside of all boxes is far outside
+    uint8_t *atlas = calloc(ATLAS_WIDTH * height, 1);
+    for (uint32_t i = 0; i < font_size; i++) {
+        FontChar *font_char = &font[i];
+        if (font_char->c || font_char->w == 0 || font_char->h == 0) continue;
+        for (uint32_t y = 0; y < box_height[i]; y++) {
+            for (uint32_t x = 0; x < box_width[i]; x++) {
+                float source_x = ((float)x - FONT_SDF_SPREAD + 0.5f) * FONT_SDF_SCALE;
+                float source_y = ((float)y - FONT_SDF_SPREAD + 0.5f) * FONT_SDF_SCALE;
+                atlas[(box_y[i] + y) * ATLAS_WIDTH + box_x[i] + x] = distance_value(font_char, source_x, source_y);
+            }
+        }
+    }
+
+    FILE *file = fopen(argv[2], "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Can't write %s\n", argv[2]);
+        return 1;
+    }
+    fwrite("FSDF", 1, 4, file);
+    write_u16(file, ATLAS_WIDTH);
+    write_u16(file, height);
+    write_u16(file, glyphs_size);
+    fputc(FONT_SDF_SCALE, file);
+    fputc(FONT_SDF_SPREAD, file);
+    for (uint32_t i = 0; i < font_size; i++) {
+        FontChar *font_char = &font[i];
+        if (font_char->c || font_char->w == 0 || font_char->h == 0) continue;
+        write_u32(file, font_char->n);
+        write_u16(file, box_x[i]);
+        write_u16(file, box_y[i]);
+    }
+
+    // GX_TF_I8 stores 8x4 texel tiles
+    for (uint32_t y = 0; y < height; y += 4) {
+        for (uint32_t x = 0; x < ATLAS_WIDTH; x += 8) {
+            for (uint32_t ry = 0; ry < 4; ry++) {
+                fwrite(&atlas[(y + ry) * ATLAS_WIDTH + x], 1, 8, file);
+            }
+        }
+    }
+    fclose(file);
+
+    printf("%s: %ux%u I8 atlas with %u glyphs\n", argv[2], ATLAS_WIDTH, height, glyphs_size);
+    free(atlas);
+    stbi_image_free(pixels);
+    return 0;
+}
@@ -0,0 +1,104 @@
+// Host tool that compresses a PNG into a single GX_TF_CMPR texture TPL for TPL_OpenTPLFromMemory
+//
+// cc -O2 -Iinclude tools/png_cmpr.c src/cmpr.c src/stb_image.c -o png_cmpr -lm
+// ./png_cmpr [--fast] image.png image.tpl
+//
+// High quality mode is the default since build time is cheap, the PSNR of the color of opaque texels is
+// printed so modes and images can be compared
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cmpr.h"
+#include "stb_image.h"
+
+// TPL layout: header, one descriptor, the image header at 0x14 and the texels at the next 32 byte boundary
+#define TPL_MAGIC 0x0020af30
+#define TPL_IMAGE_HEADER_OFFSET 0x14
+#define TPL_DATA_OFFSET 0x40
+#define TPL_FORMAT_CMPR 14
+#define TPL_WRAP_CLAMP 0
+#define TPL_FILTER_LINEAR 1
+
+static void write_u16(FILE *file, uint16_t value) {
+    fputc(value >> 8, file);
+    fputc(value & 0xff, file);
+}
+
+static void write_u32(FILE *file, uint32_t value) {
+    write_u16(file, value >> 16);
+    write_u16(file, value & 0xffff);
+}
+
+static double psnr(const uint8_t *source, const uint8_t *decoded, int32_t width, int32_t height) {
+    double error = 0;
+    int64_t count = 0;
+    for (int32_t i = 0; i < width * height; i++) {
+        if (source[i * 4 + 3] < CMPR_ALPHA_THRESHOLD) continue;
+        for (int32_t c = 0; c < 3; c++) {
+            double delta = source[i * 4 + c] - decoded[i * 4 + c];
+            error += delta * delta;
+        }
+        count += 3;
+    }
+    if (count == 0 || error == 0) return INFINITY;
+    return 10 * log10(255.0 * 255.0 * count / error);
+}
+
+int main(int argc, char **argv) {
+    CmprQuality quality = CMPR_QUALITY_HIGH;
+    if (argc == 4 && strcmp(argv[1], "--fast") == 0) {
+        quality = CMPR_QUALITY_FAST;
+        argv++;
+        argc--;
+    }
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s [--fast] image.png image.tpl\n", argv[0]);
+        return 1;
+    }
+    int32_t width, height, channels;
+    uint8_t *pixels = stbi_load(argv[1], &width, &height, &channels, 4);
+    if (pixels == NULL) {
+        fprintf(stderr, "Can't load %s\n", argv[1]);
+        return 1;
+    }
+    if (width > 1024 || height > 1024) {
+        fprintf(stderr, "%s is larger than the 1024x1024 GX allows\n", argv[1]);
+        return 1;
+    }
+
+    uint32_t size = cmpr_size(width, height);
+    uint8_t *texels = malloc(size);
+    cmpr_encode(pixels, width, height, quality, texels);
+    uint8_t *decoded = malloc(width * height * 4);
+    cmpr_decode(texels, width, height, decoded);
+
+    FILE *file = fopen(argv[2], "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Can't write %s\n", argv[2]);
+        return 1;
+    }
+    write_u32(file, TPL_MAGIC);
+    write_u32(file, 1);
+    write_u32(file, 0xc);
+    write_u32(file, TPL_IMAGE_HEADER_OFFSET);
+    write_u32(file, 0);
+    write_u16(file, height);
+    write_u16(file, width);
+    write_u32(file, TPL_FORMAT_CMPR);
+    write_u32(file, TPL_DATA_OFFSET);
+    write_u32(file, TPL_WRAP_CLAMP);
+    write_u32(file, TPL_WRAP_CLAMP);
+    write_u32(file, TPL_FILTER_LINEAR);
+    write_u32(file, TPL_FILTER_LINEAR);
+    write_u32(file, 0);
+    write_u32(file, 0);
+    while (ftell(file) < TPL_DATA_OFFSET) fputc(0, file);
+    fwrite(texels, 1, size, file);
+    fclose(file);
+    printf("%s: %dx%d CMPR, %u bytes, %.2f dB\n", argv[2], width, height, size,
+           psnr(pixels, decoded, width, height));
+    return 0;
+}
@@ -92,6 +92,21 @@ int main(void) {
     guPerspective(perspective_matrix, 45, (float)screenmode->viWidth / (float)screenmode->viHeight, 0.1, 1000);
     GX_LoadProjectionMtx(perspective_matrix, GX_PERSPECTIVE);
 
+    // Enable depth test and disable culling, nothing else changes this state so it is set once
+    GX_SetZMode(GX_ENABLE, GX_LEQUAL, GX_TRUE);
+    GX_SetCullMode(GX_CULL_NONE);
+
+    // Setup triangle draw
+    GX_ClearVtxDesc();
+    GX_SetVtxDesc(GX_VA_POS, GX_DIRECT);
+    GX_SetVtxDesc(GX_VA_CLR0, GX_DIRECT);
+    GX_SetVtxAttrFmt(GX_VTXFMT0, GX_VA_POS, GX_POS_XY, GX_S8, 0);
+    GX_SetVtxAttrFmt(GX_VTXFMT0, GX_VA_CLR0, GX_CLR_RGBA, GX_RGBA8, 0);
+    GX_SetNumChans(1);
+    GX_SetNumTexGens(0);
+    GX_SetTevOrder(GX_TEVSTAGE0, GX_TEXCOORDNULL, GX_TEXMAP_NULL, GX_COLOR0A0);
+    GX_SetTevOp(GX_TEVSTAGE0, GX_PASSCLR);
+
     // Game state
     float triangle_rotation = 0;
 
@@ -104,31 +119,19 @@ int main(void) {
         WPAD_ScanPads();
         if (WPAD_ButtonsDown(0) & WPAD_BUTTON_HOME) running = false;
 
-        // Enable depth test and disable culling
-        GX_SetZMode(GX_ENABLE, GX_LEQUAL, GX_TRUE);
-        GX_SetCullMode(GX_CULL_NONE);
-
-        // Setup triangle draw
-        GX_ClearVtxDesc();
-        GX_SetVtxDesc(GX_VA_POS, GX_DIRECT);
-        GX_SetVtxDesc(GX_VA_CLR0, GX_DIRECT);
-        GX_SetVtxAttrFmt(GX_VTXFMT0, GX_VA_POS, GX_POS_XY, GX_S8, 0);
-        GX_SetVtxAttrFmt(GX_VTXFMT0, GX_VA_CLR0, GX_CLR_RGBA, GX_RGBA8, 0);
-        GX_SetNumChans(1);
-        GX_SetNumTexGens(0);
-        GX_SetTevOrder(GX_TEVSTAGE0, GX_TEXCOORDNULL, GX_TEXMAP_NULL, GX_COLOR0A0);
-        GX_SetTevOp(GX_TEVSTAGE0, GX_PASSCLR);
+        // All triangles share the same rotation, so compute it once per frame
+        Mtx rotation_matrix;
+        guMtxRotDeg(rotation_matrix, 'x', triangle_rotation);
+        Mtx temp_matrix;
+        guMtxRotDeg(temp_matrix, 'y', triangle_rotation);
+        guMtxConcat(rotation_matrix, temp_matrix, rotation_matrix);
 
         // Draw triangles
         for (int32_t y = -2; y < 2; y++) {
             for (int32_t x = -2; x < 2; x++) {
                 // Set triangle matrix
                 Mtx triangle_matrix;
-                guMtxRotDeg(triangle_matrix, 'x', triangle_rotation);
-                Mtx temp_matrix;
-                guMtxRotDeg(temp_matrix, 'y', triangle_rotation);
-                guMtxConcat(triangle_matrix, temp_matrix, triangle_matrix);
-                guMtxTransApply(triangle_matrix, triangle_matrix, x * 2 + 1, y * 2 + 1, -10);
+                guMtxTransApply(rotation_matrix, triangle_matrix, x * 2 + 1, y * 2 + 1, -10);
                 GX_LoadPosMtxImm(triangle_matrix, GX_PNMTX0);
 
                 // Draw triangle display list